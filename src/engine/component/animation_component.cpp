@@ -2,11 +2,20 @@
 #include "sprite_component.h"
 #include "../object/game_object.h"
 #include "../render/animation.h"
+#include "../render/animation_system.h"
 #include <spdlog/spdlog.h>
 
 
 namespace engine::component {
 
+	AnimationComponent::AnimationComponent(engine::render::AnimationSystem* animation_system)
+		: animation_system_(animation_system)
+	{
+		if (!animation_system_) {
+			spdlog::error("AnimationComponent构造函数中，AnimationSystem指针不能为nullptr！");
+		}
+	}
+
 	AnimationComponent::~AnimationComponent() = default;
 
 	
@@ -23,69 +32,86 @@ namespace engine::component {
 			spdlog::error("GameObject '{}' 的 AnimationComponent 需要 SpriteComponent，但未找到。", owner_->getName());
 			return;
 		}
+
+		// 注册到AnimationSystem
+		if (animation_system_) {
+			animation_system_->registerComponent(this);
+		}
 	}
 
-	void AnimationComponent::update(float delta_time, engine::core::Context&)
+	void AnimationComponent::clean()
+	{
+		if (animation_system_) {
+			animation_system_->unregisterComponent(this);
+		}
+	}
+
+	bool AnimationComponent::advance(float delta_time)
 	{// 如果没有正在播放的动画，或者没有当前动画，
 		//或者没有精灵组件，或者当前动画没有帧，则直接返回
-		if (!is_playing_ || !current_animation_ || !sprite_component_ || current_animation_->isEmpty()) {
-			spdlog::trace("AnimationComponent 更新时没有正在播放的动画或精灵组件为空。");
-			return;
+		if (!is_playing_ || !sprite_component_) {
+			return false;
+		}
+		const auto* current_animation = currentAnimation();
+		if (!current_animation || current_animation->isEmpty()) {
+			return false;
 		}
-
 
 		animation_timer_ += delta_time;// 推进计时器
 
-		const auto& current_frame = current_animation_->getFrame(animation_timer_);// 根据时间获取当前帧
-
-		//// 更新精灵组件的源矩形
-		sprite_component_->setSourceRect(current_frame.source_rect);
-
+		// 根据时间获取当前帧下标，只有帧切换时才更新精灵组件的源矩形
+		const auto frame_index = current_animation->getFrameIndex(animation_timer_);
+		const bool frame_changed = frame_index != current_frame_index_;
+		if (frame_changed) {
+			current_frame_index_ = frame_index;
+			sprite_component_->setFrameRect(current_animation->getFrameAt(frame_index).source_rect);
+		}
 
 		// 检查非循环动画是否已结束
 
-		if (!current_animation_->isLooping() && animation_timer_ >= current_animation_->getTotalDuration())
+		if (!current_animation->isLooping() && animation_timer_ >= current_animation->getTotalDuration())
 		{
 			is_playing_ = false;
-			animation_timer_ = current_animation_->getTotalDuration(); // 将时间限制在结束点
+			animation_timer_ = current_animation->getTotalDuration(); // 将时间限制在结束点
 			if (is_one_shot_removal_) 
 			{    
 				owner_->setNeedRemove(true);
 			
 			}
 		}
+		return frame_changed;
 	}
 
-	void AnimationComponent::addAnimation(std::unique_ptr<engine::render::Animation> animation)
+	void AnimationComponent::setAnimationSet(const engine::resource::AnimationSet* animation_set)
 	{
-		if (!animation)return;
-		std::string name = animation->getName();
-		animations_[name] = std::move(animation);
-		spdlog::debug("已将动画 '{}' 添加到 GameObject '{}'", name, owner_ ? owner_->getName() : "未知");
-
+		animation_set_ = animation_set;
+		current_clip_ = engine::resource::INVALID_ANIMATION_CLIP;
+		animation_timer_ = 0.0f;
+		is_playing_ = false;
 	}
 
 	void AnimationComponent::playAnimation(const std::string& name)
 	{
-		auto it = animations_.find(name);
-		if (it == animations_.end() || !it->second)
+		auto clip = animation_set_ ? animation_set_->findClip(name) : engine::resource::INVALID_ANIMATION_CLIP;
+		if (clip == engine::resource::INVALID_ANIMATION_CLIP)
 		{
-			spdlog::warn("未找到 GameObject '{}' 的动画 '{}'", name, owner_ ? owner_->getName() : "未知");
+			spdlog::warn("未找到 GameObject '{}' 的动画 '{}'", owner_ ? owner_->getName() : "未知", name);
 			return;
 		}
 
 		// 如果已经在播放相同的动画，不重新开始（注释这一段则重新开始播放）
-		if (current_animation_ == it->second.get() && is_playing_)
+		if (current_clip_ == clip && is_playing_)
 		{	return;}
-		current_animation_ = it->second.get();
+		current_clip_ = clip;
 		animation_timer_ = 0.0f;
 		is_playing_ = true;
 
 		// 立即将精灵更新到第一帧
-		if (sprite_component_ && !current_animation_->isEmpty())
+		const auto& current_animation = animation_set_->getClip(current_clip_);
+		if (sprite_component_ && !current_animation.isEmpty())
 		{
-			const auto& first_frame = current_animation_->getFrame(0.0f);
-			sprite_component_->setSourceRect(first_frame.source_rect);
+			current_frame_index_ = 0;
+			sprite_component_->setFrameRect(current_animation.getFrameAt(0).source_rect);
 			spdlog::debug("GameObject '{}' 播放动画 '{}'", owner_ ? owner_->getName() : "未知", name);
 		}
 
@@ -93,19 +119,28 @@ namespace engine::component {
 
 	std::string AnimationComponent::getCurrentAnimationName() const
 	{
-		if (current_animation_) {
-			return current_animation_->getName();
+		if (const auto* current_animation = currentAnimation(); current_animation) {
+			return current_animation->getName();
 		}
 		return "";
 	}
 
 	bool AnimationComponent::isAnimationFinished() const
 	{
-		if (!current_animation_ || current_animation_->isLooping()) {
+		const auto* current_animation = currentAnimation();
+		if (!current_animation || current_animation->isLooping()) {
 			return false;
 		}
-		return animation_timer_ >= current_animation_->getTotalDuration();
+		return animation_timer_ >= current_animation->getTotalDuration();
+	}
+
+	const engine::render::Animation* AnimationComponent::currentAnimation() const
+	{
+		if (!animation_set_ || current_clip_ == engine::resource::INVALID_ANIMATION_CLIP) {
+			return nullptr;
+		}
+		return &animation_set_->getClip(current_clip_);
 	}
 
 
-}
\ No newline at end of file
+}
@@ -1,11 +1,12 @@
 #pragma once
 #include "./component.h"
+#include "../resource/animation_library.h"
+#include <cstddef>
 #include <string>
-#include <unordered_map>
-#include <memory>
 
 namespace engine::render {
     class Animation;
+    class AnimationSystem;
 }
 namespace engine::component {
     class SpriteComponent;
@@ -16,24 +17,35 @@ namespace engine::component {
     /**
      * @brief GameObject的动画组件。
      *
-     * 持有一组Animation对象并控制其播放，
-     * 根据当前帧更新关联的SpriteComponent。
+     * 引用一组共享的、不可变的动画剪辑（AnimationSet，由 ResourceManager 持有）并控制其播放，
+     * 根据当前帧更新关联的SpriteComponent。每个实例只保存剪辑编号、计时器和播放状态。
+     *
+     * 播放的推进由 AnimationSystem 统一完成（init 时注册，clean 时注销），组件自身的 update 不做任何事。
      */
     class AnimationComponent : public Component {
         friend class engine::object::GameObject;
-    private:
+        friend class engine::render::AnimationSystem;
+    public:
+        static constexpr std::size_t UNREGISTERED = static_cast<std::size_t>(-1);    ///< @brief 未注册到动画系统时的下标
 
-        //动画名称到Animation对象的映射。
-        std::unordered_map<std::string, std::unique_ptr<engine::render::Animation>> animations_;
+    private:
+        engine::render::AnimationSystem* animation_system_ = nullptr;       ///< @brief 动画系统（非拥有）
+        std::size_t system_index_ = UNREGISTERED;                           ///< @brief 在动画系统紧凑数组中的下标
+        const engine::resource::AnimationSet* animation_set_ = nullptr;     ///< @brief 共享的动画剪辑集（非拥有）
         SpriteComponent* sprite_component_ = nullptr;             
-        engine::render::Animation* current_animation_ = nullptr;    
+        engine::resource::AnimationClipId current_clip_ = engine::resource::INVALID_ANIMATION_CLIP;   ///< @brief 当前剪辑编号
 
         float animation_timer_ = 0.0f;   // 动画播放中的计时器
         bool is_playing_ = false;       // 当前是否有动画正在播放
         bool is_one_shot_removal_ = false;  //是否在动画结束后删除整个GameObject
+        std::size_t current_frame_index_ = 0;  // 当前显示的帧下标，帧下标变化时才写入精灵
 
     public:
-        AnimationComponent() = default;
+        /**
+         * @brief 构造函数
+         * @param animation_system 动画系统指针，init 时向其注册
+         */
+        explicit AnimationComponent(engine::render::AnimationSystem* animation_system);
         ~AnimationComponent() override;
 
         // 删除复制/移动操作
@@ -42,7 +54,7 @@ namespace engine::component {
         AnimationComponent(AnimationComponent&&) = delete;
         AnimationComponent& operator=(AnimationComponent&&) = delete;
 
-        void addAnimation(std::unique_ptr<engine::render::Animation> animation);  //添加动画
+        void setAnimationSet(const engine::resource::AnimationSet* animation_set);  // 设置共享的动画剪辑集（会停止当前动画）
         void playAnimation(const std::string& name);  // 播放指定名称的动画。
         void stopAnimation() { is_playing_ = false; } //停止当前动画播放。
 
@@ -53,11 +65,17 @@ namespace engine::component {
         bool isAnimationFinished() const;
         bool isOneShotRemoval() const { return is_one_shot_removal_; }
         void setOneShotRemoval(bool is_one_shot_removal) { is_one_shot_removal_ = is_one_shot_removal; }
+        const engine::resource::AnimationSet* getAnimationSet() const { return animation_set_; }
 
     protected:
         // 核心循环方法
         void init() override;
-        void update(float, engine::core::Context&) override;
+        void update(float, engine::core::Context&) override {}     // 由 AnimationSystem 统一推进
+        void clean() override;
+
+    private:
+        const engine::render::Animation* currentAnimation() const;  // 当前剪辑，没有时返回 nullptr
+        bool advance(float delta_time);     // 推进计时器（由 AnimationSystem 调用），切换了帧时返回 true
     };
 
-} // namespace
\ No newline at end of file
+} // namespace
@@ -2,6 +2,9 @@
 #include "transform_component.h"
 #include "../object/game_object.h"
 #include "../physics/collider.h"
+#if ENGINE_DEBUG_DRAW
+#include "../render/renderer.h"
+#endif
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
@@ -110,4 +113,21 @@ namespace engine::component {
         return { top_left_pos, scaled_size }; // 返回最小包围盒的 Rect
     }
 
+#if ENGINE_DEBUG_DRAW
+    void ColliderComponent::debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const {
+        if (!collider_ || !transform_) {
+            return;
+        }
+        namespace debug_color = engine::render::debug_color;
+        const SDL_FColor& color = !is_active_ ? debug_color::INACTIVE : (is_trigger_ ? debug_color::TRIGGER : debug_color::COLLIDER);
+        const auto aabb = getWorldAABB();
+        if (collider_->getType() == engine::physics::ColliderType::CIRCLE) {
+            renderer.debugCircle(camera, aabb.position + aabb.size * 0.5f, aabb.size.x * 0.5f, color);
+        }
+        else {
+            renderer.debugRect(camera, aabb, color);
+        }
+    }
+#endif
+
 } // namespace engine::component 
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../physics/collider.h"
 #include "../utils/math.h"
 #include "../utils/alignment.h"
+#include "../render/debug_draw.h"
 #include <memory>
 
 
@@ -10,6 +11,11 @@ namespace engine::component {
 	class TransformComponent;
 }
 
+namespace engine::render {
+    class Renderer;
+    class Camera;
+}
+
 namespace engine::component {
 
     /**
@@ -76,6 +82,10 @@ namespace engine::component {
         void setTrigger(bool is_trigger) { is_trigger_ = is_trigger; }  ///< @brief 设置此碰撞器是否为触发器。
         void setActive(bool is_active) { is_active_ = is_active; }      ///< @brief 设置此碰撞器是否激活。
 
+#if ENGINE_DEBUG_DRAW
+        void debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const;   ///< @brief 录制碰撞形状（颜色区分触发器/未激活）
+#endif
+
     private:
         // 核心循环方法
         void init() override;
@@ -34,6 +34,7 @@ namespace engine::component {
 
         void setOwner(engine::object::GameObject* owner) { owner_ = owner; }    ///< @brief 设置拥有此组件的 GameObject
         engine::object::GameObject* getOwner() const { return owner_; }         ///< @brief 获取拥有此组件的 GameObject
+        virtual bool isRenderable() const { return false; }                     ///< @brief 是否覆盖了 render()，GameObject 只对这类组件调用 render
 
     protected:
         // 关键循环函数，全部设为保护，只有 GameObject 需要（可以）调用
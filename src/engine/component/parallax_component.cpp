@@ -5,12 +5,15 @@
 #include "../render/sprite.h"
 #include "../object/game_object.h"
 #include "../core/context.h"
+#include "../resource/resource_manager.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
 
-    ParallaxComponent::ParallaxComponent(const std::string& texture_id, const glm::vec2& scroll_factor, const glm::bvec2& repeat)
-        : sprite_(engine::render::Sprite(texture_id)),          // 视差背景默认为整张图片
+    ParallaxComponent::ParallaxComponent(const std::string& texture_id, engine::resource::ResourceManager& resource_manager,
+        const glm::vec2& scroll_factor, const glm::bvec2& repeat)
+        : resource_manager_(&resource_manager),
+        sprite_(engine::render::Sprite(texture_id)),          // 视差背景默认为整张图片
         scroll_factor_(scroll_factor),
         repeat_(repeat)
     {
@@ -27,14 +30,29 @@ namespace engine::component {
             spdlog::error("ParallaxComponent 初始化时，GameObject 上没有找到 TransformComponent 组件。");
             return;
         }
+        resolveTexture();
+    }
+
+    void ParallaxComponent::setSprite(const engine::render::Sprite& sprite) {
+        sprite_ = sprite;
+        resolveTexture();
+    }
+
+    void ParallaxComponent::resolveTexture() {
+        texture_handle_ = resource_manager_->getTextureHandle(sprite_.getTextureId());
+        texture_size_ = resource_manager_->getTextureSizeByHandle(texture_handle_);
+        if (texture_handle_ == 0) {
+            spdlog::error("ParallaxComponent 无法获取纹理: {}", sprite_.getTextureId());
+        }
     }
 
     void ParallaxComponent::render(engine::core::Context& context) {
         if (is_hidden_ || !transform_) {
             return;
         }
-        // 直接调用视差滚动绘制函数
-        context.getRenderer().drawParallax(context.getCamera(), sprite_, transform_->getPosition(), scroll_factor_, repeat_, transform_->getScale());
+        // 使用预先解析的纹理句柄和尺寸，提交一条平铺命令
+        context.getRenderer().drawParallax(context.getCamera(), texture_handle_, texture_size_, transform_->getPosition(),
+            scroll_factor_, repeat_, transform_->getScale(), render_layer_);
     }
 
 } // namespace engine::component 
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 #include "component.h"
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include <string>
 #include <glm/vec2.hpp>
 
+namespace engine::resource {
+    class ResourceManager;
+}
+
 namespace engine::component {
     class TransformComponent;
 
@@ -11,45 +16,59 @@ namespace engine::component {
      * @brief 在背景中渲染可滚动纹理的组件，以创建视差效果。
      *
      * 该组件根据相机的位置和滚动因子来移动纹理。
+     * 纹理句柄和尺寸在 init()（以及更换精灵时）解析一次，每帧只提交一条平铺命令。
      */
     class ParallaxComponent final : public Component {
         friend class engine::object::GameObject;
     private:
+        engine::resource::ResourceManager* resource_manager_ = nullptr;   ///< @brief 资源管理器，用于解析纹理句柄与尺寸
         TransformComponent* transform_ = nullptr;   ///< @brief 缓存变换组件
+        engine::resource::TextureHandle texture_handle_ = 0;    ///< @brief 预先解析的纹理句柄
+        glm::vec2 texture_size_ = { 0.0f, 0.0f };               ///< @brief 预先计算的纹理尺寸
 
         engine::render::Sprite sprite_;             ///< @brief 精灵对象
         glm::vec2 scroll_factor_;                   ///< @brief 滚动速度因子 (0=静止, 1=随相机移动, <1=比相机慢)
         glm::bvec2 repeat_;                         ///< @brief 是否沿着X和Y轴周期性重复
         bool is_hidden_ = false;                    ///< @brief 是否隐藏（不渲染）
+        std::uint8_t render_layer_ = engine::render::render_layer::MAP_BASE;  ///< @brief 渲染层级
 
     public:
         /**
          * @brief 构造函数
          * @param texture_id 背景纹理的资源 ID。
+         * @param resource_manager 资源管理器。
          * @param scroll_factor 控制背景相对于相机移动速度的因子。
          *                      (0, 0) 表示完全静止。
          *                      (1, 1) 表示与相机完全同步移动。
          *                      (0.5, 0.5) 表示以相机一半的速度移动。
          */
-        ParallaxComponent(const std::string& texture_id, const glm::vec2& scroll_factor, const glm::bvec2& repeat);
+        ParallaxComponent(const std::string& texture_id, engine::resource::ResourceManager& resource_manager,
+            const glm::vec2& scroll_factor, const glm::bvec2& repeat);
 
         // --- 设置器 ---
-        void setSprite(const engine::render::Sprite& sprite) { sprite_ = sprite; }  ///< @brief 设置精灵对象
+        void setSprite(const engine::render::Sprite& sprite);                        ///< @brief 设置精灵对象（重新解析纹理）
         void setScrollFactor(const glm::vec2& factor) { scroll_factor_ = factor; }  ///< @brief 设置滚动速度因子
         void setRepeat(const glm::bvec2& repeat) { repeat_ = repeat; }              ///< @brief 设置是否重复
         void setHidden(bool hidden) { is_hidden_ = hidden; }                        ///< @brief 设置是否隐藏（不渲染）
+        void setRenderLayer(std::uint8_t layer) { render_layer_ = layer; }          ///< @brief 设置渲染层级
 
         // --- 获取器 ---
         const engine::render::Sprite& getSprite() const { return sprite_; }          ///< @brief 获取精灵对象
         const glm::vec2& getScrollFactor() const { return scroll_factor_; }          ///< @brief 获取滚动速度因子
         const glm::bvec2& getRepeat() const { return repeat_; }                      ///< @brief 获取是否重复
         bool isHidden() const { return is_hidden_; }                                  ///< @brief 获取是否隐藏（不渲染）
+        const glm::vec2& getTextureSize() const { return texture_size_; }             ///< @brief 获取纹理尺寸
+        std::uint8_t getRenderLayer() const { return render_layer_; }                 ///< @brief 获取渲染层级
+        bool isRenderable() const override { return true; }
 
     protected:
         // 核心循环函数覆盖
         void update(float, engine::core::Context&) override {}     // 必须实现纯虚函数，留空
         void init() override;
         void render(engine::core::Context& context) override;
+
+    private:
+        void resolveTexture();      ///< @brief 解析纹理句柄与尺寸
     };
 
 } // namespace engine::component
\ No newline at end of file
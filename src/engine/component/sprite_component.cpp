@@ -55,7 +55,8 @@ namespace engine::component {
             return;
         }
 
-        // 获取大小及偏移
+        // 解析纹理，获取大小及偏移
+        resolveTexture();
         updateSpriteSize();
         updateOffset();
     }
@@ -66,6 +67,10 @@ namespace engine::component {
     }
 
     void SpriteComponent::updateOffset() {
+        ++geometry_version_;
+        if (owner_) {
+            owner_->markRenderDirty();
+        }
         // 如果尺寸无效，偏移为0
         if (sprite_size_.x <= 0 || sprite_size_.y <= 0) {
             offset_ = { 0.0f, 0.0f };
@@ -98,14 +103,32 @@ namespace engine::component {
         const glm::vec2& scale = transform_->getScale();
         float rotation_degrees = transform_->getRotation();
 
-        // 执行绘制
-        context.getRenderer().drawSprite(context.getCamera(), sprite_, pos, scale, rotation_degrees);
+        // 使用预先解析的纹理句柄和尺寸执行绘制
+        context.getRenderer().drawSprite(context.getCamera(), sprite_.getTextureHandle(), texture_size_, sprite_, pos, scale,
+            rotation_degrees, render_layer_, render_depth_);
+    }
+
+    engine::utils::Rect SpriteComponent::getWorldBounds() const {
+        if (!transform_) {
+            return { offset_, { 0.0f, 0.0f } };
+        }
+        // 与 Renderer::drawSprite 一致：左上角为 位置 + 偏移，尺寸为 精灵尺寸 * 缩放
+        const glm::vec2 size = glm::abs(sprite_size_ * transform_->getScale());
+        const glm::vec2 top_left = transform_->getPosition() + offset_;
+        if (transform_->getRotation() == 0.0f) {
+            return { top_left, size };
+        }
+        // 绕中心旋转，用对角线长度的正方形保守地包住任意角度
+        const float diagonal = glm::length(size);
+        const glm::vec2 center = top_left + size * 0.5f;
+        return { center - glm::vec2(diagonal * 0.5f), glm::vec2(diagonal) };
     }
 
     void SpriteComponent::setSpriteById(const std::string& texture_id, const std::optional<SDL_FRect>& source_rect_opt) {
         sprite_.setTextureId(texture_id);
         sprite_.setSourceRect(source_rect_opt);
 
+        resolveTexture();
         updateSpriteSize();
         updateOffset();
     }
@@ -116,17 +139,34 @@ namespace engine::component {
         updateOffset();
     }
 
-    void SpriteComponent::updateSpriteSize() {
+    void SpriteComponent::setFrameRect(const SDL_FRect& frame_rect) {
+        sprite_.setSourceRect(frame_rect);
+        if (frame_rect.w == sprite_size_.x && frame_rect.h == sprite_size_.y) {
+            return;     // 同一剪辑中的帧通常尺寸相同，偏移量无需重新计算
+        }
+        sprite_size_ = { frame_rect.w, frame_rect.h };
+        updateOffset();
+    }
+
+    void SpriteComponent::resolveTexture() {
         if (!resource_manager_) {
-            spdlog::error("ResourceManager 为空！无法获取纹理尺寸。");
+            spdlog::error("ResourceManager 为空！无法获取纹理。");
             return;
         }
+        sprite_.setTextureHandle(resource_manager_->getTextureHandle(sprite_.getTextureId()));
+        texture_size_ = resource_manager_->getTextureSizeByHandle(sprite_.getTextureHandle());
+        if (sprite_.getTextureHandle() == 0) {
+            spdlog::error("SpriteComponent 无法获取纹理: {}", sprite_.getTextureId());
+        }
+    }
+
+    void SpriteComponent::updateSpriteSize() {
         if (sprite_.getSourceRect().has_value()) {
             const auto& src_rect = sprite_.getSourceRect().value();
             sprite_size_ = { src_rect.w, src_rect.h };
         }
         else {
-            sprite_size_ = resource_manager_->getTextureSize(sprite_.getTextureId());
+            sprite_size_ = texture_size_;
         }
     }
 
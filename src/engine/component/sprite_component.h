@@ -1,7 +1,9 @@
 #pragma once
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include "./component.h"
 #include "../utils/alignment.h"
+#include "../utils/math.h"
 #include <string>
 #include <optional>
 #include <SDL3/SDL_rect.h>
@@ -32,8 +34,12 @@ namespace engine::component {
         engine::render::Sprite sprite_;                                         ///< @brief 精灵对象
         engine::utils::Alignment alignment_ = engine::utils::Alignment::NONE;   ///< @brief 对齐方式
         glm::vec2 sprite_size_ = { 0.0f, 0.0f };                                  ///< @brief 精灵尺寸
+        glm::vec2 texture_size_ = { 0.0f, 0.0f };                                 ///< @brief 预先解析的纹理尺寸（句柄缓存在 sprite_ 上）
         glm::vec2 offset_ = { 0.0f, 0.0f };                                       ///< @brief 偏移量
         bool is_hidden_ = false;                                                ///< @brief 是否隐藏（不渲染）
+        std::uint8_t render_layer_ = engine::render::render_layer::DEFAULT;     ///< @brief 渲染层级
+        std::uint32_t render_depth_ = 0;                                        ///< @brief 同一层级内的深度
+        std::uint32_t geometry_version_ = 0;                                    ///< @brief 尺寸或偏移每次变化时递增，场景据此判断包围盒是否需要更新
 
     public:
         /**
@@ -84,15 +90,24 @@ namespace engine::component {
         const glm::vec2& getSpriteSize() const { return sprite_size_; }             ///< @brief 获取精灵尺寸
         const glm::vec2& getOffset() const { return offset_; }                      ///< @brief 获取偏移量
         engine::utils::Alignment getAlignment() const { return alignment_; }        ///< @brief 获取对齐方式
+        std::uint8_t getRenderLayer() const { return render_layer_; }               ///< @brief 获取渲染层级
+        std::uint32_t getRenderDepth() const { return render_depth_; }              ///< @brief 获取层内深度
+        std::uint32_t getGeometryVersion() const { return geometry_version_; }      ///< @brief 获取几何版本号
+        engine::utils::Rect getWorldBounds() const;                                 ///< @brief 计算精灵在世界坐标中的包围盒（有旋转时取外接正方形）
+        bool isRenderable() const override { return true; }
 
         // Setters
         void setSpriteById(const std::string& texture_id, const std::optional<SDL_FRect>& source_rect_opt = std::nullopt); ///< @brief 设置精灵对象
         void setFlipped(bool flipped) { sprite_.setFlipped(flipped); }                                             ///< @brief 设置是否翻转
         void setHidden(bool hidden) { is_hidden_ = hidden; }                                                      ///< @brief 设置是否隐藏
         void setSourceRect(const std::optional<SDL_FRect>& source_rect_opt);                                     ///< @brief 设置源矩形
+        void setFrameRect(const SDL_FRect& frame_rect);                                                          ///< @brief 设置动画帧的源矩形，尺寸不变时跳过尺寸与偏移的重新计算
         void setAlignment(engine::utils::Alignment anchor);                                                     ///< @brief 设置对齐方式
+        void setRenderLayer(std::uint8_t layer) { render_layer_ = layer; }                                      ///< @brief 设置渲染层级
+        void setRenderDepth(std::uint32_t depth) { render_depth_ = depth; }                                     ///< @brief 设置层内深度
 
     private:
+        void resolveTexture();          ///< @brief 解析纹理句柄与尺寸并缓存（init 与更换纹理时调用，不在每帧绘制时查找）
         void updateSpriteSize();        ///< @brief 辅助函数，根据 sprite_ 的 source_rect_ 更新 sprite_size_
 
         // Component 虚函数覆盖
@@ -3,24 +3,77 @@
 #include "../core/context.h"
 #include "../render/renderer.h"
 #include "../render/camera.h"
+#include "../render/animation_system.h"
 #include"../physics/physics_engine.h"
+#include "../scene/tile_chunk_streamer.h"
+#include <algorithm>
+#include <cmath>
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
 
-    TileLayerComponent::TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<TileInfo>&& tiles)
+    TileLayerComponent::TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<std::uint16_t>&& cells,
+        std::shared_ptr<const TilePalette> palette)
         : tile_size_(tile_size),
         map_size_(map_size),
-        tiles_(std::move(tiles))
+        cells_(std::move(cells)),
+        palette_(std::move(palette))
     {
-        if (tiles_.size() != static_cast<size_t>(map_size_.x * map_size_.y)) {
+        if (!palette_ || palette_->empty()) {
+            palette_ = std::make_shared<const TilePalette>(1);    // 只有空瓦片
+        }
+        if (cells_.size() != static_cast<size_t>(map_size_.x * map_size_.y)) {
             spdlog::error("TileLayerComponent: 地图尺寸与提供的瓦片向量大小不匹配。瓦片数据将被清除。");
-            tiles_.clear();
+            cells_.clear();
             map_size_ = { 0, 0 };
         }
+        // 越界的下标视为空瓦片；同时只统计本层实际用到的调色板项的最大伸出量
+        std::vector<bool> is_used(palette_->size(), false);
+        for (auto& cell : cells_) {
+            if (cell >= palette_->size()) {
+                spdlog::error("TileLayerComponent: 调色板下标 {} 越界（调色板大小 {}），按空瓦片处理。", cell, palette_->size());
+                cell = 0;
+            }
+            is_used[cell] = true;
+        }
+        computeMaxOverhang(is_used);
         spdlog::trace("TileLayerComponent 构造完成");
     }
 
+    TileLayerComponent::TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size,
+        std::shared_ptr<const engine::scene::TileChunkSource> chunk_source, std::shared_ptr<const TilePalette> palette)
+        : tile_size_(tile_size),
+        map_size_(map_size),
+        palette_(std::move(palette)),
+        chunk_source_(std::move(chunk_source))
+    {
+        if (!palette_ || palette_->empty()) {
+            palette_ = std::make_shared<const TilePalette>(1);    // 只有空瓦片
+        }
+        if (chunk_source_) {
+            chunk_size_ = chunk_source_->getChunkSize();
+            chunk_grid_size_ = chunk_source_->getGridSize();
+        }
+        if (!chunk_source_ || chunk_size_.x <= 0 || chunk_size_.y <= 0 ||
+            map_size_.x > chunk_grid_size_.x * chunk_size_.x || map_size_.y > chunk_grid_size_.y * chunk_size_.y) {
+            spdlog::error("TileLayerComponent: 分块数据无效或不能覆盖地图尺寸。瓦片数据将被清除。");
+            chunk_source_.reset();
+            map_size_ = { 0, 0 };
+        }
+        computeMaxOverhang({});     // 分块在运行时才解码，按整个调色板估计
+        spdlog::trace("TileLayerComponent 构造完成（分块模式，{}x{} 个分块）", chunk_grid_size_.x, chunk_grid_size_.y);
+    }
+
+    void TileLayerComponent::computeMaxOverhang(const std::vector<bool>& is_used) {
+        for (size_t i = 0; i < palette_->size(); ++i) {
+            const auto& tile = (*palette_)[i];
+            if ((is_used.empty() || is_used[i]) && tile.type != TileType::EMPTY && tile.sprite.getSourceRect().has_value()) {
+                max_overhang_.x = std::max(max_overhang_.x, static_cast<int>(tile.sprite.getSourceRect()->w) - tile_size_.x);
+                max_overhang_.y = std::max(max_overhang_.y, static_cast<int>(tile.sprite.getSourceRect()->h) - tile_size_.y);
+            }
+        }
+    }
+
     void TileLayerComponent::init() {
         if (!owner_) {
             spdlog::warn("TileLayerComponent 的 owner_ 未设置。");
@@ -32,35 +85,195 @@ namespace engine::component {
         if (tile_size_.x <= 0 || tile_size_.y <= 0) {
             return; // 防止除以零或无效尺寸
         }
-        // 遍历所有瓦片
-        for (int y = 0; y < map_size_.y; ++y) {
-            for (int x = 0; x < map_size_.x; ++x) {
-                size_t index = static_cast<size_t>(y) * map_size_.x + x;
-                // 检查索引有效性以及瓦片是否需要渲染
-                if (index < tiles_.size() && tiles_[index].type != TileType::EMPTY) {
-                    const auto& tile_info = tiles_[index];
-                    // 计算该瓦片在世界中的左上角位置 (drawSprite 预期接收左上角坐标)
-                    glm::vec2 tile_left_top_pos = {
-                        offset_.x + static_cast<float>(x) * tile_size_.x,
-                        offset_.y + static_cast<float>(y) * tile_size_.y
-                    };
-                    // 但如果图片的大小与瓦片的大小不一致，需要调整 y 坐标 (瓦片层的对齐点是左下角)
-                    if (static_cast<int>(tile_info.sprite.getSourceRect()->h) != tile_size_.y) {
-                        tile_left_top_pos.y -= (tile_info.sprite.getSourceRect()->h - static_cast<float>(tile_size_.y));
+        // 只遍历与相机视口相交的瓦片
+        glm::ivec2 begin, end;
+        getVisibleTileRange(context.getCamera(), begin, end);
+        const auto& animation_system = context.getAnimationSystem();
+        forEachTile(begin, end, [&](int x, int y, const TileInfo& tile_info) {
+            // 检查瓦片是否需要渲染
+            if (tile_info.type == TileType::EMPTY) {
+                return;
+            }
+            // 动画瓦片取共享动画表的当前帧（每帧由 AnimationSystem 统一推进）
+            const auto& sprite = tile_info.animation_index >= 0 ? animation_system.getTileFrame(tile_info.animation_index) : tile_info.sprite;
+            // 计算该瓦片在世界中的左上角位置 (drawSprite 预期接收左上角坐标)
+            glm::vec2 tile_left_top_pos = {
+                offset_.x + static_cast<float>(x) * tile_size_.x,
+                offset_.y + static_cast<float>(y) * tile_size_.y
+            };
+            // 但如果图片的大小与瓦片的大小不一致，需要调整 y 坐标 (瓦片层的对齐点是左下角)
+            if (static_cast<int>(sprite.getSourceRect()->h) != tile_size_.y) {
+                tile_left_top_pos.y -= (sprite.getSourceRect()->h - static_cast<float>(tile_size_.y));
+            }
+            // 提交绘制命令（句柄在关卡构建时已解析，瓦片总有源矩形，不需要纹理尺寸）
+            context.getRenderer().drawSprite(context.getCamera(), sprite.getTextureHandle(), glm::vec2(0.0f), sprite, tile_left_top_pos,
+                { 1.0f, 1.0f }, 0.0, render_layer_);
+        });
+    }
+
+    template<typename Visit>
+    void TileLayerComponent::forEachTile(glm::ivec2 begin, glm::ivec2 end, Visit&& visit) const {
+        if (!chunk_source_) {
+            for (int y = begin.y; y < end.y; ++y) {
+                for (int x = begin.x; x < end.x; ++x) {
+                    const size_t index = static_cast<size_t>(y) * map_size_.x + x;
+                    if (index < cells_.size()) {
+                        visit(x, y, tileAt(index));
+                    }
+                }
+            }
+            return;
+        }
+        // 分块模式：逐个分块遍历，每个分块只查找一次
+        if (begin.x >= end.x || begin.y >= end.y) {
+            return;
+        }
+        const glm::ivec2 chunk_begin = begin / chunk_size_;
+        const glm::ivec2 chunk_end = (end + chunk_size_ - 1) / chunk_size_;
+        for (int chunk_y = chunk_begin.y; chunk_y < chunk_end.y; ++chunk_y) {
+            for (int chunk_x = chunk_begin.x; chunk_x < chunk_end.x; ++chunk_x) {
+                auto it = resident_chunks_.find(chunk_y * chunk_grid_size_.x + chunk_x);
+                if (it == resident_chunks_.end()) {
+                    continue;
+                }
+                const auto& cells = it->second;
+                const glm::ivec2 origin = glm::ivec2(chunk_x, chunk_y) * chunk_size_;
+                const int y_end = std::min(end.y, origin.y + chunk_size_.y);
+                const int x_end = std::min(end.x, origin.x + chunk_size_.x);
+                for (int y = std::max(begin.y, origin.y); y < y_end; ++y) {
+                    for (int x = std::max(begin.x, origin.x); x < x_end; ++x) {
+                        visit(x, y, (*palette_)[cells[static_cast<size_t>(y - origin.y) * chunk_size_.x + (x - origin.x)]]);
                     }
-                    // 执行绘制
-                    context.getRenderer().drawSprite(context.getCamera(), tile_info.sprite, tile_left_top_pos);
                 }
             }
         }
     }
 
+    void TileLayerComponent::update(float, engine::core::Context& context) {
+        if (chunk_source_) {
+            streamChunks(context);
+        }
+    }
+
+    void TileLayerComponent::streamChunks(engine::core::Context& context) {
+        auto& streamer = context.getTileChunkStreamer();
+        chunk_streamer_ = &streamer;
+
+        // 1. 取回后台解码完成的分块（请求之后被卸载或已同步解码的分块不再需要）
+        std::vector<engine::scene::TileChunkStreamer::Result> results;
+        streamer.collect(chunk_source_.get(), results);
+        for (auto& result : results) {
+            const int key = result.chunk.y * chunk_grid_size_.x + result.chunk.x;
+            if (pending_chunks_.erase(key) > 0) {
+                resident_chunks_.try_emplace(key, std::move(result.cells));
+            }
+        }
+
+        // 2. 视口覆盖的分块必须在本帧可用：缺少时同步解码；视口外 radius 圈内的分块请求后台解码
+        glm::ivec2 begin, end;
+        getVisibleTileRange(context.getCamera(), begin, end);
+        const glm::ivec2 view_begin = begin / chunk_size_;
+        const glm::ivec2 view_end = (glm::max(end, begin) + chunk_size_ - 1) / chunk_size_;
+        const int radius = streamer.getRadius();
+        const glm::ivec2 want_begin = glm::max(view_begin - radius, glm::ivec2(0));
+        const glm::ivec2 want_end = glm::min(view_end + radius, chunk_grid_size_);
+        int sync_count = 0;
+        for (int chunk_y = want_begin.y; chunk_y < want_end.y; ++chunk_y) {
+            for (int chunk_x = want_begin.x; chunk_x < want_end.x; ++chunk_x) {
+                const int key = chunk_y * chunk_grid_size_.x + chunk_x;
+                if (resident_chunks_.contains(key)) {
+                    continue;
+                }
+                const bool is_visible = chunk_x >= view_begin.x && chunk_x < view_end.x && chunk_y >= view_begin.y && chunk_y < view_end.y;
+                if (is_visible) {
+                    chunk_source_->decode({ chunk_x, chunk_y }, resident_chunks_[key]);
+                    pending_chunks_.erase(key);     // 后台结果到达时丢弃
+                    ++sync_count;
+                }
+                else if (pending_chunks_.insert(key).second) {
+                    streamer.request(chunk_source_, { chunk_x, chunk_y });
+                }
+            }
+        }
+        if (sync_count > 0) {
+            spdlog::debug("瓦片层 '{}': {} 个分块在视口内同步解码。", owner_ ? owner_->getName() : "", sync_count);
+        }
+
+        // 3. 卸载距离视口超过 radius + 1 圈的分块（多留一圈，避免在边界附近来回移动时反复解码）
+        const glm::ivec2 keep_begin = view_begin - radius - 1;
+        const glm::ivec2 keep_end = view_end + radius + 1;
+        auto is_far = [&](int key) {
+            const int chunk_x = key % chunk_grid_size_.x;
+            const int chunk_y = key / chunk_grid_size_.x;
+            return chunk_x < keep_begin.x || chunk_x >= keep_end.x || chunk_y < keep_begin.y || chunk_y >= keep_end.y;
+        };
+        std::erase_if(resident_chunks_, [&](const auto& entry) { return is_far(entry.first); });
+        std::erase_if(pending_chunks_, is_far);
+    }
+
+    void TileLayerComponent::getVisibleTileRange(const engine::render::Camera& camera, glm::ivec2& begin, glm::ivec2& end) const {
+        // 图片大于格子的瓦片向右、向上伸出，因此范围向左、向下多扩展 max_overhang_
+        const glm::vec2 view_min = camera.getPosition() - offset_;
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+        begin.x = std::max(0, static_cast<int>(std::floor((view_min.x - max_overhang_.x) / tile_size_.x)));
+        begin.y = std::max(0, static_cast<int>(std::floor(view_min.y / tile_size_.y)));
+        end.x = std::min(map_size_.x, static_cast<int>(std::floor(view_max.x / tile_size_.x)) + 1);
+        end.y = std::min(map_size_.y, static_cast<int>(std::floor((view_max.y + max_overhang_.y) / tile_size_.y)) + 1);
+    }
+
+#if ENGINE_DEBUG_DRAW
+    void TileLayerComponent::debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const {
+        if (tile_size_.x <= 0 || tile_size_.y <= 0) {
+            return;
+        }
+        namespace debug_color = engine::render::debug_color;
+        glm::ivec2 begin, end;
+        getVisibleTileRange(camera, begin, end);
+        const glm::vec2 size = tile_size_;
+        forEachTile(begin, end, [&](int x, int y, const TileInfo& tile_info) {
+            const TileType type = tile_info.type;
+            const glm::vec2 min = offset_ + glm::vec2(x, y) * size;
+            const glm::vec2 max = min + size;
+            // 斜坡两端的高度（从瓦片下侧起算，占瓦片高度的比例）
+            float left = -1.0f, right = -1.0f;
+            switch (type) {
+            case TileType::SOLID:
+                renderer.debugRect(camera, { min, size }, debug_color::SOLID_TILE, true);
+                break;
+            case TileType::HAZARD:
+                renderer.debugRect(camera, { min, size }, debug_color::HAZARD_TILE, true);
+                break;
+            case TileType::LADDER:
+                renderer.debugRect(camera, { min, size }, debug_color::LADDER_TILE);
+                break;
+            case TileType::UNISOLID:
+                renderer.debugLine(camera, min, { max.x, min.y }, debug_color::UNISOLID_TILE);
+                break;
+            case TileType::SLOPE_0_1: left = 0.0f; right = 1.0f; break;
+            case TileType::SLOPE_1_0: left = 1.0f; right = 0.0f; break;
+            case TileType::SLOPE_0_2: left = 0.0f; right = 0.5f; break;
+            case TileType::SLOPE_2_1: left = 0.5f; right = 1.0f; break;
+            case TileType::SLOPE_1_2: left = 1.0f; right = 0.5f; break;
+            case TileType::SLOPE_2_0: left = 0.5f; right = 0.0f; break;
+            default:
+                break;
+            }
+            if (left >= 0.0f) {
+                renderer.debugLine(camera, { min.x, max.y - left * size.y }, { max.x, max.y - right * size.y }, debug_color::SLOPE_TILE);
+            }
+        });
+    }
+#endif
+
     void TileLayerComponent::clean()
     {
         if (physics_engine_)
         {
             physics_engine_->unregisterCollisionLayer(this);
         }
+        if (chunk_streamer_ && chunk_source_) {
+            chunk_streamer_->cancel(chunk_source_.get());
+        }
     }
 
     const TileInfo* TileLayerComponent::getTileInfoAt(glm::ivec2 pos) const {
@@ -68,10 +281,19 @@ namespace engine::component {
             spdlog::warn("TileLayerComponent: 瓦片坐标越界: ({}, {})", pos.x, pos.y);
             return nullptr;
         }
+        if (chunk_source_) {    // 未装入的分块按空瓦片处理
+            const glm::ivec2 chunk = pos / chunk_size_;
+            auto it = resident_chunks_.find(chunk.y * chunk_grid_size_.x + chunk.x);
+            if (it == resident_chunks_.end()) {
+                return &(*palette_)[0];
+            }
+            const glm::ivec2 local = pos - chunk * chunk_size_;
+            return &(*palette_)[it->second[static_cast<size_t>(local.y) * chunk_size_.x + local.x]];
+        }
         size_t index = static_cast<size_t>(pos.y * map_size_.x + pos.x);
         // 瓦片索引不能越界
-        if (index < tiles_.size()) {
-            return &tiles_[index];
+        if (index < cells_.size()) {
+            return &tileAt(index);
         }
         spdlog::warn("TileLayerComponent: 瓦片索引越界: {}", index);
         return nullptr;
@@ -91,4 +313,22 @@ namespace engine::component {
         return getTileTypeAt(glm::ivec2{ tile_x, tile_y });
     }
 
+    bool TileLayerComponent::isAreaResident(const engine::utils::Rect& world_rect) const {
+        if (!chunk_source_) {
+            return true;
+        }
+        const glm::vec2 relative_min = world_rect.position - offset_;
+        const glm::vec2 relative_max = relative_min + world_rect.size;
+        const glm::ivec2 begin = glm::max(glm::ivec2(glm::floor(relative_min / glm::vec2(tile_size_))), glm::ivec2(0));
+        const glm::ivec2 end = glm::min(glm::ivec2(glm::floor(relative_max / glm::vec2(tile_size_))) + 1, map_size_);
+        for (int chunk_y = begin.y / chunk_size_.y; chunk_y * chunk_size_.y < end.y; ++chunk_y) {
+            for (int chunk_x = begin.x / chunk_size_.x; chunk_x * chunk_size_.x < end.x; ++chunk_x) {
+                if (!resident_chunks_.contains(chunk_y * chunk_grid_size_.x + chunk_x)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
 } // namespace engine::component
\ No newline at end of file
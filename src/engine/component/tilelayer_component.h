@@ -1,11 +1,19 @@
 #pragma once
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include "component.h"
+#include "../utils/math.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <glm/vec2.hpp>
 
 namespace engine::render {
     class Sprite;
+    class Renderer;
+    class Camera;
 }
 
 namespace engine::core {
@@ -15,6 +23,10 @@ namespace engine::physics {
 
     class PhysicsEngine;
 }
+namespace engine::scene {
+    class TileChunkSource;
+    class TileChunkStreamer;
+}
 
 namespace engine::component {
     /**
@@ -41,25 +53,49 @@ namespace engine::component {
     struct TileInfo {
         render::Sprite sprite;      ///< @brief 瓦片的视觉表示
         TileType type;              ///< @brief 瓦片的逻辑类型
-        TileInfo(render::Sprite s = render::Sprite(), TileType t = TileType::EMPTY) : sprite(std::move(s)), type(t) {}
+        int animation_index = -1;   ///< @brief 瓦片动画在 AnimationSystem 中的下标，-1 表示静态瓦片
+        TileInfo(render::Sprite s = render::Sprite(), TileType t = TileType::EMPTY, int anim = -1)
+            : sprite(std::move(s)), type(t), animation_index(anim) {}
     };
 
+    /**
+     * @brief 瓦片调色板：一张地图中所有不重复的瓦片信息，由 LevelLoader 构建并在该地图的所有瓦片层之间共享。
+     * 下标 0 固定为空瓦片，瓦片层的每个格子只保存一个调色板下标。
+     */
+    using TilePalette = std::vector<TileInfo>;
+
     /**
      * @brief 管理和渲染瓦片地图层。
      *
-     * 存储瓦片地图的布局、每个瓦片的精灵信息和类型。
+     * 存储瓦片地图的布局（每个格子一个调色板下标）与共享的瓦片调色板。
      * 负责在渲染阶段绘制可见的瓦片。
+     *
+     * 分块模式（Tiled 无限地图）下不保存整张地图：update() 在相机附近按分块加载、远离后卸载，
+     * 视口内缺少的分块立即同步解码，视口外 radius 圈内的分块交给 TileChunkStreamer 在后台解码，
+     * 因此常驻内存的格子数量只取决于视口大小与流式半径。分块只在游戏线程上装入或卸载，
+     * 渲染与物理碰撞看到的始终是同一份数据；未装入的分块按空瓦片处理（见 isAreaResident）。
      */
     class TileLayerComponent final : public Component {
         friend class engine::object::GameObject;
     private:
         glm::ivec2 tile_size_;              ///< @brief 单个瓦片尺寸（像素）
         glm::ivec2 map_size_;               ///< @brief 地图尺寸（瓦片数）
-        std::vector<TileInfo> tiles_;       ///< @brief 存储所有瓦片信息 (按"行主序"存储, index = y * map_width_ + x)
+        std::vector<std::uint16_t> cells_;  ///< @brief 每个格子的调色板下标 (按"行主序"存储, index = y * map_width_ + x)
+        std::shared_ptr<const TilePalette> palette_;  ///< @brief 共享的瓦片调色板（加载期间 LevelLoader 仍可能在末尾追加）
         glm::vec2 offset_ = { 0.0f, 0.0f };   ///< @brief 瓦片层在世界中的偏移量 (瓦片层通常不需要缩放及旋转，因此不引入Transform组件)
         // offset_ 最好也保持默认的0，以免增加不必要的复杂性
         bool is_hidden_ = false;            ///< @brief 是否隐藏（不渲染）
+        std::uint8_t render_layer_ = engine::render::render_layer::MAP_BASE;  ///< @brief 渲染层级
+        glm::ivec2 max_overhang_ = { 0, 0 };  ///< @brief 瓦片图片超出瓦片格子的最大像素数（宽向右、高向上），用于扩展可见范围
         engine::physics::PhysicsEngine* physics_engine_ = nullptr;//物理引擎的指针， clean()函数中可能需要反注册
+
+        // --- 分块模式（chunk_source_ 为空时使用 cells_） ---
+        std::shared_ptr<const engine::scene::TileChunkSource> chunk_source_;   ///< @brief 分块数据来源
+        glm::ivec2 chunk_size_ = { 0, 0 };  ///< @brief 分块尺寸（瓦片数）
+        glm::ivec2 chunk_grid_size_ = { 0, 0 };  ///< @brief 分块网格尺寸（分块数）
+        std::unordered_map<int, std::vector<std::uint16_t>> resident_chunks_;  ///< @brief 已装入的分块（行主序分块下标 -> 调色板下标）
+        std::unordered_set<int> pending_chunks_;    ///< @brief 已请求后台解码、尚未取回的分块
+        engine::scene::TileChunkStreamer* chunk_streamer_ = nullptr;    ///< @brief 请求过解码的流式加载器（clean() 时取消请求）
     public:
         TileLayerComponent() = default;
 
@@ -67,9 +103,21 @@ namespace engine::component {
          * @brief 构造函数
          * @param tile_size 单个瓦片尺寸（像素）
          * @param map_size 地图尺寸（瓦片数）
-         * @param tiles 初始化瓦片数据的容器 (会被移动)
+         * @param cells 每个格子的调色板下标 (会被移动)
+         * @param palette 共享的瓦片调色板，cells 中的下标必须已经存在于其中
          */
-        TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<TileInfo>&& tiles);
+        TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<std::uint16_t>&& cells,
+            std::shared_ptr<const TilePalette> palette);
+
+        /**
+         * @brief 构造函数（分块模式）
+         * @param tile_size 单个瓦片尺寸（像素）
+         * @param map_size 地图尺寸（瓦片数，分块网格覆盖的范围）
+         * @param chunk_source 分块数据来源，解码出的下标必须已经存在于调色板中
+         * @param palette 共享的瓦片调色板
+         */
+        TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::shared_ptr<const engine::scene::TileChunkSource> chunk_source,
+            std::shared_ptr<const TilePalette> palette);
 
         /**
          * @brief 根据瓦片坐标获取瓦片信息
@@ -92,26 +140,61 @@ namespace engine::component {
          */
         TileType getTileTypeAtWorldPos(const glm::vec2& world_pos) const;
 
+        /**
+         * @brief 世界坐标中的矩形覆盖的瓦片是否都已装入（非分块模式始终为 true，地图以外的部分不考虑）。
+         * @param world_rect 世界坐标中的矩形
+         */
+        bool isAreaResident(const engine::utils::Rect& world_rect) const;
+
         // getters and setters
         glm::ivec2 getTileSize() const { return tile_size_; }               ///< @brief 获取单个瓦片尺寸
         glm::ivec2 getMapSize() const { return map_size_; }                 ///< @brief 获取地图尺寸
         glm::vec2 getWorldSize() const {                                    ///< @brief 获取地图世界尺寸
             return glm::vec2(map_size_.x * tile_size_.x, map_size_.y * tile_size_.y);
         }
-        const std::vector<TileInfo>& getTiles() const { return tiles_; }    ///< @brief 获取瓦片容器
+        const std::vector<std::uint16_t>& getCells() const { return cells_; }   ///< @brief 获取每个格子的调色板下标（分块模式下为空）
+        bool isChunked() const { return chunk_source_ != nullptr; }         ///< @brief 是否为分块模式
+        std::size_t getResidentChunkCount() const { return resident_chunks_.size(); }  ///< @brief 已装入的分块数量
+        const TilePalette& getPalette() const { return *palette_; }             ///< @brief 获取瓦片调色板
         const glm::vec2& getOffset() const { return offset_; }              ///< @brief 获取瓦片层的偏移量
         bool isHidden() const { return is_hidden_; }                        ///< @brief 获取是否隐藏（不渲染）
+        std::uint8_t getRenderLayer() const { return render_layer_; }       ///< @brief 获取渲染层级
+        bool isRenderable() const override { return true; }
 
         void setOffset(const glm::vec2& offset) { offset_ = offset; }       ///< @brief 设置瓦片层的偏移量
         void setHidden(bool hidden) { is_hidden_ = hidden; }                ///< @brief 设置是否隐藏（不渲染）
+        void setRenderLayer(std::uint8_t layer) { render_layer_ = layer; }  ///< @brief 设置渲染层级
 
         void setPhysicsEngine(engine::physics::PhysicsEngine* physics_engine) { physics_engine_ = physics_engine; }
+
+#if ENGINE_DEBUG_DRAW
+        /**
+         * @brief 录制视口内瓦片的碰撞类型（实心/危险填充，单向平台画上边缘，斜坡画表面，梯子画边框）。
+         */
+        void debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const;
+#endif
     protected:
         // 核心循环方法
         void init() override;
-        void update(float, engine::core::Context&) override {}
+        void update(float, engine::core::Context& context) override;
         void render(engine::core::Context& context) override;
         void clean()override;
+
+    private:
+        const TileInfo& tileAt(size_t index) const { return (*palette_)[cells_[index]]; }  ///< @brief 格子（行主序下标）对应的瓦片信息
+
+        /// @brief 依次访问范围 [begin, end) 内的瓦片 visit(x, y, tile_info)，分块模式下跳过未装入的分块
+        template<typename Visit>
+        void forEachTile(glm::ivec2 begin, glm::ivec2 end, Visit&& visit) const;
+
+        /// @brief 分块模式：取回后台解码的分块，装入相机附近缺少的分块，卸载远离的分块
+        void streamChunks(engine::core::Context& context);
+
+        /// @brief 计算 max_overhang_（is_used 为空时统计整个调色板）
+        void computeMaxOverhang(const std::vector<bool>& is_used);
+
+        /// @brief 计算与相机视口相交的瓦片范围 [begin, end)
+        void getVisibleTileRange(const engine::render::Camera& camera, glm::ivec2& begin, glm::ivec2& end) const;
     };
 
 } // namespace engine::component
\ No newline at end of file
@@ -7,6 +7,7 @@ namespace engine::component {
     void TransformComponent::setScale(const glm::vec2& scale)
     {
         scale_ = scale;
+        markChanged();
         if (owner_) {
             auto sprite_comp = owner_->getComponent<SpriteComponent>();
             if (sprite_comp) {
@@ -21,4 +22,12 @@ namespace engine::component {
         }
     }
 
+    void TransformComponent::markChanged()
+    {
+        ++version_;
+        if (owner_) {
+            owner_->markRenderDirty();
+        }
+    }
+
 } // namespace engine::component 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "./component.h"
 #include <glm/vec2.hpp>
+#include <cstdint>
 
 namespace engine::component {
 
@@ -15,6 +16,11 @@ namespace engine::component {
         glm::vec2 scale_ = { 1.0f, 1.0f };        ///< @brief 缩放
         float rotation_ = 0.0f;                 ///< @brief 角度制，单位：度
 
+    private:
+        std::uint32_t version_ = 0;             ///< @brief 每次通过 setter 修改变换时递增并通知拥有者（直接写成员不会更新，应使用 setter）
+
+    public:
+
         /**
          * @brief 构造函数
          * @param position 位置
@@ -35,12 +41,14 @@ namespace engine::component {
         const glm::vec2& getPosition() const { return position_; }              ///< @brief 获取位置
         float getRotation() const { return rotation_; }                         ///< @brief 获取旋转
         const glm::vec2& getScale() const { return scale_; }                    ///< @brief 获取缩放
-        void setPosition(const glm::vec2& position) { position_ = position; }   ///< @brief 设置位置
-        void setRotation(float rotation) { rotation_ = rotation; }              ///< @brief 设置旋转
+        std::uint32_t getVersion() const { return version_; }                   ///< @brief 获取变换版本号，用于判断缓存的包围盒是否过期
+        void setPosition(const glm::vec2& position) { position_ = position; markChanged(); }   ///< @brief 设置位置
+        void setRotation(float rotation) { rotation_ = rotation; markChanged(); }              ///< @brief 设置旋转
         void setScale(const glm::vec2& scale);                                  ///< @brief 设置缩放，应用缩放时应同步更新Sprite偏移量
-        void translate(const glm::vec2& offset) { position_ += offset; }        ///< @brief 平移
+        void translate(const glm::vec2& offset) { position_ += offset; markChanged(); }        ///< @brief 平移
 
     private:
+        void markChanged();                                                     ///< @brief 递增版本号，并通知拥有者包围盒可能已变化
         void update(float, engine::core::Context&) override {}                  ///< @brief 覆盖纯虚函数，这里不需要实现
     };
 
@@ -1,5 +1,6 @@
 #include "config.h"
 #include <fstream>
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include "spdlog/spdlog.h"
 
@@ -34,6 +35,40 @@ namespace engine::core {
         return false;
     }
 
+    void Config::applyCommandLine(const std::vector<std::string>& args) {
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            const auto& arg = args[i];
+            const bool has_value = i + 1 < args.size();
+            if (arg == "--headless") {
+                headless_enabled_ = true;
+            }
+            else if (arg == "--frames" && has_value) {
+                try {
+                    headless_frames_ = std::max(1, std::stoi(args[++i]));
+                }
+                catch (const std::exception&) {
+                    spdlog::warn("无效的 --frames 参数 '{}'，使用 {}。", args[i], headless_frames_);
+                }
+            }
+            else if (arg == "--capture" && has_value) {
+                headless_capture_path_ = args[++i];
+            }
+            else if (arg == "--render-stats" && has_value) {
+                render_stats_enabled_ = true;
+                render_stats_path_ = args[++i];
+            }
+            else if (arg == "--cook") {
+                cook_enabled_ = true;
+                if (has_value && !args[i + 1].starts_with("--")) {     // 路径可以省略
+                    cook_path_ = args[++i];
+                }
+            }
+            else {
+                spdlog::warn("未知的命令行参数: {}", arg);
+            }
+        }
+    }
+
     bool Config::saveToFile(const std::string& filepath) {
         std::ofstream file(filepath);
         if (!file.is_open()) {
@@ -64,6 +99,7 @@ namespace engine::core {
         if (j.contains("graphics")) {
             const auto& graphics_config = j["graphics"];
             vsync_enabled_ = graphics_config.value("vsync", vsync_enabled_);
+            render_thread_enabled_ = graphics_config.value("render_thread", render_thread_enabled_);
         }
         if (j.contains("performance")) {
             const auto& perf_config = j["performance"];
@@ -72,6 +108,55 @@ namespace engine::core {
                 spdlog::warn("目标 FPS 不能为负数。设置为 0（无限制）。");
                 target_fps_ = 0;
             }
+            dynamic_resolution_enabled_ = perf_config.value("dynamic_resolution", dynamic_resolution_enabled_);
+            dynamic_resolution_min_scale_ = perf_config.value("dynamic_resolution_min_scale", dynamic_resolution_min_scale_);
+            dynamic_resolution_step_ = perf_config.value("dynamic_resolution_step", dynamic_resolution_step_);
+            chunk_stream_radius_ = perf_config.value("chunk_stream_radius", chunk_stream_radius_);
+            if (chunk_stream_radius_ < 0) {
+                spdlog::warn("分块流式半径不能为负数。设置为 0（只加载视口内的分块）。");
+                chunk_stream_radius_ = 0;
+            }
+            job_worker_threads_ = perf_config.value("job_worker_threads", job_worker_threads_);
+            if (job_worker_threads_ < -1) {
+                spdlog::warn("任务池工作线程数无效。设置为 -1（按硬件线程数自动选择）。");
+                job_worker_threads_ = -1;
+            }
+            if (dynamic_resolution_min_scale_ <= 0.0f || dynamic_resolution_min_scale_ > 1.0f) {
+                spdlog::warn("动态分辨率最低缩放必须在 (0, 1] 之间。设置为 0.5。");
+                dynamic_resolution_min_scale_ = 0.5f;
+            }
+        }
+        if (j.contains("headless")) {
+            const auto& headless_config = j["headless"];
+            headless_enabled_ = headless_config.value("enabled", headless_enabled_);
+            headless_frames_ = headless_config.value("frames", headless_frames_);
+            headless_fixed_delta_ = headless_config.value("fixed_delta", headless_fixed_delta_);
+            headless_capture_path_ = headless_config.value("capture_path", headless_capture_path_);
+            if (headless_frames_ < 1) {
+                spdlog::warn("无头模式帧数必须为正数。设置为 1。");
+                headless_frames_ = 1;
+            }
+        }
+        if (j.contains("capture")) {
+            const auto& capture_config = j["capture"];
+            capture_enabled_ = capture_config.value("enabled", capture_enabled_);
+            capture_directory_ = capture_config.value("directory", capture_directory_);
+            capture_format_ = capture_config.value("format", capture_format_);
+            capture_ring_size_ = capture_config.value("ring_size", capture_ring_size_);
+            if (capture_ring_size_ < 2) {
+                spdlog::warn("截帧环形缓冲至少需要 2 帧。设置为 2。");
+                capture_ring_size_ = 2;
+            }
+        }
+        if (j.contains("render_stats")) {
+            const auto& stats_config = j["render_stats"];
+            render_stats_enabled_ = stats_config.value("enabled", render_stats_enabled_);
+            render_stats_path_ = stats_config.value("path", render_stats_path_);
+            render_stats_interval_ = stats_config.value("interval_frames", render_stats_interval_);
+            if (render_stats_interval_ < 1) {
+                spdlog::warn("渲染统计写入间隔必须为正数。设置为 1。");
+                render_stats_interval_ = 1;
+            }
         }
         if (j.contains("audio")) {
             const auto& audio_config = j["audio"];
@@ -107,10 +192,33 @@ namespace engine::core {
                 {"resizable", window_resizable_}
             }},
             {"graphics", {
-                {"vsync", vsync_enabled_}
+                {"vsync", vsync_enabled_},
+                {"render_thread", render_thread_enabled_}
             }},
             {"performance", {
-                {"target_fps", target_fps_}
+                {"target_fps", target_fps_},
+                {"dynamic_resolution", dynamic_resolution_enabled_},
+                {"dynamic_resolution_min_scale", dynamic_resolution_min_scale_},
+                {"dynamic_resolution_step", dynamic_resolution_step_},
+                {"chunk_stream_radius", chunk_stream_radius_},
+                {"job_worker_threads", job_worker_threads_}
+            }},
+            {"headless", {
+                {"enabled", headless_enabled_},
+                {"frames", headless_frames_},
+                {"fixed_delta", headless_fixed_delta_},
+                {"capture_path", headless_capture_path_}
+            }},
+            {"capture", {
+                {"enabled", capture_enabled_},
+                {"directory", capture_directory_},
+                {"format", capture_format_},
+                {"ring_size", capture_ring_size_}
+            }},
+            {"render_stats", {
+                {"enabled", render_stats_enabled_},
+                {"path", render_stats_path_},
+                {"interval_frames", render_stats_interval_}
             }},
             {"audio", {
                 {"music_volume", music_volume_},
@@ -23,9 +23,36 @@ namespace engine::core {
 
         // 图形设置
         bool vsync_enabled_ = true;             ///< @brief 是否启用垂直同步
+        bool render_thread_enabled_ = false;    ///< @brief 是否使用独立的渲染线程（默认关闭，使用单线程循环）
 
         // 性能设置
         int target_fps_ = 144;                  ///< @brief 目标 FPS 设置，0 表示不限制
+        bool dynamic_resolution_enabled_ = false;   ///< @brief 帧耗时超出预算时是否降低场景的内部分辨率（UI 不受影响，默认关闭）
+        float dynamic_resolution_min_scale_ = 0.5f; ///< @brief 内部分辨率的最低缩放（相对原生分辨率）
+        float dynamic_resolution_step_ = 0.125f;    ///< @brief 每次调整的缩放幅度
+        int chunk_stream_radius_ = 1;           ///< @brief 分块地图（Tiled 无限地图）在视口之外预先加载的分块圈数
+        int job_worker_threads_ = -1;           ///< @brief 关卡加载任务池的工作线程数，-1 表示硬件线程数 - 1，0 表示只在加载线程上串行执行
+
+        // 无头（离屏）模式设置，用于没有显示器/GPU 的 CI 基准测试
+        bool headless_enabled_ = false;         ///< @brief 是否使用无头模式（offscreen/dummy 视频驱动 + 软件渲染器）
+        int headless_frames_ = 600;             ///< @brief 无头模式运行的帧数，完成后自动退出
+        float headless_fixed_delta_ = 1.0f / 60.0f; ///< @brief 无头模式使用的固定帧间隔（秒），保证结果可复现
+        std::string headless_capture_path_;     ///< @brief 非空时，退出前把最终画面保存为 BMP
+
+        // 截帧设置（运行时也可以用 "capture" 动作切换）
+        bool capture_enabled_ = false;          ///< @brief 启动时是否开启截帧
+        std::string capture_directory_ = "captures";    ///< @brief 截帧输出目录
+        std::string capture_format_ = "png";    ///< @brief 截帧格式："png" 或 "raw"
+        int capture_ring_size_ = 3;             ///< @brief 渲染目标环形缓冲大小（读回延迟的帧数）
+
+        // 渲染统计（CSV），也可以用命令行 --render-stats <path> 开启
+        bool render_stats_enabled_ = false;     ///< @brief 是否把渲染统计写入 CSV
+        std::string render_stats_path_ = "render_stats.csv";    ///< @brief CSV 输出路径
+        int render_stats_interval_ = 30;        ///< @brief 每隔多少帧写入一行
+
+        // 关卡烘焙（仅命令行：--cook [地图文件或目录]），烘焙完成后直接退出
+        bool cook_enabled_ = false;             ///< @brief 是否运行烘焙模式
+        std::string cook_path_ = "assets/maps"; ///< @brief 要烘焙的 .tmj 文件，或包含 .tmj 的目录
 
         // 音频设置
         float music_volume_ = 0.5f;
@@ -41,6 +68,8 @@ namespace engine::core {
             {"jump", {"J", "Space"}},
             {"attack", {"K", "MouseLeft"}},
             {"pause", {"P", "Escape"}},
+            {"capture", {"F12"}},
+            {"debug_draw", {"F3"}},     // 仅 Debug 构建有效
             // 可以继续添加更多默认动作
         };
 
@@ -53,6 +82,7 @@ namespace engine::core {
         Config& operator=(Config&&) = delete;
 
         bool loadFromFile(const std::string& filepath);                   ///< @brief 从指定的 JSON 文件加载配置。成功返回 true，否则返回 false。
+        void applyCommandLine(const std::vector<std::string>& args);      ///< @brief 用命令行参数覆盖配置（如 --headless --frames 300）
         [[nodiscard]] bool saveToFile(const std::string& filepath);       ///< @brief 将当前配置保存到指定的 JSON 文件。成功返回 true，否则返回 false。
 
     private:
@@ -6,6 +6,9 @@
 #include "../resource/resource_manager.h"
 #include "../physics/physics_engine.h"
 #include"../audio/audio_player.h"
+#include "../render/particle_system.h"
+#include "../render/animation_system.h"
+#include "../render/text_renderer.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::core {
@@ -15,15 +18,31 @@ namespace engine::core {
         engine::render::Camera& camera,
         engine::resource::ResourceManager& resource_manager,
         engine::physics::PhysicsEngine& physics_engine,
-        engine::audio::AudioPlayer&audio_player) 
+        engine::audio::AudioPlayer&audio_player,
+        engine::render::ParticleSystem& particle_system,
+        engine::render::AnimationSystem& animation_system,
+        engine::render::TextRenderer& text_renderer,
+        engine::scene::LevelPreloader& level_preloader,
+        engine::scene::TileChunkStreamer& tile_chunk_streamer,
+        engine::core::JobPool& job_pool)
         : input_manager_(input_manager),
         renderer_(renderer),
         camera_(camera),
         resource_manager_(resource_manager),
         physics_engine_(physics_engine),
-        audio_player_(audio_player)
+        audio_player_(audio_player),
+        particle_system_(particle_system),
+        animation_system_(animation_system),
+        text_renderer_(text_renderer),
+        level_preloader_(level_preloader),
+        tile_chunk_streamer_(tile_chunk_streamer),
+        job_pool_(job_pool)
     {
         spdlog::trace("上下文已创建并初始化，包含输入管理器、渲染器、相机和资源管理器。");
     }
 
+    engine::render::RenderStats Context::getRenderStats() const {
+        return renderer_.getLastFrameStats();
+    }
+
 } // namespace engine::core 
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "../render/render_stats.h"
 // 前置声明核心系统
 namespace engine::input {
     class InputManager;
@@ -7,6 +8,9 @@ namespace engine::input {
 namespace engine::render {
     class Renderer;
     class Camera;
+    class ParticleSystem;
+    class AnimationSystem;
+    class TextRenderer;
 }
 
 namespace engine::resource {
@@ -19,7 +23,12 @@ namespace engine::physics {
 namespace engine::audio {
     class AudioPlayer;
 }
+namespace engine::scene {
+    class LevelPreloader;
+    class TileChunkStreamer;
+}
 namespace engine::core {
+    class JobPool;
 
     /**
      * @brief 持有对核心引擎模块引用的上下文对象。
@@ -35,6 +44,12 @@ namespace engine::core {
         engine::resource::ResourceManager& resource_manager_;   ///< @brief 资源管理器
         engine::physics::PhysicsEngine& physics_engine_;        ///< @brief 物理引擎
         engine::audio::AudioPlayer& audio_player_;              ///< @brief 音频播放器
+        engine::render::ParticleSystem& particle_system_;       ///< @brief 特效/粒子系统
+        engine::render::AnimationSystem& animation_system_;     ///< @brief 动画系统
+        engine::render::TextRenderer& text_renderer_;           ///< @brief 文字渲染器
+        engine::scene::LevelPreloader& level_preloader_;        ///< @brief 关卡后台预加载
+        engine::scene::TileChunkStreamer& tile_chunk_streamer_; ///< @brief 分块瓦片层的后台解码
+        engine::core::JobPool& job_pool_;                       ///< @brief 关卡加载的并行任务池
     
     public:
         /**
@@ -49,7 +64,13 @@ namespace engine::core {
             engine::render::Camera& camera,
             engine::resource::ResourceManager& resource_manager,
             engine::physics::PhysicsEngine& physics_engine,
-            engine::audio::AudioPlayer&audio_player
+            engine::audio::AudioPlayer&audio_player,
+            engine::render::ParticleSystem& particle_system,
+            engine::render::AnimationSystem& animation_system,
+            engine::render::TextRenderer& text_renderer,
+            engine::scene::LevelPreloader& level_preloader,
+            engine::scene::TileChunkStreamer& tile_chunk_streamer,
+            engine::core::JobPool& job_pool
         );
         // 禁止拷贝和移动，Context 对象通常是唯一的或按需创建/传递
         Context(const Context&) = delete;
@@ -64,6 +85,13 @@ namespace engine::core {
         engine::resource::ResourceManager& getResourceManager() const { return resource_manager_; } ///< @brief 获取资源管理器
         engine::physics::PhysicsEngine& getPhysicsEngine() const { return physics_engine_; }         ///< @brief 获取物理引擎
         engine::audio::AudioPlayer& getAudioPlayer()const { return audio_player_; }///< @brief 获取音频播放器
+        engine::render::ParticleSystem& getParticleSystem() const { return particle_system_; }       ///< @brief 获取特效/粒子系统
+        engine::render::AnimationSystem& getAnimationSystem() const { return animation_system_; }    ///< @brief 获取动画系统
+        engine::render::TextRenderer& getTextRenderer() const { return text_renderer_; }             ///< @brief 获取文字渲染器
+        engine::scene::LevelPreloader& getLevelPreloader() const { return level_preloader_; }       ///< @brief 获取关卡预加载器
+        engine::scene::TileChunkStreamer& getTileChunkStreamer() const { return tile_chunk_streamer_; }  ///< @brief 获取分块流式加载器
+        engine::core::JobPool& getJobPool() const { return job_pool_; }                             ///< @brief 获取并行任务池
+        engine::render::RenderStats getRenderStats() const;                                          ///< @brief 获取最近完成的一帧的渲染统计
 
     };
 
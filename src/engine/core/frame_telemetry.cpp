@@ -0,0 +1,85 @@
+#include "frame_telemetry.h"
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace engine::core {
+
+    FrameTelemetry::FrameTelemetry(double report_interval_seconds)
+        : window_start_ns_(SDL_GetTicksNS()),
+        report_interval_ns_(static_cast<Uint64>(std::max(report_interval_seconds, 0.1) * 1000000000.0)),
+        last_frame_end_ns_(window_start_ns_)
+    {
+    }
+
+    void FrameTelemetry::enableFrameSamples(std::size_t expected_frames) {
+        is_sampling_ = true;
+        frame_samples_.clear();
+        frame_samples_.reserve(expected_frames);
+        last_frame_end_ns_ = SDL_GetTicksNS();
+    }
+
+    void FrameTelemetry::logSummary() const {
+        if (frame_samples_.empty()) {
+            spdlog::info("帧耗时汇总: 没有样本。");
+            return;
+        }
+        auto sorted = frame_samples_;
+        std::sort(sorted.begin(), sorted.end());
+        Uint64 total_ns = 0;
+        for (auto ns : sorted) {
+            total_ns += ns;
+        }
+
+        constexpr double NS_TO_MS = 1.0 / 1000000.0;
+        auto percentile = [&sorted](double p) {
+            auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return static_cast<double>(sorted[index]) * NS_TO_MS;
+        };
+        double average_ms = static_cast<double>(total_ns) / sorted.size() * NS_TO_MS;
+        spdlog::info("帧耗时汇总 ({} 帧, 共 {:.1f} ms): 平均 {:.3f} ms ({:.1f} FPS) | 最小 {:.3f} | P50 {:.3f} | P95 {:.3f} | P99 {:.3f} | 最大 {:.3f} ms",
+            sorted.size(), static_cast<double>(total_ns) * NS_TO_MS, average_ms, 1000.0 / average_ms,
+            static_cast<double>(sorted.front()) * NS_TO_MS, percentile(0.5), percentile(0.95), percentile(0.99),
+            static_cast<double>(sorted.back()) * NS_TO_MS);
+    }
+
+    void FrameTelemetry::addSimulationTime(Uint64 ns) {
+        simulation_ns_.fetch_add(ns, std::memory_order_relaxed);
+        ++simulation_frames_;
+    }
+
+    void FrameTelemetry::addRenderTime(Uint64 ns) {
+        render_ns_.fetch_add(ns, std::memory_order_relaxed);
+        render_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void FrameTelemetry::endFrame() {
+        Uint64 now = SDL_GetTicksNS();
+        if (is_sampling_) {
+            frame_samples_.push_back(now - last_frame_end_ns_);
+        }
+        last_frame_end_ns_ = now;
+
+        Uint64 elapsed = now - window_start_ns_;
+        if (elapsed < report_interval_ns_ || simulation_frames_ == 0) {
+            return;
+        }
+
+        Uint64 render_frames = render_frames_.exchange(0, std::memory_order_relaxed);
+        Uint64 render_ns = render_ns_.exchange(0, std::memory_order_relaxed);
+        Uint64 simulation_ns = simulation_ns_.exchange(0, std::memory_order_relaxed);
+
+        constexpr double NS_TO_MS = 1.0 / 1000000.0;
+        double frame_ms = static_cast<double>(elapsed) / simulation_frames_ * NS_TO_MS;
+        double simulation_ms = static_cast<double>(simulation_ns) / simulation_frames_ * NS_TO_MS;
+        double render_ms = render_frames > 0 ? static_cast<double>(render_ns) / render_frames * NS_TO_MS : 0.0;
+        double overlap_ms = std::max(0.0, simulation_ms + render_ms - frame_ms);
+
+        spdlog::info("帧耗时统计: 帧 {:.2f} ms ({:.1f} FPS) | 模拟 {:.2f} ms | 渲染 {:.2f} ms | 重叠节省 {:.2f} ms",
+            frame_ms, 1000.0 / frame_ms, simulation_ms, render_ms, overlap_ms);
+
+        simulation_frames_ = 0;
+        window_start_ns_ = now;
+    }
+
+} // namespace engine::core
@@ -0,0 +1,48 @@
+#pragma once
+#include <SDL3/SDL_stdinc.h>    // 用于 Uint64
+#include <atomic>
+#include <vector>
+
+namespace engine::core {
+
+    /**
+     * @brief 帧耗时遥测：统计模拟、渲染与整帧耗时，并周期性输出到日志。
+     *
+     * 模拟耗时（输入、更新、录制渲染命令）由游戏线程记录，渲染耗时（执行命令、呈现）由渲染线程记录。
+     * 单线程循环中帧耗时约等于二者之和；启用渲染线程后二者并行，
+     * “重叠节省” = 模拟 + 渲染 - 帧耗时，即渲染线程带来的收益。
+     */
+    class FrameTelemetry final {
+    private:
+        std::atomic<Uint64> simulation_ns_ = 0;     ///< @brief 本统计周期内的模拟耗时总和
+        std::atomic<Uint64> render_ns_ = 0;         ///< @brief 本统计周期内的渲染耗时总和
+        std::atomic<Uint64> render_frames_ = 0;     ///< @brief 本统计周期内渲染的帧数
+        Uint64 simulation_frames_ = 0;              ///< @brief 本统计周期内模拟的帧数（仅游戏线程访问）
+        Uint64 window_start_ns_ = 0;                ///< @brief 本统计周期开始的时间戳
+        Uint64 report_interval_ns_ = 0;             ///< @brief 输出周期
+        Uint64 last_frame_end_ns_ = 0;              ///< @brief 上一帧结束的时间戳
+        bool is_sampling_ = false;                  ///< @brief 是否记录每帧耗时（无头基准测试）
+        std::vector<Uint64> frame_samples_;         ///< @brief 每帧耗时样本（纳秒）
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param report_interval_seconds 输出统计结果的周期（秒）
+         */
+        explicit FrameTelemetry(double report_interval_seconds = 5.0);
+
+        // 禁止拷贝和移动
+        FrameTelemetry(const FrameTelemetry&) = delete;
+        FrameTelemetry& operator=(const FrameTelemetry&) = delete;
+        FrameTelemetry(FrameTelemetry&&) = delete;
+        FrameTelemetry& operator=(FrameTelemetry&&) = delete;
+
+        void addSimulationTime(Uint64 ns);  ///< @brief 记录一帧的模拟耗时（游戏线程）
+        void addRenderTime(Uint64 ns);      ///< @brief 记录一帧的渲染耗时（渲染线程）
+        void endFrame();                    ///< @brief 游戏线程每帧结束时调用，到达输出周期时输出并重置统计
+
+        void enableFrameSamples(std::size_t expected_frames);  ///< @brief 开始记录每一帧的耗时（预留 expected_frames 个样本）
+        void logSummary() const;            ///< @brief 输出所有样本的统计（平均值、最小/最大值与百分位数）
+    };
+
+} // namespace engine::core
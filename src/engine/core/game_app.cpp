@@ -2,16 +2,34 @@
 #include "time.h"
 #include "context.h"
 #include "config.h"
+#include "frame_telemetry.h"
+#include "job_pool.h"
 #include "../resource/resource_manager.h"
 #include"../audio/audio_player.h"
 #include "../render/renderer.h"
 #include "../render/camera.h"
+#include "../render/particle_system.h"
+#include "../render/animation_system.h"
+#include "../render/text_renderer.h"
+#include "../render/frame_capture.h"
+#include "../render/dynamic_resolution.h"
+#include "../render/render_stats_writer.h"
 #include "../input/input_manager.h"
 #include "../physics/physics_engine.h"
 #include "../scene/scene_manager.h"
+#include "../scene/scene.h"
+#include "../scene/level_loader.h"
+#include "../scene/level_preloader.h"
+#include "../scene/tile_chunk_streamer.h"
 #include "../../game/sence/game_scene.h"
 #include <SDL3/SDL.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <vector>
 
 namespace engine::core {
 
@@ -25,40 +43,171 @@ namespace engine::core {
     }
 
     void GameApp::run() {
+        if (!initConfig()) {
+            spdlog::error("GameApp 初始化失败，无法运行游戏。");
+            return;
+        }
+        if (config_->cook_enabled_) {
+            runCook();
+            return;
+        }
         if (!init()) {
             spdlog::error("GameApp 初始化失败，无法运行游戏。");
             return;
         }
 
+        if (config_->headless_enabled_) {
+            // 无头模式固定使用单线程循环，保证最后一帧在退出前已经执行并呈现
+            frame_limit_ = config_->headless_frames_;
+            frame_telemetry_->enableFrameSamples(static_cast<std::size_t>(frame_limit_));
+            spdlog::info("无头模式：运行 {} 帧，固定帧间隔 {:.4f} s。", frame_limit_, config_->headless_fixed_delta_);
+            runSingleThreaded();
+            reportHeadlessResult();
+        }
+        else if (config_->render_thread_enabled_) {
+            runWithRenderThread();
+        }
+        else {
+            runSingleThreaded();
+        }
+
+        close();
+    }
+
+    void GameApp::setCommandLine(int argc, char* argv[]) {
+        command_line_args_.clear();
+        for (int i = 1; i < argc; ++i) {
+            command_line_args_.emplace_back(argv[i]);
+        }
+    }
+
+    bool GameApp::runCook() {
+        // 可以指定单个 .tmj 文件，或者一个目录（烘焙其中所有 .tmj）
+        const std::filesystem::path cook_path(config_->cook_path_);
+        std::vector<std::string> map_paths;
+        std::error_code ec;
+        if (std::filesystem::is_directory(cook_path, ec)) {
+            for (const auto& entry : std::filesystem::directory_iterator(cook_path, ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".tmj") {
+                    map_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(map_paths.begin(), map_paths.end());
+        }
+        else if (std::filesystem::is_regular_file(cook_path, ec)) {
+            map_paths.push_back(cook_path.string());
+        }
+        if (map_paths.empty()) {
+            spdlog::error("烘焙模式：'{}' 中没有找到地图文件。", config_->cook_path_);
+            return false;
+        }
+
+        int cooked_count = 0;
+        engine::core::JobPool job_pool(config_->job_worker_threads_);
+        engine::scene::LevelLoader level_loader(nullptr, &job_pool);
+        for (const auto& map_path : map_paths) {
+            if (level_loader.cookLevel(map_path)) {
+                ++cooked_count;
+            }
+            else {
+                spdlog::error("烘焙 '{}' 失败。", map_path);
+            }
+        }
+        spdlog::info("烘焙模式：{} / {} 个地图烘焙成功。", cooked_count, map_paths.size());
+        return cooked_count == static_cast<int>(map_paths.size());
+    }
+
+    void GameApp::runSingleThreaded() {
+        spdlog::info("使用单线程主循环。");
         while (is_running_) {
             time_->update();
             float delta_time = time_->getDeltaTime();
+
+            Uint64 simulation_start = SDL_GetTicksNS();
             input_manager_->update();   // 每帧首先更新输入管理器
 
             handleEvents();
             update(delta_time);
             render();
 
-         
+            Uint64 render_start = SDL_GetTicksNS();
+            frame_telemetry_->addSimulationTime(render_start - simulation_start);
+            presentFrame();
+            frame_telemetry_->addRenderTime(SDL_GetTicksNS() - render_start);
+            frame_telemetry_->endFrame();
+            recordRenderStats();
+            countFrame();
+        }
+    }
+
+    void GameApp::runWithRenderThread() {
+        // SDL 要求窗口事件与渲染在主线程上进行，因此主线程作为渲染线程，游戏逻辑移到新线程
+        spdlog::info("启用渲染线程：主线程负责事件与渲染，游戏逻辑运行在独立线程。");
+        input_manager_->setEventsPumpedExternally(true);
+        std::thread game_thread(&GameApp::gameThreadLoop, this);
+
+        while (is_running_) {
+            input_manager_->pumpEvents();
+            Uint64 render_start = SDL_GetTicksNS();
+            // 设置等待超时，游戏线程较慢时也能及时处理窗口事件
+            if (renderer_->renderSubmittedFrame(std::chrono::milliseconds(10))) {
+                frame_telemetry_->addRenderTime(SDL_GetTicksNS() - render_start);
+            }
         }
 
-        close();
+        renderer_->stopFrameExchange();
+        game_thread.join();
+        input_manager_->setEventsPumpedExternally(false);
+    }
+
+    void GameApp::gameThreadLoop() {
+        while (is_running_) {
+            time_->update();
+            float delta_time = time_->getDeltaTime();
+
+            Uint64 simulation_start = SDL_GetTicksNS();
+            input_manager_->update();
+            handleEvents();
+            if (!is_running_) {
+                break;
+            }
+            update(delta_time);
+            render();
+            frame_telemetry_->addSimulationTime(SDL_GetTicksNS() - simulation_start);
+
+            // 交出本帧命令；如果渲染线程还在执行上一帧则在这里等待
+            renderer_->submitFrame();
+            frame_telemetry_->endFrame();
+            recordRenderStats();
+            countFrame();
+        }
+        // 唤醒可能正在等待新帧的渲染线程
+        renderer_->stopFrameExchange();
     }
 
     bool GameApp::init() {
         spdlog::trace("初始化 GameApp ...");
-        if (!initConfig()) return false;
         if (!initSDL())  return false;
         if (!initTime()) return false;
         if (!initResourceManager()) return false;
         if (!initAudioPlayer())return false;
         if (!initRenderer()) return false;
+        if (!initFrameCapture()) return false;
+        if (!initDynamicResolution()) return false;
+        if (!initRenderStats()) return false;
         if (!initCamera()) return false;
         if (!initInputManager()) return false;
         if (!initPhysicsEngine()) return false;
+        if (!initParticleSystem()) return false;
+        if (!initAnimationSystem()) return false;
+        if (!initTextRenderer()) return false;
+        if (!initJobPool()) return false;
+        if (!initLevelPreloader()) return false;
+        if (!initTileChunkStreamer()) return false;
 
         if (!initContext()) return false;
         if (!initSceneManager()) return false;
+        frame_telemetry_ = std::make_unique<engine::core::FrameTelemetry>();
 
         // 创建第一个场景并压入栈
         auto scene = std::make_unique<game::scene::GameScene>(*context_, *scene_manager_);
@@ -76,6 +225,16 @@ namespace engine::core {
             return;
         }
 
+        if (input_manager_->isActionPressed("capture")) {
+            frame_capture_->toggle();   // 线程安全，渲染线程在下一帧开始时生效
+        }
+#if ENGINE_DEBUG_DRAW
+        if (input_manager_->isActionPressed("debug_draw")) {
+            renderer_->toggleDebugDraw();
+            spdlog::info("调试绘制已{}。", renderer_->isDebugDrawEnabled() ? "开启" : "关闭");
+        }
+#endif
+
         scene_manager_->handleInput();
     }
 
@@ -85,26 +244,105 @@ namespace engine::core {
     }
 
     void GameApp::render() {
+        // 场景提交渲染命令（不直接调用 SDL 渲染函数）
+        Uint64 start = SDL_GetTicksNS();
+        scene_manager_->render();
+        renderer_->addSceneRenderTime(SDL_GetTicksNS() - start);
+    }
+
+    void GameApp::recordRenderStats() {
+        if (!render_stats_writer_) {
+            return;
+        }
+        // 启用渲染线程时这是渲染线程最近呈现的一帧（通常比游戏线程晚一帧）
+        auto* scene = scene_manager_->getCurrentScene();
+        render_stats_writer_->record(static_cast<std::uint64_t>(frame_count_), renderer_->getLastFrameStats(),
+            scene ? std::string_view(scene->getName()) : std::string_view("none"), camera_->getPosition());
+    }
+
+    void GameApp::presentFrame() {
         // 1. 清除屏幕
         renderer_->clearScreen();
 
-        // 2. 具体渲染代码
-        scene_manager_->render();
+        // 2. 排序并执行本帧的渲染命令
+        renderer_->flushRenderQueue();
 
         // 3. 更新屏幕显示
         renderer_->present();
     }
 
+    void GameApp::countFrame() {
+        ++frame_count_;
+        if (frame_limit_ > 0 && frame_count_ >= frame_limit_) {
+            spdlog::info("已完成 {} 帧，结束运行。", frame_count_);
+            is_running_ = false;
+        }
+    }
+
+    void GameApp::reportHeadlessResult() {
+        frame_telemetry_->logSummary();
+        if (!headless_surface_) {
+            return;
+        }
+
+        // 对最终画面做 FNV-1a 哈希（逐行，忽略行尾填充），用于视觉回归比对
+        std::uint64_t hash = 14695981039346656037ull;
+        if (SDL_LockSurface(headless_surface_)) {
+            const int bytes_per_row = headless_surface_->w * SDL_BYTESPERPIXEL(headless_surface_->format);
+            const auto* pixels = static_cast<const std::uint8_t*>(headless_surface_->pixels);
+            for (int y = 0; y < headless_surface_->h; ++y) {
+                const auto* row = pixels + static_cast<std::size_t>(y) * headless_surface_->pitch;
+                for (int x = 0; x < bytes_per_row; ++x) {
+                    hash = (hash ^ row[x]) * 1099511628211ull;
+                }
+            }
+            SDL_UnlockSurface(headless_surface_);
+        }
+        spdlog::info("最终画面 {}x{} 哈希: {:016x}", headless_surface_->w, headless_surface_->h, hash);
+
+        if (!config_->headless_capture_path_.empty()) {
+            if (SDL_SaveBMP(headless_surface_, config_->headless_capture_path_.c_str())) {
+                spdlog::info("最终画面已保存到 '{}'。", config_->headless_capture_path_);
+            }
+            else {
+                spdlog::error("保存最终画面失败: {}", SDL_GetError());
+            }
+        }
+    }
+
     void GameApp::close() {
         spdlog::trace("关闭 GameApp ...");
         scene_manager_->close();
         // 为了确保正确的销毁顺序，有些智能指针对象也需要手动管理
+        level_preloader_.reset();       // 后台线程可能仍在向资源管理器解码纹理/音效
+        tile_chunk_streamer_.reset();
+        job_pool_.reset();
+        text_renderer_.reset();
         resource_manager_.reset();
 
+        if (frame_capture_) {
+            // 渲染目标属于 SDL_Renderer，需要在销毁渲染器之前读回剩余画面并释放
+            frame_capture_->shutdown(sdl_renderer_);
+            if (renderer_) {
+                renderer_->setFrameCapture(nullptr);
+            }
+            frame_capture_.reset();
+        }
+        if (dynamic_resolution_) {
+            dynamic_resolution_->releaseTarget();
+            if (renderer_) {
+                renderer_->setDynamicResolution(nullptr);
+            }
+            dynamic_resolution_.reset();
+        }
         if (sdl_renderer_ != nullptr) {
             SDL_DestroyRenderer(sdl_renderer_);
             sdl_renderer_ = nullptr;
         }
+        if (headless_surface_ != nullptr) {
+            SDL_DestroySurface(headless_surface_);
+            headless_surface_ = nullptr;
+        }
         if (window_ != nullptr) {
             SDL_DestroyWindow(window_);
             window_ = nullptr;
@@ -117,6 +355,7 @@ namespace engine::core {
     {
         try {
             config_ = std::make_unique<engine::core::Config>("assets/config.json");
+            config_->applyCommandLine(command_line_args_);
         }
         catch (const std::exception& e) {
             spdlog::error("初始化配置失败: {}", e.what());
@@ -128,28 +367,50 @@ namespace engine::core {
 
     bool GameApp::initSDL()
     {
+        if (config_->headless_enabled_) {
+            // 无头模式：不需要显示器和声卡
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        }
         if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
             spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
             return false;
         }
 
-        window_ = SDL_CreateWindow(config_->window_title_.c_str(), config_->window_width_, config_->window_height_, SDL_WINDOW_RESIZABLE);
-        if (window_ == nullptr) {
-            spdlog::error("无法创建窗口! SDL错误: {}", SDL_GetError());
-            return false;
+        if (config_->headless_enabled_) {
+            // 用与窗口同样大小的图像作为软件渲染器的目标，之后的逻辑分辨率设置与窗口模式完全相同
+            headless_surface_ = SDL_CreateSurface(config_->window_width_, config_->window_height_, SDL_PIXELFORMAT_XRGB8888);
+            if (headless_surface_ == nullptr) {
+                spdlog::error("无法创建无头模式目标图像! SDL错误: {}", SDL_GetError());
+                return false;
+            }
+            sdl_renderer_ = SDL_CreateSoftwareRenderer(headless_surface_);
+            if (sdl_renderer_ == nullptr) {
+                spdlog::error("无法创建软件渲染器! SDL错误: {}", SDL_GetError());
+                return false;
+            }
+            spdlog::info("无头模式：视频驱动 '{}'，软件渲染器 {}x{}。",
+                SDL_GetCurrentVideoDriver() ? SDL_GetCurrentVideoDriver() : "none", config_->window_width_, config_->window_height_);
         }
-
-        sdl_renderer_ = SDL_CreateRenderer(window_, nullptr);
-        if (sdl_renderer_ == nullptr) {
-            spdlog::error("无法创建渲染器! SDL错误: {}", SDL_GetError());
-            return false;
+        else {
+            window_ = SDL_CreateWindow(config_->window_title_.c_str(), config_->window_width_, config_->window_height_, SDL_WINDOW_RESIZABLE);
+            if (window_ == nullptr) {
+                spdlog::error("无法创建窗口! SDL错误: {}", SDL_GetError());
+                return false;
+            }
+
+            sdl_renderer_ = SDL_CreateRenderer(window_, nullptr);
+            if (sdl_renderer_ == nullptr) {
+                spdlog::error("无法创建渲染器! SDL错误: {}", SDL_GetError());
+                return false;
+            }
+
+            // 设置 VSync (注意: VSync 开启时，驱动程序会尝试将帧率限制到显示器刷新率，有可能会覆盖我们手动设置的 target_fps)
+            int vsync_mode = config_->vsync_enabled_ ? SDL_RENDERER_VSYNC_ADAPTIVE : SDL_RENDERER_VSYNC_DISABLED;
+            SDL_SetRenderVSync(sdl_renderer_, vsync_mode);
+            spdlog::trace("VSync 设置为: {}", config_->vsync_enabled_ ? "Enabled" : "Disabled");
         }
 
-        // 设置 VSync (注意: VSync 开启时，驱动程序会尝试将帧率限制到显示器刷新率，有可能会覆盖我们手动设置的 target_fps)
-        int vsync_mode = config_->vsync_enabled_ ? SDL_RENDERER_VSYNC_ADAPTIVE : SDL_RENDERER_VSYNC_DISABLED;
-        SDL_SetRenderVSync(sdl_renderer_, vsync_mode);
-        spdlog::trace("VSync 设置为: {}", config_->vsync_enabled_ ? "Enabled" : "Disabled");
-
         // 设置逻辑分辨率为窗口大小的一半（针对像素游戏）
         SDL_SetRenderLogicalPresentation(sdl_renderer_, config_->window_width_ / 2, config_->window_height_ / 2, SDL_LOGICAL_PRESENTATION_LETTERBOX);
         spdlog::trace("SDL 初始化成功。");
@@ -165,6 +426,10 @@ namespace engine::core {
             return false;
         }
         time_->setTargetFps(config_->target_fps_);
+        if (config_->headless_enabled_) {
+            time_->setTargetFps(0);     // 基准测试不限制帧率
+            time_->setFixedDeltaTime(config_->headless_fixed_delta_);
+        }
         spdlog::trace("时间管理初始化成功。");
         return true;
     }
@@ -247,6 +512,146 @@ namespace engine::core {
         return true;
     }
 
+    bool GameApp::initParticleSystem()
+    {
+        try {
+            particle_system_ = std::make_unique<engine::render::ParticleSystem>(*resource_manager_);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化粒子系统失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("粒子系统初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initFrameCapture()
+    {
+        try {
+            frame_capture_ = std::make_unique<engine::render::FrameCapture>(config_->capture_directory_,
+                engine::render::FrameCapture::parseFormat(config_->capture_format_),
+                static_cast<std::size_t>(config_->capture_ring_size_));
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化截帧模块失败: {}", e.what());
+            return false;
+        }
+        renderer_->setFrameCapture(frame_capture_.get());
+        frame_capture_->setEnabled(config_->capture_enabled_);
+        spdlog::trace("截帧模块初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initDynamicResolution()
+    {
+        // 帧预算：目标帧率；开启垂直同步时不超过显示器刷新率（否则帧间隔永远达不到预算）
+        double fps = static_cast<double>(config_->target_fps_);
+        if (config_->vsync_enabled_ && window_) {
+            const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window_));
+            if (mode && mode->refresh_rate > 0.0f) {
+                fps = fps > 0.0 ? std::min(fps, static_cast<double>(mode->refresh_rate)) : mode->refresh_rate;
+            }
+        }
+        if (fps <= 0.0) {
+            fps = 60.0;     // 不限制帧率时以 60 FPS 为预算
+        }
+        try {
+            dynamic_resolution_ = std::make_unique<engine::render::DynamicResolution>(1.0 / fps,
+                config_->dynamic_resolution_min_scale_, config_->dynamic_resolution_step_);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化动态分辨率失败: {}", e.what());
+            return false;
+        }
+        // 无头模式的画面哈希需要可复现，不随帧耗时变化
+        dynamic_resolution_->setEnabled(config_->dynamic_resolution_enabled_ && !config_->headless_enabled_);
+        renderer_->setDynamicResolution(dynamic_resolution_.get());
+        spdlog::trace("动态分辨率初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initRenderStats()
+    {
+        if (!config_->render_stats_enabled_) {
+            return true;
+        }
+        try {
+            render_stats_writer_ = std::make_unique<engine::render::RenderStatsWriter>(config_->render_stats_path_,
+                static_cast<std::uint32_t>(config_->render_stats_interval_));
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化渲染统计输出失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("渲染统计输出初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initAnimationSystem()
+    {
+        try {
+            animation_system_ = std::make_unique<engine::render::AnimationSystem>();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化动画系统失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("动画系统初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initTextRenderer()
+    {
+        try {
+            text_renderer_ = std::make_unique<engine::render::TextRenderer>(*renderer_, *resource_manager_);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化文字渲染器失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("文字渲染器初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initJobPool()
+    {
+        try {
+            job_pool_ = std::make_unique<engine::core::JobPool>(config_->job_worker_threads_);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化任务池失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("任务池初始化成功，{} 个工作线程。", job_pool_->getWorkerCount());
+        return true;
+    }
+
+    bool GameApp::initLevelPreloader()
+    {
+        try {
+            level_preloader_ = std::make_unique<engine::scene::LevelPreloader>(*resource_manager_, job_pool_.get());
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化关卡预加载器失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("关卡预加载器初始化成功。");
+        return true;
+    }
+
+    bool GameApp::initTileChunkStreamer()
+    {
+        try {
+            tile_chunk_streamer_ = std::make_unique<engine::scene::TileChunkStreamer>(config_->chunk_stream_radius_);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化分块流式加载器失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("分块流式加载器初始化成功。");
+        return true;
+    }
+
     bool GameApp::initContext()
     {
         try {
@@ -254,7 +659,13 @@ namespace engine::core {
                 (*input_manager_, *renderer_,
                     *camera_, *resource_manager_,
                     *physics_engine_,
-                    *audio_player_);
+                    *audio_player_,
+                    *particle_system_,
+                    *animation_system_,
+                    *text_renderer_,
+                    *level_preloader_,
+                    *tile_chunk_streamer_,
+                    *job_pool_);
         }
         catch (const std::exception& e) {
             spdlog::error("初始化上下文失败: {}", e.what());
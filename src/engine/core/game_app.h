@@ -1,9 +1,13 @@
 #pragma once
 #include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
 
 // 前向声明, 减少头文件的依赖，增加编译速度
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
 
 namespace engine::resource {
     class ResourceManager;
@@ -12,6 +16,12 @@ namespace engine::resource {
 namespace engine::render {
     class Renderer;
     class Camera;
+    class ParticleSystem;
+    class AnimationSystem;
+    class TextRenderer;
+    class FrameCapture;
+    class DynamicResolution;
+    class RenderStatsWriter;
 }
 
 namespace engine::input {
@@ -23,6 +33,8 @@ namespace engine::physics {
 
 namespace engine::scene {
     class SceneManager;
+    class LevelPreloader;
+    class TileChunkStreamer;
 }
 
 namespace engine::audio {
@@ -32,6 +44,8 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
     class Time;
     class Config;
     class Context;
+    class FrameTelemetry;
+    class JobPool;
 
     /**
      * @brief 主游戏应用程序类，初始化SDL，管理游戏循环。
@@ -40,7 +54,11 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
     private:
         SDL_Window* window_ = nullptr;
         SDL_Renderer* sdl_renderer_ = nullptr;
-        bool is_running_ = false;
+        SDL_Surface* headless_surface_ = nullptr;  ///< @brief 无头模式下软件渲染器的目标图像（代替窗口）
+        std::atomic<bool> is_running_ = false;     ///< @brief 渲染线程模式下由两个线程共同读取
+        std::vector<std::string> command_line_args_;    ///< @brief 命令行参数（不含程序名），用于覆盖配置
+        int frame_limit_ = 0;                      ///< @brief 运行的帧数上限，0 表示不限制（无头模式）
+        int frame_count_ = 0;                      ///< @brief 已完成的帧数
 
         // 引擎组件
         std::unique_ptr<engine::core::Time> time_;
@@ -53,6 +71,16 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
         std::unique_ptr<engine::scene::SceneManager> scene_manager_;
         std::unique_ptr<engine::physics::PhysicsEngine> physics_engine_;
         std::unique_ptr<engine::audio::AudioPlayer>audio_player_;
+        std::unique_ptr<engine::render::ParticleSystem> particle_system_;
+        std::unique_ptr<engine::render::AnimationSystem> animation_system_;
+        std::unique_ptr<engine::render::TextRenderer> text_renderer_;
+        std::unique_ptr<engine::core::JobPool> job_pool_;       ///< @brief 关卡加载的并行任务池（LevelPreloader 也会使用，需要比它晚销毁）
+        std::unique_ptr<engine::scene::LevelPreloader> level_preloader_;
+        std::unique_ptr<engine::scene::TileChunkStreamer> tile_chunk_streamer_;
+        std::unique_ptr<engine::render::FrameCapture> frame_capture_;
+        std::unique_ptr<engine::render::DynamicResolution> dynamic_resolution_;
+        std::unique_ptr<engine::render::RenderStatsWriter> render_stats_writer_;  ///< @brief 渲染统计 CSV（可选）
+        std::unique_ptr<engine::core::FrameTelemetry> frame_telemetry_;
     public:
         GameApp();
         ~GameApp();
@@ -62,6 +90,11 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
          */
         void run();
 
+        /**
+         * @brief 记录命令行参数，初始化时用于覆盖配置文件（例如 --headless --frames 300 --capture out.bmp）。
+         */
+        void setCommandLine(int argc, char* argv[]);
+
         // 禁止拷贝和移动
         GameApp(const GameApp&) = delete;
         GameApp& operator=(const GameApp&) = delete;
@@ -70,9 +103,17 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
 
     private:
         [[nodiscard]] bool init();      // nodiscard 表示该函数返回值不应该被忽略
+        void runSingleThreaded();       ///< @brief 单线程主循环：输入、更新、录制、执行、呈现依次进行
+        void runWithRenderThread();     ///< @brief 主线程作为渲染线程（事件与绘制），游戏逻辑运行在独立线程
+        void gameThreadLoop();          ///< @brief 渲染线程模式下游戏线程的循环
         void handleEvents();
         void update(float delta_time);
-        void render();
+        void render();                  ///< @brief 录制本帧的渲染命令（游戏线程）
+        void presentFrame();            ///< @brief 执行渲染命令并呈现（单线程模式）
+        void countFrame();              ///< @brief 统计完成的帧数，达到帧数上限时结束运行
+        void recordRenderStats();       ///< @brief 把最近完成的一帧的渲染统计交给 CSV 输出（开启时）
+        void reportHeadlessResult();    ///< @brief 无头模式结束时输出帧耗时统计与最终画面的哈希（可选保存图像）
+        bool runCook();                 ///< @brief 烘焙模式：把 Tiled 地图烘焙为二进制关卡后退出（不初始化 SDL）
         void close();
 
         // 各模块的初始化/创建函数，在init()中调用
@@ -85,6 +126,15 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
         [[nodiscard]] bool initCamera();
         [[nodiscard]] bool initInputManager();
         [[nodiscard]] bool initPhysicsEngine();
+        [[nodiscard]] bool initParticleSystem();
+        [[nodiscard]] bool initAnimationSystem();
+        [[nodiscard]] bool initTextRenderer();
+        [[nodiscard]] bool initJobPool();
+        [[nodiscard]] bool initLevelPreloader();
+        [[nodiscard]] bool initTileChunkStreamer();
+        [[nodiscard]] bool initFrameCapture();
+        [[nodiscard]] bool initDynamicResolution();
+        [[nodiscard]] bool initRenderStats();
         [[nodiscard]] bool initContext();
         [[nodiscard]] bool initSceneManager();
     };
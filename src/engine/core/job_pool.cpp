@@ -0,0 +1,101 @@
+#include "job_pool.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+    JobPool::JobPool(int worker_count) {
+        if (worker_count < 0) {
+            worker_count = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+        }
+        workers_.reserve(static_cast<std::size_t>(worker_count));
+        for (int i = 0; i < worker_count; ++i) {
+            workers_.emplace_back(&JobPool::workerLoop, this);
+        }
+        spdlog::trace("JobPool 构造成功，{} 个工作线程。", workers_.size());
+    }
+
+    JobPool::~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    void JobPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& job) {
+        if (count == 0) {
+            return;
+        }
+        if (workers_.empty() || count == 1) {   // 没有可分摊的工作：直接在调用线程上执行
+            for (std::size_t i = 0; i < count; ++i) {
+                job(i);
+            }
+            return;
+        }
+
+        auto batch = std::make_shared<Batch>();
+        batch->job = &job;
+        batch->count = count;
+        batch->remaining = count;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(batch);
+        }
+        cv_.notify_all();
+
+        runBatch(*batch);   // 调用线程也参与执行
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::erase(batches_, batch);
+        }
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->cv.wait(lock, [&batch] { return batch->is_done; });
+        if (batch->exception) {
+            std::rethrow_exception(batch->exception);
+        }
+    }
+
+    void JobPool::workerLoop() {
+        while (true) {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !batches_.empty() || is_stopping_; });
+                if (is_stopping_) {
+                    return;
+                }
+                batch = batches_.front();
+            }
+            runBatch(*batch);
+            // 该批次已经没有未领取的任务：移出队列，避免其它工作线程再次取到
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::erase(batches_, batch);
+        }
+    }
+
+    void JobPool::runBatch(Batch& batch) {
+        for (std::size_t index = batch.next.fetch_add(1); index < batch.count; index = batch.next.fetch_add(1)) {
+            try {
+                (*batch.job)(index);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (!batch.exception) {
+                    batch.exception = std::current_exception();
+                }
+            }
+            if (batch.remaining.fetch_sub(1) == 1) {    // 最后一个完成的任务通知提交者
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                batch.is_done = true;
+                batch.cv.notify_all();
+            }
+        }
+    }
+
+} // namespace engine::core
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::core {
+
+    /**
+     * @brief 固定数量工作线程的任务池，用于把相互独立的加载工作（图块集解析、瓦片层解码）分摊到多个核心。
+     *
+     * parallelFor() 阻塞到本批任务全部完成，调用线程也参与执行，因此可以在任意线程上调用
+     * （包括 LevelPreloader 的后台线程），多个线程同时提交的批次互不干扰。
+     * 工作线程数为 0 时所有任务在调用线程上依次执行。
+     */
+    class JobPool final {
+    private:
+        /// @brief 一次 parallelFor 提交的任务
+        struct Batch {
+            const std::function<void(std::size_t)>* job = nullptr;
+            std::size_t count = 0;
+            std::atomic<std::size_t> next{ 0 };         ///< @brief 下一个未领取的任务下标
+            std::atomic<std::size_t> remaining{ 0 };    ///< @brief 尚未完成的任务数量
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool is_done = false;                       ///< @brief 全部完成（受 mutex 保护）
+            std::exception_ptr exception;               ///< @brief 第一个抛出的异常（受 mutex 保护）
+        };
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::shared_ptr<Batch>> batches_;    ///< @brief 仍有未领取任务的批次（受 mutex_ 保护）
+        bool is_stopping_ = false;                      ///< @brief 通知工作线程退出（受 mutex_ 保护）
+        std::vector<std::thread> workers_;
+
+    public:
+        /**
+         * @brief 构造函数，启动工作线程。
+         * @param worker_count 工作线程数，小于 0 时使用硬件线程数 - 1（调用线程也会参与执行）
+         */
+        explicit JobPool(int worker_count);
+        ~JobPool();     ///< @brief 等待工作线程退出（此时不应有未完成的 parallelFor）
+
+        // 禁止拷贝和移动
+        JobPool(const JobPool&) = delete;
+        JobPool& operator=(const JobPool&) = delete;
+        JobPool(JobPool&&) = delete;
+        JobPool& operator=(JobPool&&) = delete;
+
+        std::size_t getWorkerCount() const { return workers_.size(); }     ///< @brief 工作线程数（不含调用线程）
+
+        /**
+         * @brief 对 [0, count) 中的每个下标执行一次 job，任务之间没有顺序保证；阻塞到全部完成。
+         * 任务抛出的第一个异常会在全部任务结束后在调用线程上重新抛出。
+         * @param count 任务数量
+         * @param job 任务，参数为任务下标
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& job);
+
+    private:
+        void workerLoop();                  ///< @brief 工作线程
+        static void runBatch(Batch& batch); ///< @brief 领取并执行批次中的任务，直到没有未领取的任务
+    };
+
+} // namespace engine::core
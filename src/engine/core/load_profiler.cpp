@@ -0,0 +1,204 @@
+#include "load_profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <spdlog/spdlog.h>
+
+#if ENGINE_COUNT_ALLOCATIONS
+
+namespace {
+    // 常量初始化，早于任何动态初始化中的分配
+    std::atomic<std::uint64_t> g_allocation_count{ 0 };
+    std::atomic<std::uint64_t> g_allocated_bytes{ 0 };
+}
+
+// 替换全局分配函数（数组与 nothrow 版本默认转发到这里；对齐版本没有替换，不计数，报告中注明）
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        auto handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif // ENGINE_COUNT_ALLOCATIONS
+
+namespace engine::core {
+
+    AllocationCounts getAllocationCounts() {
+#if ENGINE_COUNT_ALLOCATIONS
+        return { g_allocation_count.load(std::memory_order_relaxed), g_allocated_bytes.load(std::memory_order_relaxed) };
+#else
+        return {};
+#endif
+    }
+
+    // --- LoadProfiler::Scope ---
+
+    LoadProfiler::Scope::Scope(LoadProfiler& profiler, std::string_view phase)
+        : profiler_(profiler),
+        phase_index_(profiler.findOrAddPhase(phase))
+    {
+        ++profiler_.depth_;
+        start_allocations_ = getAllocationCounts();     // 查找/添加阶段本身的分配不计入
+        start_time_ = std::chrono::steady_clock::now();
+    }
+
+    LoadProfiler::Scope::~Scope() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_time_;
+        const auto allocations = getAllocationCounts();
+        --profiler_.depth_;
+        profiler_.addToPhase(phase_index_, std::chrono::duration<double, std::milli>(elapsed).count(),
+            allocations.count - start_allocations_.count, allocations.bytes - start_allocations_.bytes, 1);
+    }
+
+    // --- LoadProfiler ---
+
+    LoadProfiler::LoadProfiler(std::string name) {
+        reset(std::move(name));
+    }
+
+    void LoadProfiler::reset(std::string name) {
+        name_ = std::move(name);
+        phases_.clear();
+        counters_.clear();
+        fields_ = nlohmann::json::object();
+        depth_ = 0;
+        start_allocations_ = getAllocationCounts();
+        start_time_ = std::chrono::steady_clock::now();
+    }
+
+    void LoadProfiler::append(const LoadProfiler& other) {
+        const int base_depth = depth_;
+        for (const auto& phase : other.phases_) {
+            depth_ = base_depth + phase.depth;
+            addToPhase(findOrAddPhase(phase.name), phase.ms, phase.allocations, phase.allocated_bytes, phase.calls);
+        }
+        depth_ = base_depth;
+        for (const auto& counter : other.counters_) {
+            addCounter(counter.name, counter.count, counter.ms);
+        }
+        for (const auto& [key, value] : other.fields_.items()) {
+            fields_[key] = value;
+        }
+    }
+
+    void LoadProfiler::addCounter(std::string_view name, std::uint64_t count, double ms) {
+        auto it = std::find_if(counters_.begin(), counters_.end(), [name](const Counter& counter) { return counter.name == name; });
+        if (it == counters_.end()) {
+            it = counters_.insert(counters_.end(), Counter{ std::string(name) });
+        }
+        it->count += count;
+        it->ms += ms;
+    }
+
+    void LoadProfiler::setField(const std::string& key, nlohmann::json value) {
+        fields_[key] = std::move(value);
+    }
+
+    nlohmann::json LoadProfiler::toJson() const {
+        const auto allocations = getAllocationCounts();
+        nlohmann::json report = {
+            {"name", name_},
+            {"total_ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time_).count()},
+            {"allocations", allocations.count - start_allocations_.count},
+            {"allocated_bytes", allocations.bytes - start_allocations_.bytes},
+            {"allocation_counting", {
+                {"enabled", ENGINE_COUNT_ALLOCATIONS != 0},
+                {"includes_aligned_new", false}     // 对齐版本的 operator new 没有被替换
+            }}
+        };
+        for (const auto& [key, value] : fields_.items()) {
+            report[key] = value;
+        }
+        auto& phases = report["phases"] = nlohmann::json::array();
+        for (const auto& phase : phases_) {
+            phases.push_back({
+                {"name", phase.name},
+                {"depth", phase.depth},
+                {"calls", phase.calls},
+                {"ms", phase.ms},
+                {"allocations", phase.allocations},
+                {"allocated_bytes", phase.allocated_bytes}
+            });
+        }
+        auto& counters = report["counters"] = nlohmann::json::array();
+        for (const auto& counter : counters_) {
+            counters.push_back({ {"name", counter.name}, {"count", counter.count}, {"ms", counter.ms} });
+        }
+        return report;
+    }
+
+    void LoadProfiler::logReport() const {
+        const auto allocations = getAllocationCounts();
+        spdlog::info("加载报告 '{}': 总耗时 {:.3f} ms，{} 次分配（{:.1f} KB，{}）{}", name_,
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time_).count(),
+            allocations.count - start_allocations_.count, (allocations.bytes - start_allocations_.bytes) / 1024.0,
+            ENGINE_COUNT_ALLOCATIONS ? "不含对齐分配" : "分配计数未启用",
+            fields_.empty() ? "" : "，" + fields_.dump());
+        for (const auto& phase : phases_) {
+            spdlog::info("  {:<{}}{:<40} {:>5} 次 {:>10.3f} ms {:>8} 次分配 {:>10.1f} KB", "", phase.depth * 2, phase.name,
+                phase.calls, phase.ms, phase.allocations, phase.allocated_bytes / 1024.0);
+        }
+        for (const auto& counter : counters_) {
+            spdlog::info("  [{}] {} 次，{:.3f} ms", counter.name, counter.count, counter.ms);
+        }
+    }
+
+    bool LoadProfiler::writeReport(const std::string& file_path) const {
+        const std::filesystem::path path(file_path);
+        std::error_code error;
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            spdlog::error("无法写入加载报告: '{}'", file_path);
+            return false;
+        }
+        file << toJson().dump(4);
+        spdlog::debug("加载报告已写入: '{}'", file_path);
+        return true;
+    }
+
+    std::size_t LoadProfiler::findOrAddPhase(std::string_view phase) {
+        // 阶段数量很少（几十个），线性查找即可
+        for (std::size_t i = phases_.size(); i > 0; --i) {    // 从后往前：最近添加的阶段最常被再次进入
+            if (phases_[i - 1].name == phase) {
+                return i - 1;
+            }
+        }
+        phases_.push_back({ std::string(phase), depth_ });
+        return phases_.size() - 1;
+    }
+
+    void LoadProfiler::addToPhase(std::size_t index, double ms, std::uint64_t allocations, std::uint64_t allocated_bytes, int calls) {
+        auto& phase = phases_[index];
+        phase.calls += calls;
+        phase.ms += ms;
+        phase.allocations += allocations;
+        phase.allocated_bytes += allocated_bytes;
+    }
+
+} // namespace engine::core
@@ -0,0 +1,139 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief 堆分配计数开关：启用时 load_profiler.cpp 替换全局 operator new/delete，对所有线程的分配做原子计数。
+ * Debug 构建中启用，Release（定义了 NDEBUG）中不替换全局分配函数，报告中的分配次数全部为 0。
+ * 也可以预先定义 ENGINE_COUNT_ALLOCATIONS 为 0/1 强制关闭/开启（例如在 Release 构建中做性能分析）。
+ * 对齐版本的 operator new/delete（alignas 超过默认对齐的类型）不被替换，这些分配不计入。
+ */
+#ifndef ENGINE_COUNT_ALLOCATIONS
+#ifdef NDEBUG
+#define ENGINE_COUNT_ALLOCATIONS 0
+#else
+#define ENGINE_COUNT_ALLOCATIONS 1
+#endif
+#endif
+
+/**
+ * @brief 加载报告文件开关：启用时关卡加载报告除了写入日志，还写入 JSON 文件（见 LoadProfiler::writeReport）。
+ * 与 ENGINE_COUNT_ALLOCATIONS 相同，只在 Debug 构建中默认启用；预先定义为 0/1 可以强制关闭/开启。
+ */
+#ifndef ENGINE_WRITE_LOAD_REPORTS
+#ifdef NDEBUG
+#define ENGINE_WRITE_LOAD_REPORTS 0
+#else
+#define ENGINE_WRITE_LOAD_REPORTS 1
+#endif
+#endif
+
+namespace engine::core {
+
+    /// @brief 进程启动以来（所有线程）累计的堆分配
+    struct AllocationCounts {
+        std::uint64_t count = 0;    ///< @brief operator new 调用次数
+        std::uint64_t bytes = 0;    ///< @brief 申请的字节数
+    };
+
+    AllocationCounts getAllocationCounts();     ///< @brief 获取累计的堆分配（ENGINE_COUNT_ALLOCATIONS 为 0 时始终为 0，不含对齐分配）
+
+    /**
+     * @brief 关卡加载的分阶段计时器：记录每个阶段的墙钟时间与堆分配，最后输出到日志与 JSON 文件。
+     *
+     * 同名阶段累加（例如每个对象类型一个阶段，记录次数），报告按第一次出现的顺序排列。
+     * 阶段可以嵌套，内层阶段的耗时与分配同时计入外层阶段，报告中用 depth 表示层级。
+     * 分配计数是进程级的：阶段期间任务池及其它线程的分配也会计入。
+     * 不是线程安全的，同一时刻只能在一个线程上记录（准备阶段可能在后台线程上，构建阶段在游戏线程上）。
+     */
+    class LoadProfiler final {
+    public:
+        /// @brief 一个阶段的累计数据
+        struct Phase {
+            std::string name;                   ///< @brief 阶段名称
+            int depth = 0;                      ///< @brief 嵌套层级（0 为最外层）
+            int calls = 0;                      ///< @brief 进入次数
+            double ms = 0.0;                    ///< @brief 累计墙钟时间（毫秒）
+            std::uint64_t allocations = 0;      ///< @brief 累计堆分配次数
+            std::uint64_t allocated_bytes = 0;  ///< @brief 累计申请的字节数
+        };
+
+        /// @brief 由外部统计的计数（例如资源管理器中的纹理首次解码），不参与嵌套
+        struct Counter {
+            std::string name;                   ///< @brief 计数名称
+            std::uint64_t count = 0;            ///< @brief 次数
+            double ms = 0.0;                    ///< @brief 累计耗时（毫秒）
+        };
+
+        /// @brief 计时范围：构造时开始，析构时把耗时与分配累加到阶段
+        class Scope final {
+        private:
+            LoadProfiler& profiler_;
+            std::size_t phase_index_;
+            std::chrono::steady_clock::time_point start_time_;
+            AllocationCounts start_allocations_;
+
+        public:
+            Scope(LoadProfiler& profiler, std::string_view phase);
+            ~Scope();
+
+            // 禁止拷贝和移动
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope&&) = delete;
+        };
+
+    private:
+        std::string name_;                      ///< @brief 报告名称（关卡路径）
+        std::vector<Phase> phases_;             ///< @brief 按第一次出现顺序排列的阶段
+        std::vector<Counter> counters_;         ///< @brief 外部计数
+        nlohmann::json fields_ = nlohmann::json::object();     ///< @brief 附加信息（写入报告顶层）
+        int depth_ = 0;                         ///< @brief 当前嵌套层级
+        std::chrono::steady_clock::time_point start_time_;     ///< @brief reset 的时间
+        AllocationCounts start_allocations_;    ///< @brief reset 时的累计分配
+
+    public:
+        explicit LoadProfiler(std::string name = "");
+
+        void reset(std::string name);           ///< @brief 清空所有阶段并重新开始计时
+
+        /**
+         * @brief 开始计时一个阶段，返回的 Scope 析构时结束。
+         * @param phase 阶段名称（同名阶段累加）
+         */
+        [[nodiscard]] Scope measure(std::string_view phase) { return Scope(*this, phase); }
+
+        /**
+         * @brief 把另一个计时器的阶段、计数与附加信息合并进来，阶段嵌套在当前层级之下（同名累加）。
+         * @param other 另一个计时器（例如 LevelLoader 的计时器）
+         */
+        void append(const LoadProfiler& other);
+
+        void addCounter(std::string_view name, std::uint64_t count, double ms);   ///< @brief 累加外部计数
+        void setField(const std::string& key, nlohmann::json value);              ///< @brief 设置附加信息
+
+        const std::string& getName() const { return name_; }                  ///< @brief 报告名称
+        const std::vector<Phase>& getPhases() const { return phases_; }       ///< @brief 所有阶段
+        const std::vector<Counter>& getCounters() const { return counters_; } ///< @brief 所有外部计数
+
+        nlohmann::json toJson() const;          ///< @brief 生成报告（总耗时与总分配从 reset 算到调用时）
+        void logReport() const;                 ///< @brief 把报告输出到日志
+
+        /**
+         * @brief 把报告写入 JSON 文件（自动创建目录）。
+         * @param file_path 输出路径
+         * @return 是否成功
+         */
+        bool writeReport(const std::string& file_path) const;
+
+    private:
+        std::size_t findOrAddPhase(std::string_view phase);     ///< @brief 查找阶段，不存在时按当前层级添加
+        void addToPhase(std::size_t index, double ms, std::uint64_t allocations, std::uint64_t allocated_bytes, int calls);
+    };
+
+} // namespace engine::core
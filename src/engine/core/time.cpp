@@ -15,6 +15,11 @@ namespace engine::core {
     void Time::update() {
 
         frame_start_time_ = SDL_GetTicksNS();   // 记录进入 update 时的时间戳
+        if (fixed_delta_time_ > 0.0) {          // 固定帧间隔：不等待，直接使用固定值
+            delta_time_ = fixed_delta_time_;
+            last_time_ = frame_start_time_;
+            return;
+        }
         auto current_delta_time = static_cast<double>(frame_start_time_ - last_time_) / 1000000000.0;
         if (target_frame_time_ > 0.0) {      // 如果设置了目标帧率，则限制帧率；否则delta_time_ = current_delta_time
             limitFrameRate(current_delta_time);
@@ -19,6 +19,7 @@ namespace engine::core {
         // 帧率限制相关
         int target_fps_ = 0;             ///< @brief 目标 FPS (0 表示不限制)
         double target_frame_time_ = 0.0; ///< @brief 目标每帧时间 (秒)
+        double fixed_delta_time_ = 0.0;  ///< @brief 固定帧间隔 (秒)，大于 0 时忽略真实时间且不限制帧率
 
     public:
         Time();
@@ -77,6 +78,13 @@ namespace engine::core {
          */
         int getTargetFps() const;
 
+        /**
+         * @brief 设置固定帧间隔（无头基准测试使用，使模拟结果与机器速度无关）。
+         *
+         * @param seconds 每帧的固定时间（秒），0 表示使用真实时间。
+         */
+        void setFixedDeltaTime(double seconds) { fixed_delta_time_ = seconds > 0.0 ? seconds : 0.0; }
+
     private:
         /**
          * @brief update 中调用，用于限制帧率。如果设置了 target_fps_ > 0，且当前帧执行时间小于目标帧时间，则会调用 SDL_DelayNS() 来等待剩余时间。
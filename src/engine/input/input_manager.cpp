@@ -35,12 +35,31 @@ namespace engine::input {
         }
 
         // 2. 处理所有待处理的 SDL 事件 (这将设定 action_states_ 的值)
+        if (events_pumped_externally_) {
+            {
+                std::lock_guard<std::mutex> lock(events_mutex_);
+                processing_events_.swap(pending_events_);
+            }
+            for (const auto& event : processing_events_) {
+                processEvent(event);
+            }
+            processing_events_.clear();
+            return;
+        }
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             processEvent(event);
         }
     }
 
+    void InputManager::pumpEvents() {
+        SDL_Event event;
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        while (SDL_PollEvent(&event)) {
+            pending_events_.push_back(event);
+        }
+    }
+
     void InputManager::processEvent(const SDL_Event& event) {
         switch (event.type) {
         case SDL_EVENT_KEY_DOWN:
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <vector>
 #include <variant>
+#include <mutex>
 #include <SDL3/SDL_render.h>
 #include <glm/vec2.hpp>
 
@@ -24,6 +25,9 @@ namespace engine::input {
      *
      * 该类管理输入事件，将按键转换为动作状态，并提供查询动作状态的功能。
      * 它还处理鼠标位置的逻辑坐标转换。
+     *
+     * SDL 要求在主线程上获取事件。启用渲染线程时，主线程调用 pumpEvents() 把事件放入缓冲区，
+     * 游戏线程在 update() 中取出并处理；单线程模式下 update() 直接获取事件。
      */
     class InputManager final {
     private:
@@ -36,6 +40,11 @@ namespace engine::input {
         bool should_quit_ = false;                                      ///< @brief 退出标志
         glm::vec2 mouse_position_;                                      ///< @brief 鼠标位置 (针对屏幕坐标)
 
+        bool events_pumped_externally_ = false;                         ///< @brief 事件是否由主线程通过 pumpEvents() 提供
+        std::vector<SDL_Event> pending_events_;                         ///< @brief 主线程获取、尚未处理的事件
+        std::vector<SDL_Event> processing_events_;                      ///< @brief 游戏线程正在处理的事件（与 pending_events_ 交换，复用容量）
+        std::mutex events_mutex_;                                       ///< @brief 保护 pending_events_
+
     public:
         /**
          * @brief 构造函数
@@ -46,6 +55,8 @@ namespace engine::input {
         InputManager(SDL_Renderer* sdl_renderer, const engine::core::Config* config);
 
         void update();                                    ///< @brief 更新输入状态，每轮循环最先调用
+        void pumpEvents();                                ///< @brief （主线程）获取所有待处理的 SDL 事件并放入缓冲区，供 update() 处理
+        void setEventsPumpedExternally(bool external) { events_pumped_externally_ = external; }  ///< @brief 设置事件是否由 pumpEvents() 提供
 
 
         // 动作状态检查
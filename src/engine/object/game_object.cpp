@@ -18,9 +18,9 @@ namespace engine::object {
     }
 
     void GameObject::render(engine::core::Context& context) {
-        // 遍历所有组件并调用它们的 render 方法
-        for (auto& pair : components_) {
-            pair.second->render(context);
+        // 只遍历需要渲染的组件，跳过 Transform、Physics 等 render() 为空的组件
+        for (auto* component : render_components_) {
+            component->render(context);
         }
     }
 
@@ -30,7 +30,10 @@ namespace engine::object {
         for (auto& pair : components_) {
             pair.second->clean();
         }
+        render_components_.clear();
         components_.clear(); // 清空 map, unique_ptr 会自动释放内存
+        ++component_version_;
+        markRenderDirty();
     }
 
     void GameObject::handleInput(engine::core::Context& context) {
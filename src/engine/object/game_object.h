@@ -2,6 +2,9 @@
 #include "../component/component.h" 
 #include <memory>
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 #include <typeindex>        // 用于类型索引
 #include <utility>          // 用于完美转发
 #include <spdlog/spdlog.h>
@@ -23,6 +26,10 @@ namespace engine::object {
         std::string name_;          ///< @brief 名称
         std::string tag_;           ///< @brief 标签
         std::unordered_map<std::type_index, std::unique_ptr<engine::component::Component>> components_;  ///< @brief 组件列表
+        std::vector<engine::component::Component*> render_components_;  ///< @brief 覆盖了 render() 的组件，渲染时只遍历它们
+        std::uint32_t component_version_ = 0;   ///< @brief 每次添加/移除组件时递增，供场景判断缓存的组件指针是否过期
+        std::vector<GameObject*>* render_dirty_list_ = nullptr;    ///< @brief 包围盒可能变化时登记到的列表（由场景设置，不在渲染列表中时为空）
+        bool is_render_dirty_ = false;          ///< @brief 是否已登记到 render_dirty_list_ 中（每帧最多登记一次）
         bool need_remove_ = false;  ///< @brief 延迟删除的标识，将来由场景类负责删除
 
     public:
@@ -42,6 +49,21 @@ namespace engine::object {
         const std::string& getTag() const { return tag_; }                      ///< @brief 获取标签
         void setNeedRemove(bool need_remove) { need_remove_ = need_remove; }    ///< @brief 设置是否需要删除
         bool isNeedRemove() const { return need_remove_; }                      ///< @brief 获取是否需要删除
+        bool isRenderable() const { return !render_components_.empty(); }       ///< @brief 是否有需要渲染的组件
+        std::size_t getRenderComponentCount() const { return render_components_.size(); }   ///< @brief 需要渲染的组件数量
+        std::uint32_t getComponentVersion() const { return component_version_; } ///< @brief 获取组件版本号
+        void reserveComponents(std::size_t count) { components_.reserve(count); }   ///< @brief 预先分配组件表（已知组件数量时避免逐个添加引起的重新哈希）
+
+        // 渲染包围盒的变化通知（由场景使用，变换、精灵几何或组件变化时登记，场景只刷新登记过的对象）
+        void setRenderDirtyList(std::vector<GameObject*>* list) { render_dirty_list_ = list; is_render_dirty_ = false; }   ///< @brief 设置登记列表（为空表示不再登记）
+        bool isRenderDirty() const { return is_render_dirty_; }                 ///< @brief 是否已登记、尚未被场景处理
+        void clearRenderDirty() { is_render_dirty_ = false; }                   ///< @brief 场景处理完登记后清除标记
+        void markRenderDirty() {                                                ///< @brief 登记包围盒可能已变化（同一帧内重复调用只登记一次）
+            if (render_dirty_list_ && !is_render_dirty_) {
+                is_render_dirty_ = true;
+                render_dirty_list_->push_back(this);
+            }
+        }
 
         /**
          * @brief 添加组件 (里面会完成组件的init())
@@ -68,6 +90,11 @@ namespace engine::object {
             T* ptr = new_component.get();                               // 先获取裸指针以便返回
             new_component->setOwner(this);                              // 设置组件的拥有者
             components_[type_index] = std::move(new_component);         // 移动组件   （new_component 变为空，不可再使用）
+            if (ptr->isRenderable()) {
+                render_components_.push_back(ptr);
+            }
+            ++component_version_;
+            markRenderDirty();
             ptr->init();                                                // 初始化组件 （因此必须用ptr而不能用new_component）
             spdlog::debug("GameObject::addComponent: {} added component {}", name_, typeid(T).name());
             return ptr;                                                 // 返回非拥有指针
@@ -116,7 +143,10 @@ namespace engine::object {
             auto it = components_.find(type_index);
             if (it != components_.end()) {
                 it->second->clean();
+                std::erase(render_components_, it->second.get());
                 components_.erase(it);
+                ++component_version_;
+                markRenderDirty();
             }
         }
 
@@ -5,7 +5,11 @@
 #include "../component/collider_component.h"
 #include "../component/tilelayer_component.h"
 #include "../object/game_object.h"
+#if ENGINE_DEBUG_DRAW
+#include "../render/renderer.h"
+#endif
 #include<set>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 #include "glm/common.hpp"
 
@@ -27,12 +31,15 @@ namespace engine::physics {
     {
         layer->setPhysicsEngine(this); // 设置物理引擎指针
         collision_tile_layers_.push_back(layer);
+        has_chunked_layers_ = has_chunked_layers_ || layer->isChunked();
         spdlog::trace("碰撞瓦片图层注册完成。");
     }
 
     void PhysicsEngine::unregisterCollisionLayer(engine::component::TileLayerComponent* layer) {
         auto it = std::remove(collision_tile_layers_.begin(), collision_tile_layers_.end(), layer);
         collision_tile_layers_.erase(it, collision_tile_layers_.end());
+        has_chunked_layers_ = std::any_of(collision_tile_layers_.begin(), collision_tile_layers_.end(),
+            [](const auto* remaining) { return remaining && remaining->isChunked(); });
         spdlog::trace("碰撞瓦片图层注销完成。");
     }
 
@@ -46,6 +53,9 @@ namespace engine::physics {
             if (!pc || !pc->isEnabled()) { // 检查组件是否有效和启用
                 continue;
             }
+            if (!isTileAreaResident(pc)) {  // 周围的瓦片分块尚未装入：暂停该对象，避免穿过还没出现的地面
+                continue;
+            }
             pc->resetCollisionFlags();//重置碰撞标志
             // 应用重力 (如果组件受重力影响)：F = g * m
             if (pc->isUseGravity()) {
@@ -68,6 +78,28 @@ namespace engine::physics {
         checkTileTriggers();
     }
 
+    bool PhysicsEngine::isTileAreaResident(const engine::component::PhysicsComponent* pc) const
+    {
+        if (!has_chunked_layers_) {     // 非分块图层的瓦片始终驻留（目前所有关卡都是这种情况）
+            return true;
+        }
+        const auto* obj = pc->getOwner();
+        const auto* cc = obj ? obj->getComponent<engine::component::ColliderComponent>() : nullptr;
+        if (!cc || !cc->isActive() || cc->isTrigger()) {
+            return true;
+        }
+        auto world_aabb = cc->getWorldAABB();
+        for (const auto* layer : collision_tile_layers_) {
+            if (!layer) continue;
+            // 向四周多检查一个瓦片，覆盖本帧的位移
+            const glm::vec2 margin = layer->getTileSize();
+            if (!layer->isAreaResident({ world_aabb.position - margin, world_aabb.size + margin * 2.0f })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void PhysicsEngine::checkObjectCollisions()
     {
         // 两层循环遍历所有包含物理组件的 GameObject
@@ -473,4 +505,38 @@ namespace engine::physics {
 
         tc->translate(obj_pos - world_aabb.position);
     }
+#if ENGINE_DEBUG_DRAW
+    void PhysicsEngine::debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const {
+        namespace debug_color = engine::render::debug_color;
+        if (world_bounds_) {
+            renderer.debugRect(camera, *world_bounds_, debug_color::WORLD_BOUNDS);
+        }
+        for (const auto* layer : collision_tile_layers_) {
+            if (layer) {
+                layer->debugDraw(renderer, camera);
+            }
+        }
+        for (const auto* pc : components_) {
+            if (!pc || !pc->getOwner()) continue;
+            if (const auto* cc = pc->getOwner()->getComponent<engine::component::ColliderComponent>()) {
+                cc->debugDraw(renderer, camera);
+            }
+        }
+        // 碰撞对：连接两个碰撞器的中心
+        for (const auto& [obj_a, obj_b] : collision_pairs_) {
+            const auto* cc_a = obj_a->getComponent<engine::component::ColliderComponent>();
+            const auto* cc_b = obj_b->getComponent<engine::component::ColliderComponent>();
+            if (!cc_a || !cc_b) continue;
+            const auto aabb_a = cc_a->getWorldAABB();
+            const auto aabb_b = cc_b->getWorldAABB();
+            renderer.debugLine(camera, aabb_a.position + aabb_a.size * 0.5f, aabb_b.position + aabb_b.size * 0.5f, debug_color::CONTACT);
+        }
+        for (const auto& [obj, type] : tile_trigger_events_) {
+            if (const auto* cc = obj->getComponent<engine::component::ColliderComponent>()) {
+                renderer.debugRect(camera, cc->getWorldAABB(), debug_color::TILE_TRIGGER, true);
+            }
+        }
+    }
+#endif
+
 } // namespace
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include"../utils/math.h"
+#include "../render/debug_draw.h"
 #include <vector>
 #include <utility>  // for std::pair
 #include<optional>
@@ -15,6 +16,11 @@ namespace engine::object {
     class GameObject;
 }
 
+namespace engine::render {
+    class Renderer;
+    class Camera;
+}
+
 namespace engine::physics {
         /**
      * @brief 负责管理和模拟物理行为及碰撞检测。
@@ -24,6 +30,7 @@ namespace engine::physics {
         std::vector<engine::component::PhysicsComponent*>components_;
         //注册的物理组件容器，非拥有指针
         std::vector<engine::component::TileLayerComponent*> collision_tile_layers_;
+        bool has_chunked_layers_ = false;   ///< @brief 注册的碰撞图层中是否有分块瓦片层（没有时跳过驻留检查）
         glm::vec2 gravity_ = { 0.0f,980.0f };// 默认重力值 (像素/秒^2, 相当于100像素对应现实1m)
     
         float max_speed_ = 500.0f;//max speed
@@ -74,8 +81,16 @@ namespace engine::physics {
         };
         /// @brief 获取本帧检测到的所有瓦片触发事件。(此列表在每次 update 开始时清空)
 
+#if ENGINE_DEBUG_DRAW
+        /**
+         * @brief 录制物理调试图形：世界边界、碰撞瓦片层、所有注册对象的碰撞器、本帧的碰撞对与瓦片触发事件。
+         */
+        void debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const;
+#endif
+
     private:
         void checkObjectCollisions();    // 检测并处理对象之间的碰撞，并记录需要游戏逻辑处理的碰撞对。
+        bool isTileAreaResident(const engine::component::PhysicsComponent* pc) const;  ///< @brief 对象周围的碰撞瓦片是否都已装入（分块瓦片层）
         void resolveTileCollisions(engine::component::PhysicsComponent* pc, float delta_time);
         // 检测并处理游戏对象和瓦片层之间的碰撞。
         void resolveSolidObjectCollisions(engine::object::GameObject* move_obj, engine::object::GameObject* solid_obj);
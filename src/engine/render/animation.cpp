@@ -1,5 +1,6 @@
 #include "animation.h"
 #include <glm/common.hpp>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace engine::render {
@@ -13,8 +14,16 @@ namespace engine::render {
             spdlog::warn("尝试向动画 '{}' 添加无效持续时间的帧", name_);
             return;
         }
+        // 记录帧时长是否一致（第一帧确定基准，出现不同时长后退化为二分查找）
+        if (frames_.empty()) {
+            uniform_duration_ = duration;
+        }
+        else if (uniform_duration_ != duration) {
+            uniform_duration_ = 0.0f;
+        }
         frames_.push_back({ source_rect, duration });
         total_duration_ += duration;
+        frame_end_times_.push_back(total_duration_);
     }
 
     const AnimationFrame& Animation::getFrame(float time) const {
@@ -22,6 +31,13 @@ namespace engine::render {
             spdlog::error("动画 '{}' 没有帧，无法获取帧", name_);
             return frames_.back();      // 返回最后一帧（空的）
         }
+        return frames_[getFrameIndex(time)];
+    }
+
+    size_t Animation::getFrameIndex(float time) const {
+        if (frames_.empty()) {
+            return 0;
+        }
 
         float current_time = time;
 
@@ -29,25 +45,21 @@ namespace engine::render {
             // 对循环动画使用模运算获取有效时间
             current_time = glm::mod(time, total_duration_);
         }
-        else {
+        else if (current_time >= total_duration_) {
             // 对于非循环动画，如果时间超过总时长，则停留在最后一帧
-            if (current_time >= total_duration_) {
-                return frames_.back();
-            }
+            return frames_.size() - 1;
         }
 
-        // 遍历帧以找到正确的帧
-        float accumulated_time = 0.0f;
-        for (const auto& frame : frames_) {
-            accumulated_time += frame.duration;
-            if (current_time < accumulated_time) {
-                return frame;
-            }
+        const size_t last_index = frames_.size() - 1;
+        if (uniform_duration_ > 0.0f) {
+            // 帧时长一致：直接计算下标（浮点误差可能越界，限制在最后一帧）
+            auto index = static_cast<size_t>(current_time / uniform_duration_);
+            return std::min(index, last_index);
         }
 
-        // 理论上在不应到达这里，但为了安全起见，返回最后一帧
-        spdlog::warn("动画 '{}' 在获取帧信息时出现错误。", name_);
-        return frames_.back();
+        // 找到第一个结束时间大于当前时间的帧
+        auto it = std::upper_bound(frame_end_times_.begin(), frame_end_times_.end(), current_time);
+        return std::min(static_cast<size_t>(it - frame_end_times_.begin()), last_index);
     }
 
 } // namespace engine::render 
\ No newline at end of file
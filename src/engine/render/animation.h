@@ -24,6 +24,8 @@ namespace engine::render {
     private:
         std::string name_;//动画的名称
         std::vector<AnimationFrame>frames_;//动画帧列表
+        std::vector<float> frame_end_times_;//每帧结束时间的前缀和，用于二分查找当前帧
+        float uniform_duration_ = 0.0f;//所有帧时长相同时的单帧时长，可直接用除法定位帧；否则为 0
         float total_duration_ = 0.0f;//动画的总持续时间
         bool loop_ = true;//默认动画是循环的
 
@@ -58,11 +60,21 @@ namespace engine::render {
          */
         const AnimationFrame& getFrame(float time) const;
 
+        /**
+         * @brief 获取在给定时间点应该显示的帧的下标。
+         *
+         * 帧时长一致时直接用除法计算，否则在前缀和表上二分查找，复杂度 O(log n)。
+         * @param time 当前时间（秒）。如果动画循环，则可以超过总持续时间。
+         * @return 帧下标；动画为空时返回 0。
+         */
+        size_t getFrameIndex(float time) const;
+
 
         const std::string& getName() const { return name_; }//得到动画名称
        
         const std::vector<AnimationFrame>& getFrames() const { return frames_; }//得到帧数列表
         size_t getFrameCount() const { return frames_.size(); }//得到播放帧大小
+        const AnimationFrame& getFrameAt(size_t index) const { return frames_[index]; }//按下标得到帧（调用者保证下标有效）
         float getTotalDuration() const { return total_duration_; }//得到动画时长
         bool isLooping() const { return loop_; }//判断是否播放循环
         bool isEmpty() const { return frames_.empty(); }//判断是否为空
@@ -0,0 +1,79 @@
+#include "animation_system.h"
+#include "../component/animation_component.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    void AnimationSystem::registerComponent(engine::component::AnimationComponent* component) {
+        if (!component || component->system_index_ != engine::component::AnimationComponent::UNREGISTERED) {
+            return;
+        }
+        component->system_index_ = animators_.size();
+        animators_.push_back(component);
+        spdlog::trace("动画组件注册完成。");
+    }
+
+    void AnimationSystem::unregisterComponent(engine::component::AnimationComponent* component) {
+        if (!component) {
+            return;
+        }
+        const auto index = component->system_index_;
+        if (index >= animators_.size() || animators_[index] != component) {
+            return;
+        }
+        // 与末尾元素交换后删除，并修正被移动组件记录的下标
+        auto* last = animators_.back();
+        animators_[index] = last;
+        last->system_index_ = index;
+        animators_.pop_back();
+        component->system_index_ = engine::component::AnimationComponent::UNREGISTERED;
+        spdlog::trace("动画组件注销完成。");
+    }
+
+    void AnimationSystem::update(float delta_time) {
+        frame_changes_ = 0;
+        for (auto* animator : animators_) {
+            if (animator->advance(delta_time)) {
+                ++frame_changes_;
+            }
+        }
+
+        // 瓦片动画：全局时钟推进一次，每个动画计算一次当前帧
+        tile_clock_ += delta_time;
+        for (auto& animation : tile_animations_) {
+            const float time = static_cast<float>(std::fmod(tile_clock_, static_cast<double>(animation.total_duration)));
+            auto it = std::upper_bound(animation.frame_end_times.begin(), animation.frame_end_times.end(), time);
+            animation.current_frame = std::min(static_cast<std::size_t>(it - animation.frame_end_times.begin()), animation.frames.size() - 1);
+        }
+    }
+
+    int AnimationSystem::registerTileAnimation(const std::string& tileset, int local_id, std::vector<Sprite> frames, const std::vector<float>& durations) {
+        if (int existing = findTileAnimation(tileset, local_id); existing >= 0) {
+            return existing;
+        }
+        if (frames.empty() || frames.size() != durations.size()) {
+            spdlog::warn("图块集 '{}' 中瓦片 {} 的动画数据无效。", tileset, local_id);
+            return -1;
+        }
+        TileAnimation animation;
+        animation.frames = std::move(frames);
+        animation.frame_end_times.reserve(durations.size());
+        for (float duration : durations) {
+            animation.total_duration += std::max(duration, 0.001f);
+            animation.frame_end_times.push_back(animation.total_duration);
+        }
+        const int index = static_cast<int>(tile_animations_.size());
+        tile_animations_.push_back(std::move(animation));
+        tile_animation_index_.emplace(std::make_pair(tileset, local_id), index);
+        spdlog::debug("登记瓦片动画：图块集 '{}' 瓦片 {}，{} 帧。", tileset, local_id, tile_animations_.back().frames.size());
+        return index;
+    }
+
+    int AnimationSystem::findTileAnimation(const std::string& tileset, int local_id) const {
+        auto it = tile_animation_index_.find(std::make_pair(tileset, local_id));
+        return it != tile_animation_index_.end() ? it->second : -1;
+    }
+
+} // namespace engine::render
@@ -0,0 +1,79 @@
+#pragma once
+#include "sprite.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace engine::component {
+    class AnimationComponent;
+}
+
+namespace engine::render {
+
+    /**
+     * @brief 统一推进所有动画组件的播放。
+     *
+     * AnimationComponent 在 init 时注册、clean 时注销，系统把它们保存在一个紧凑数组中，
+     * 每帧在 Scene::update 中一次遍历全部更新（不再经过组件的虚函数 update）。
+     * 注销时与末尾元素交换后删除，组件记录自己在数组中的下标，因此注册与注销都是 O(1)。
+     *
+     * 同时维护瓦片动画表：Tiled 图块集中带动画的瓦片按（图块集, 局部 ID）登记一次，
+     * 所有瓦片动画共用一个全局时钟，每帧只为每个动画（而不是每个瓦片）计算一次当前帧。
+     * 瓦片只保存动画下标，渲染时取当前帧，因此大量动画瓦片的开销与静态瓦片相同。
+     */
+    class AnimationSystem final {
+    private:
+        /// @brief 一个瓦片动画（所有引用它的瓦片同步播放）
+        struct TileAnimation {
+            std::vector<Sprite> frames;             ///< @brief 每一帧的精灵（纹理 + 源矩形）
+            std::vector<float> frame_end_times;     ///< @brief 每一帧的结束时间（前缀和，秒）
+            float total_duration = 0.0f;            ///< @brief 一轮的总时长
+            std::size_t current_frame = 0;          ///< @brief 当前帧
+        };
+
+        std::vector<TileAnimation> tile_animations_;                        ///< @brief 瓦片动画表
+        std::map<std::pair<std::string, int>, int> tile_animation_index_;   ///< @brief （图块集路径, 局部 ID） -> 动画下标
+        double tile_clock_ = 0.0;                                           ///< @brief 瓦片动画的全局时钟（秒）
+
+        std::vector<engine::component::AnimationComponent*> animators_;    ///< @brief 已注册的动画组件（非拥有，紧凑存放）
+        std::size_t frame_changes_ = 0;                                     ///< @brief 上一次 update 中实际切换帧的组件数量
+
+    public:
+        AnimationSystem() = default;
+
+        // 禁止拷贝和移动
+        AnimationSystem(const AnimationSystem&) = delete;
+        AnimationSystem& operator=(const AnimationSystem&) = delete;
+        AnimationSystem(AnimationSystem&&) = delete;
+        AnimationSystem& operator=(AnimationSystem&&) = delete;
+
+        void registerComponent(engine::component::AnimationComponent* component);     ///< @brief 注册动画组件
+        void unregisterComponent(engine::component::AnimationComponent* component);   ///< @brief 注销动画组件（与末尾交换后删除）
+
+        /**
+         * @brief 推进所有正在播放的动画，只有帧下标变化时才更新精灵的源矩形。
+         * @param delta_time 帧间隔（秒）
+         */
+        void update(float delta_time);
+
+        /**
+         * @brief 登记一个瓦片动画，同一（图块集, 局部 ID）只登记一次。
+         * @param tileset 图块集文件路径
+         * @param local_id 瓦片在图块集中的局部 ID
+         * @param frames 每一帧的精灵
+         * @param durations 每一帧的时长（秒），与 frames 一一对应
+         * @return 动画下标，参数无效时返回 -1
+         */
+        int registerTileAnimation(const std::string& tileset, int local_id, std::vector<Sprite> frames, const std::vector<float>& durations);
+
+        int findTileAnimation(const std::string& tileset, int local_id) const;     ///< @brief 查找已登记的瓦片动画，没有返回 -1
+        const Sprite& getTileFrame(int index) const { return tile_animations_[index].frames[tile_animations_[index].current_frame]; }  ///< @brief 瓦片动画的当前帧
+        std::size_t getTileAnimationCount() const { return tile_animations_.size(); }   ///< @brief 获取瓦片动画数量
+
+        std::size_t getAnimatorCount() const { return animators_.size(); }     ///< @brief 获取已注册的组件数量
+        std::size_t getFrameChangeCount() const { return frame_changes_; }     ///< @brief 获取上一次 update 中切换帧的组件数量
+    };
+
+} // namespace engine::render
@@ -0,0 +1,65 @@
+#include "debug_draw.h"
+
+#if ENGINE_DEBUG_DRAW
+
+#include <SDL3/SDL.h>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    void DebugDraw::addLine(const glm::vec2& start, const glm::vec2& end, const SDL_FColor& color) {
+        // 沿线段法线方向各扩展半个像素，得到 1 像素宽的四边形
+        glm::vec2 direction = end - start;
+        const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        direction = length > 0.0001f ? direction / length : glm::vec2(1.0f, 0.0f);
+        const glm::vec2 normal = glm::vec2(-direction.y, direction.x) * 0.5f;
+        addQuad(start + normal, start - normal, end - normal, end + normal, color);
+    }
+
+    void DebugDraw::addRect(const SDL_FRect& rect, const SDL_FColor& color) {
+        const glm::vec2 min = { rect.x, rect.y };
+        const glm::vec2 max = { rect.x + rect.w, rect.y + rect.h };
+        // 四条边都画在矩形内侧，相邻矩形的边框不会重叠
+        addFilledRect({ min.x, min.y, rect.w, 1.0f }, color);
+        addFilledRect({ min.x, max.y - 1.0f, rect.w, 1.0f }, color);
+        addFilledRect({ min.x, min.y + 1.0f, 1.0f, rect.h - 2.0f }, color);
+        addFilledRect({ max.x - 1.0f, min.y + 1.0f, 1.0f, rect.h - 2.0f }, color);
+    }
+
+    void DebugDraw::addFilledRect(const SDL_FRect& rect, const SDL_FColor& color) {
+        if (rect.w <= 0.0f || rect.h <= 0.0f) {
+            return;
+        }
+        addQuad({ rect.x, rect.y }, { rect.x + rect.w, rect.y }, { rect.x + rect.w, rect.y + rect.h }, { rect.x, rect.y + rect.h }, color);
+    }
+
+    bool DebugDraw::execute(SDL_Renderer* sdl_renderer) {
+        if (empty()) {
+            return false;
+        }
+        const bool result = SDL_RenderGeometry(sdl_renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()),
+            indices_.data(), static_cast<int>(indices_.size()));
+        if (!result) {
+            spdlog::error("绘制调试图形失败：{}", SDL_GetError());
+        }
+        clear();
+        return result;
+    }
+
+    void DebugDraw::clear() {
+        vertices_.clear();
+        indices_.clear();
+    }
+
+    void DebugDraw::addQuad(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, const glm::vec2& d, const SDL_FColor& color) {
+        const int base = static_cast<int>(vertices_.size());
+        for (const auto& point : { a, b, c, d }) {
+            vertices_.push_back({ { point.x, point.y }, color, { 0.0f, 0.0f } });
+        }
+        indices_.insert(indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+
+} // namespace engine::render
+
+#endif // ENGINE_DEBUG_DRAW
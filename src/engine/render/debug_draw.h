@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL3/SDL_render.h>    // 用于 SDL_Vertex / SDL_FColor
+#include <cstddef>
+#include <vector>
+#include <glm/vec2.hpp>
+
+/**
+ * @brief 调试绘制开关：Debug 构建中启用，Release（定义了 NDEBUG）中整个模块及所有调用点都被编译掉。
+ * 也可以预先定义 ENGINE_DEBUG_DRAW 为 0/1 强制关闭/开启。
+ */
+#ifndef ENGINE_DEBUG_DRAW
+#ifdef NDEBUG
+#define ENGINE_DEBUG_DRAW 0
+#else
+#define ENGINE_DEBUG_DRAW 1
+#endif
+#endif
+
+#if ENGINE_DEBUG_DRAW
+
+namespace engine::render {
+
+    /**
+     * @brief 调试图形使用的颜色。
+     */
+    namespace debug_color {
+        inline constexpr SDL_FColor COLLIDER = { 0.0f, 1.0f, 0.0f, 1.0f };         ///< @brief 碰撞器
+        inline constexpr SDL_FColor TRIGGER = { 1.0f, 1.0f, 0.0f, 1.0f };          ///< @brief 触发器
+        inline constexpr SDL_FColor INACTIVE = { 0.5f, 0.5f, 0.5f, 1.0f };         ///< @brief 未激活的碰撞器
+        inline constexpr SDL_FColor CONTACT = { 1.0f, 0.0f, 1.0f, 1.0f };          ///< @brief 本帧的碰撞对（连接两者中心）
+        inline constexpr SDL_FColor TILE_TRIGGER = { 1.0f, 0.0f, 1.0f, 0.35f };    ///< @brief 本帧触发瓦片事件的对象
+        inline constexpr SDL_FColor SOLID_TILE = { 1.0f, 0.2f, 0.2f, 0.3f };       ///< @brief 静止可碰撞瓦片
+        inline constexpr SDL_FColor UNISOLID_TILE = { 1.0f, 0.6f, 0.0f, 1.0f };    ///< @brief 单向平台（上边缘）
+        inline constexpr SDL_FColor SLOPE_TILE = { 1.0f, 0.6f, 0.0f, 1.0f };       ///< @brief 斜坡（表面）
+        inline constexpr SDL_FColor HAZARD_TILE = { 1.0f, 0.0f, 1.0f, 0.3f };      ///< @brief 危险瓦片
+        inline constexpr SDL_FColor LADDER_TILE = { 0.2f, 0.6f, 1.0f, 1.0f };      ///< @brief 梯子
+        inline constexpr SDL_FColor GRID_CELL = { 0.6f, 0.6f, 0.6f, 0.6f };        ///< @brief 空间索引中有对象的格子
+        inline constexpr SDL_FColor WORLD_BOUNDS = { 0.0f, 1.0f, 1.0f, 1.0f };     ///< @brief 世界边界
+    }
+
+    /**
+     * @brief 调试图形批次：累积一帧中的线段与矩形，最后用一次 SDL_RenderGeometry 全部绘制。
+     *
+     * 线段展开为 1 像素宽的四边形，矩形为两个三角形，颜色逐顶点保存，因此不同颜色的图形也在同一批次中。
+     * 坐标为屏幕（逻辑）坐标，世界坐标的变换与裁剪由 Renderer::debugLine / debugRect 完成。
+     * 批次跟随所在的 RenderQueue 在线程之间交接，在该队列执行的最后绘制（位于所有层级之上）。
+     */
+    class DebugDraw final {
+    private:
+        std::vector<SDL_Vertex> vertices_;      ///< @brief 顶点（复用容量）
+        std::vector<int> indices_;              ///< @brief 三角形索引
+
+    public:
+        DebugDraw() = default;
+
+        // 禁止拷贝和移动
+        DebugDraw(const DebugDraw&) = delete;
+        DebugDraw& operator=(const DebugDraw&) = delete;
+        DebugDraw(DebugDraw&&) = delete;
+        DebugDraw& operator=(DebugDraw&&) = delete;
+
+        void addLine(const glm::vec2& start, const glm::vec2& end, const SDL_FColor& color);        ///< @brief 添加一条线段
+        void addRect(const SDL_FRect& rect, const SDL_FColor& color);                               ///< @brief 添加矩形边框
+        void addFilledRect(const SDL_FRect& rect, const SDL_FColor& color);                         ///< @brief 添加填充矩形
+
+        /**
+         * @brief 用一次 SDL_RenderGeometry 绘制所有图形，然后清空批次。
+         * @return 是否发出了绘制调用
+         */
+        bool execute(SDL_Renderer* sdl_renderer);
+
+        void clear();                                                       ///< @brief 清空批次（保留容量）
+        bool empty() const { return indices_.empty(); }                     ///< @brief 批次是否为空
+        std::size_t getVertexCount() const { return vertices_.size(); }     ///< @brief 获取顶点数量
+
+    private:
+        void addQuad(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, const glm::vec2& d, const SDL_FColor& color);
+    };
+
+} // namespace engine::render
+
+#endif // ENGINE_DEBUG_DRAW
@@ -0,0 +1,188 @@
+#include "dynamic_resolution.h"
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace engine::render {
+
+    void DynamicResolution::SDLTextureDeleter::operator()(SDL_Texture* texture) const {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+
+    DynamicResolution::DynamicResolution(double frame_budget, float min_scale, float step)
+        : frame_budget_(frame_budget > 0.0 ? frame_budget : 1.0 / 60.0),
+        min_scale_(std::clamp(min_scale, 0.1f, 1.0f)),
+        step_(std::clamp(step, 0.01f, 0.5f))
+    {
+        spdlog::trace("DynamicResolution 构造成功，帧预算 {:.2f} ms，缩放范围 [{:.3f}, 1]。", frame_budget_ * 1000.0, min_scale_);
+    }
+
+    DynamicResolution::~DynamicResolution() = default;
+
+    bool DynamicResolution::beginScene(SDL_Renderer* renderer) {
+        is_scene_active_ = false;
+        if (!is_enabled_ || scale_ >= 1.0f) {
+            return false;   // 原生分辨率：直接绘制到输出目标
+        }
+
+        // 逻辑画面在当前输出目标中占据的像素区域（窗口中可能有黑边；截帧纹理没有逻辑分辨率，即整个纹理）
+        int logical_width = 0;
+        int logical_height = 0;
+        SDL_RendererLogicalPresentation mode = SDL_LOGICAL_PRESENTATION_DISABLED;
+        SDL_GetRenderLogicalPresentation(renderer, &logical_width, &logical_height, &mode);
+        int output_width = 0;
+        int output_height = 0;
+        if (!SDL_GetCurrentRenderOutputSize(renderer, &output_width, &output_height) || output_width <= 0 || output_height <= 0) {
+            return false;
+        }
+        SDL_FRect logical_rect = { 0.0f, 0.0f, static_cast<float>(output_width), static_cast<float>(output_height) };
+        if (mode == SDL_LOGICAL_PRESENTATION_DISABLED || logical_width <= 0 || logical_height <= 0) {
+            logical_width = output_width;
+            logical_height = output_height;
+        }
+        else {
+            SDL_GetRenderLogicalPresentationRect(renderer, &logical_rect);
+        }
+
+        const int width = std::max(1, static_cast<int>(std::lround(logical_rect.w * scale_)));
+        const int height = std::max(1, static_cast<int>(std::lround(logical_rect.h * scale_)));
+        if (!ensureTarget(renderer, width, height, logical_width, logical_height)) {
+            setEnabled(false);
+            return false;
+        }
+
+        output_target_ = SDL_GetRenderTarget(renderer);
+        if (!SDL_SetRenderTarget(renderer, scene_target_.get())) {
+            spdlog::error("切换到动态分辨率渲染目标失败: {}", SDL_GetError());
+            return false;
+        }
+        // 渲染目标有自己的逻辑分辨率设置：命令仍使用逻辑坐标，由 SDL 缩放到降低后的像素尺寸
+        SDL_SetRenderLogicalPresentation(renderer, logical_width, logical_height, SDL_LOGICAL_PRESENTATION_STRETCH);
+        SDL_RenderClear(renderer);
+        is_scene_active_ = true;
+        return true;
+    }
+
+    void DynamicResolution::endScene(SDL_Renderer* renderer) {
+        if (!is_scene_active_) {
+            return;
+        }
+        SDL_SetRenderTarget(renderer, output_target_);
+        // 目标矩形为空：铺满输出目标的逻辑画面区域（最近邻放大）
+        if (!SDL_RenderTexture(renderer, scene_target_.get(), nullptr, nullptr)) {
+            spdlog::error("绘制动态分辨率渲染目标失败: {}", SDL_GetError());
+        }
+        output_target_ = nullptr;
+        is_scene_active_ = false;
+    }
+
+    void DynamicResolution::recordFrame() {
+        const Uint64 now = SDL_GetTicksNS();
+        const Uint64 last = last_present_ns_;
+        last_present_ns_ = now;
+        if (last == 0 || !is_enabled_) {
+            return;
+        }
+        const double interval = static_cast<double>(now - last) / 1000000000.0;
+        if (interval > MAX_SAMPLE_SECONDS) {
+            return;     // 加载或窗口拖动造成的停顿不代表渲染负载
+        }
+        addSample(interval);
+        ++frames_since_change_;
+        if (sample_count_ < WINDOW_SIZE) {
+            return;     // 每次调整后等待统计窗口填满，再根据新分辨率下的帧耗时做判断
+        }
+
+        const double average = sample_sum_ / static_cast<double>(sample_count_);
+        if (average > frame_budget_ * DOWNSCALE_THRESHOLD) {
+            frames_within_budget_ = 0;
+            if (scale_ > min_scale_) {
+                if (is_probing_) {
+                    upscale_backoff_ = std::min(upscale_backoff_ * 2, MAX_BACKOFF);     // 刚提高就撑不住：延长下次尝试的等待
+                    is_probing_ = false;
+                }
+                changeScale(std::max(min_scale_, scale_ - step_), average);
+            }
+            return;
+        }
+
+        frames_within_budget_ = average <= frame_budget_ * UPSCALE_THRESHOLD ? frames_within_budget_ + 1 : 0;
+        const int upscale_delay = UPSCALE_DELAY_FRAMES * upscale_backoff_;
+        if (is_probing_ && frames_since_change_ >= upscale_delay) {
+            is_probing_ = false;    // 提高后保持住了
+            upscale_backoff_ = 1;
+        }
+        if (scale_ < 1.0f && frames_within_budget_ >= upscale_delay) {
+            changeScale(std::min(1.0f, scale_ + step_), average);
+            is_probing_ = true;
+        }
+    }
+
+    void DynamicResolution::setEnabled(bool enabled) {
+        if (is_enabled_ == enabled) {
+            return;
+        }
+        is_enabled_ = enabled;
+        if (!enabled) {
+            scale_ = 1.0f;
+            scene_target_.reset();
+            target_width_ = 0;
+            target_height_ = 0;
+        }
+        sample_count_ = 0;
+        sample_cursor_ = 0;
+        sample_sum_ = 0.0;
+        spdlog::info("动态分辨率已{}。", enabled ? "开启" : "关闭");
+    }
+
+    bool DynamicResolution::ensureTarget(SDL_Renderer* renderer, int width, int height, int logical_width, int logical_height) {
+        if (scene_target_ && width == target_width_ && height == target_height_) {
+            return true;
+        }
+        scene_target_.reset();
+        SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!texture) {
+            spdlog::error("创建动态分辨率渲染目标失败: {}", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);    // 像素画面放大时保持清晰
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);       // 直接覆盖输出目标
+        scene_target_.reset(texture);
+        target_width_ = width;
+        target_height_ = height;
+        spdlog::debug("动态分辨率渲染目标 {}x{}（逻辑分辨率 {}x{}）。", width, height, logical_width, logical_height);
+        return true;
+    }
+
+    void DynamicResolution::addSample(double seconds) {
+        if (sample_count_ == WINDOW_SIZE) {
+            sample_sum_ -= samples_[sample_cursor_];
+        }
+        else {
+            ++sample_count_;
+        }
+        samples_[sample_cursor_] = seconds;
+        sample_sum_ += seconds;
+        sample_cursor_ = (sample_cursor_ + 1) % WINDOW_SIZE;
+    }
+
+    void DynamicResolution::changeScale(float scale, double average) {
+        spdlog::debug("动态分辨率: {:.3f} -> {:.3f}（平均帧间隔 {:.2f} ms，预算 {:.2f} ms）",
+            scale_, scale, average * 1000.0, frame_budget_ * 1000.0);
+        scale_ = scale;
+        if (scale_ >= 1.0f) {
+            scene_target_.reset();      // 回到原生分辨率，不再需要中间目标
+            target_width_ = 0;
+            target_height_ = 0;
+        }
+        frames_since_change_ = 0;
+        frames_within_budget_ = 0;
+        sample_count_ = 0;
+        sample_cursor_ = 0;
+        sample_sum_ = 0.0;
+    }
+
+} // namespace engine::render
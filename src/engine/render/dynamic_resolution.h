@@ -0,0 +1,107 @@
+#pragma once
+#include <SDL3/SDL_stdinc.h>    // 用于 Uint64
+#include <array>
+#include <cstddef>
+#include <memory>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine::render {
+
+    /**
+     * @brief 动态分辨率：按帧耗时调整场景的内部渲染分辨率。
+     *
+     * 场景（UI 以下的层级）先绘制到一个中间渲染目标，其像素尺寸为 当前输出中逻辑画面的像素尺寸 × scale，
+     * 再以最近邻过滤放大到输出上；UI 层级在放大之后直接绘制，始终保持原生分辨率。scale 为 1 时不使用中间目标。
+     *
+     * scale 由最近若干帧的平均帧间隔与帧预算比较决定（滞回）：
+     * - 平均帧间隔超出预算一定比例时降低一档；
+     * - 平均帧间隔持续不超过预算一段时间后尝试提高一档。帧率受垂直同步或帧率限制约束时无法直接测出余量，
+     *   因此提高之后如果很快又被迫降低，下一次尝试的等待时间加倍，避免在两档之间来回振荡。
+     * 所有方法都在渲染线程上调用。
+     */
+    class DynamicResolution final {
+    private:
+        struct SDLTextureDeleter {
+            void operator()(SDL_Texture* texture) const;
+        };
+
+        static constexpr std::size_t WINDOW_SIZE = 30;          ///< @brief 滚动平均的帧数
+        static constexpr double DOWNSCALE_THRESHOLD = 1.10;     ///< @brief 平均帧间隔超过 预算 × 该值 时降低分辨率
+        static constexpr double UPSCALE_THRESHOLD = 1.02;       ///< @brief 平均帧间隔不超过 预算 × 该值 时视为满足预算
+        static constexpr double MAX_SAMPLE_SECONDS = 0.25;      ///< @brief 超过该值的帧间隔（加载、拖动窗口等）不计入统计
+        static constexpr int UPSCALE_DELAY_FRAMES = 120;        ///< @brief 连续满足预算多少帧后尝试提高一档（乘以等待倍数）
+        static constexpr int MAX_BACKOFF = 16;                  ///< @brief 提高尝试等待时间的最大倍数
+
+        // --- 配置 ---
+        double frame_budget_ = 1.0 / 60.0;      ///< @brief 每帧预算（秒）
+        float min_scale_ = 0.5f;                ///< @brief 最低缩放
+        float step_ = 0.125f;                   ///< @brief 每次调整的幅度
+        bool is_enabled_ = true;                ///< @brief 是否启用（关闭时固定为 1）
+
+        // --- 帧耗时统计 ---
+        std::array<double, WINDOW_SIZE> samples_{};     ///< @brief 最近的帧间隔（环形缓冲）
+        std::size_t sample_count_ = 0;                  ///< @brief 缓冲中的有效样本数
+        std::size_t sample_cursor_ = 0;                 ///< @brief 下一个样本写入的位置
+        double sample_sum_ = 0.0;                       ///< @brief 有效样本之和
+        Uint64 last_present_ns_ = 0;                    ///< @brief 上一次呈现的时间戳
+
+        // --- 控制器状态 ---
+        float scale_ = 1.0f;                    ///< @brief 当前缩放
+        int frames_since_change_ = 0;           ///< @brief 距离上次调整的帧数
+        int frames_within_budget_ = 0;          ///< @brief 连续满足预算的帧数
+        int upscale_backoff_ = 1;               ///< @brief 提高尝试的等待倍数
+        bool is_probing_ = false;               ///< @brief 刚刚提高过分辨率，尚未确认能否保持
+
+        // --- 中间渲染目标 ---
+        std::unique_ptr<SDL_Texture, SDLTextureDeleter> scene_target_;  ///< @brief 场景渲染目标
+        int target_width_ = 0;                  ///< @brief 渲染目标像素尺寸
+        int target_height_ = 0;
+        SDL_Texture* output_target_ = nullptr;  ///< @brief 本帧的输出目标（窗口为 nullptr，截帧时为截帧纹理）
+        bool is_scene_active_ = false;          ///< @brief 场景是否正在绘制到中间目标
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param frame_budget 每帧预算（秒），通常为 1 / 目标帧率
+         * @param min_scale 最低缩放（0~1）
+         * @param step 每次调整的幅度
+         */
+        DynamicResolution(double frame_budget, float min_scale, float step);
+        ~DynamicResolution();
+
+        // 禁止拷贝和移动
+        DynamicResolution(const DynamicResolution&) = delete;
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+        DynamicResolution(DynamicResolution&&) = delete;
+        DynamicResolution& operator=(DynamicResolution&&) = delete;
+
+        /**
+         * @brief 清屏之后、执行场景命令之前调用：需要降低分辨率时切换到中间渲染目标。
+         * @return 是否使用中间目标（返回 true 时必须在 UI 命令之前调用 endScene()）
+         */
+        bool beginScene(SDL_Renderer* renderer);
+
+        /**
+         * @brief 场景命令执行完毕后调用：切回输出目标，并把场景以最近邻过滤放大绘制上去。
+         */
+        void endScene(SDL_Renderer* renderer);
+
+        /**
+         * @brief 每帧呈现之后调用，记录帧间隔并调整缩放。
+         */
+        void recordFrame();
+
+        void setEnabled(bool enabled);                              ///< @brief 启用/关闭（关闭时恢复原生分辨率）
+        bool isEnabled() const { return is_enabled_; }              ///< @brief 是否启用
+        float getScale() const { return scale_; }                   ///< @brief 获取当前缩放
+        void releaseTarget() { scene_target_.reset(); }             ///< @brief 释放中间渲染目标，在销毁 SDL_Renderer 之前调用
+
+    private:
+        bool ensureTarget(SDL_Renderer* renderer, int width, int height, int logical_width, int logical_height);
+        void addSample(double seconds);                             ///< @brief 加入一个帧间隔样本
+        void changeScale(float scale, double average);              ///< @brief 调整缩放并重置统计
+    };
+
+} // namespace engine::render
@@ -0,0 +1,263 @@
+#include "frame_capture.h"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace engine::render {
+
+    void FrameCapture::SDLTextureDeleter::operator()(SDL_Texture* texture) const {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+
+    void FrameCapture::SDLSurfaceDeleter::operator()(SDL_Surface* surface) const {
+        if (surface) {
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    FrameCapture::FrameCapture(std::string directory, Format format, std::size_t ring_size)
+        : directory_(std::move(directory)), format_(format), ring_size_(std::max<std::size_t>(ring_size, 2))
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) {
+            spdlog::warn("无法创建截帧目录 '{}': {}", directory_, error.message());
+        }
+        stat_start_ns_ = SDL_GetTicksNS();
+        worker_ = std::thread(&FrameCapture::workerLoop, this);
+        spdlog::trace("FrameCapture 构造成功，输出目录 '{}'，环形缓冲 {} 帧。", directory_, ring_size_);
+    }
+
+    FrameCapture::~FrameCapture() {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            is_stopping_ = true;
+        }
+        jobs_cv_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        if (!slots_.empty()) {
+            spdlog::warn("FrameCapture 销毁时渲染目标尚未释放，未读回的画面被丢弃。");
+        }
+    }
+
+    void FrameCapture::setEnabled(bool enabled) {
+        if (is_enabled_.exchange(enabled) != enabled) {
+            spdlog::info("截帧已{}（输出到 '{}'）。", enabled ? "开启" : "关闭", directory_);
+        }
+    }
+
+    FrameCapture::Format FrameCapture::parseFormat(const std::string& name) {
+        if (name == "raw") {
+            return Format::RAW;
+        }
+        if (name != "png") {
+            spdlog::warn("未知的截帧格式 '{}'，使用 png。", name);
+        }
+        return Format::PNG;
+    }
+
+    void FrameCapture::beginFrame(SDL_Renderer* renderer) {
+        is_frame_active_ = false;
+        if (!is_enabled_.load(std::memory_order_relaxed)) {
+            if (!slots_.empty()) {
+                releaseTargets(renderer);   // 关闭后读回剩余画面，释放显存
+            }
+            return;
+        }
+
+        Uint64 start = SDL_GetTicksNS();
+        if (!ensureTargets(renderer)) {
+            setEnabled(false);
+            return;
+        }
+        // 复用槽位前读回其中 ring_size 帧之前的画面
+        auto& slot = slots_[current_slot_];
+        if (slot.has_pending_frame) {
+            readbackSlot(renderer, slot);
+        }
+        if (!SDL_SetRenderTarget(renderer, slot.texture.get())) {
+            spdlog::error("切换截帧渲染目标失败: {}", SDL_GetError());
+            return;
+        }
+        is_frame_active_ = true;
+        overhead_ns_ += SDL_GetTicksNS() - start;
+    }
+
+    void FrameCapture::endFrame(SDL_Renderer* renderer) {
+        if (!is_frame_active_) {
+            return;
+        }
+        Uint64 start = SDL_GetTicksNS();
+        auto& slot = slots_[current_slot_];
+        // 切回窗口，把本帧画面按逻辑分辨率的设置绘制到屏幕上
+        SDL_SetRenderTarget(renderer, nullptr);
+        SDL_RenderClear(renderer);
+        SDL_RenderTexture(renderer, slot.texture.get(), nullptr, nullptr);
+        slot.frame_index = frame_counter_++;
+        slot.has_pending_frame = true;
+        current_slot_ = (current_slot_ + 1) % slots_.size();
+        is_frame_active_ = false;
+
+        Uint64 now = SDL_GetTicksNS();
+        overhead_ns_ += now - start;
+        ++stat_frames_;
+        reportStats(now);
+    }
+
+    void FrameCapture::shutdown(SDL_Renderer* renderer) {
+        if (is_frame_active_) {
+            SDL_SetRenderTarget(renderer, nullptr);
+            is_frame_active_ = false;
+        }
+        releaseTargets(renderer);
+    }
+
+    bool FrameCapture::ensureTargets(SDL_Renderer* renderer) {
+        int width = 0;
+        int height = 0;
+        SDL_RendererLogicalPresentation mode;
+        if (!SDL_GetRenderLogicalPresentation(renderer, &width, &height, &mode) || width <= 0 || height <= 0) {
+            spdlog::error("截帧需要设置逻辑分辨率: {}", SDL_GetError());
+            return false;
+        }
+        if (!slots_.empty() && width == target_width_ && height == target_height_) {
+            return true;
+        }
+
+        releaseTargets(renderer);
+        slots_.resize(ring_size_);
+        for (auto& slot : slots_) {
+            SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+            if (!texture) {
+                spdlog::error("创建截帧渲染目标失败: {}", SDL_GetError());
+                slots_.clear();
+                return false;
+            }
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);   // 像素画面放大到窗口时保持清晰
+            slot.texture.reset(texture);
+        }
+        target_width_ = width;
+        target_height_ = height;
+        current_slot_ = 0;
+        spdlog::debug("创建 {} 个 {}x{} 截帧渲染目标。", slots_.size(), width, height);
+        return true;
+    }
+
+    void FrameCapture::readbackSlot(SDL_Renderer* renderer, Slot& slot) {
+        Uint64 start = SDL_GetTicksNS();
+        slot.has_pending_frame = false;
+
+        SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, slot.texture.get());
+        SurfacePtr surface(SDL_RenderReadPixels(renderer, nullptr));
+        SDL_SetRenderTarget(renderer, previous_target);
+        readback_ns_ += SDL_GetTicksNS() - start;
+        if (!surface) {
+            spdlog::error("读回第 {} 帧失败: {}", slot.frame_index, SDL_GetError());
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            if (jobs_.size() >= max_queued_jobs_) {
+                dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+                return;     // 编码跟不上时丢帧，而不是阻塞渲染线程
+            }
+            jobs_.push_back({ std::move(surface), slot.frame_index });
+        }
+        jobs_cv_.notify_one();
+    }
+
+    void FrameCapture::releaseTargets(SDL_Renderer* renderer) {
+        // 按帧号顺序读回所有剩余画面
+        std::vector<Slot*> pending;
+        for (auto& slot : slots_) {
+            if (slot.has_pending_frame) {
+                pending.push_back(&slot);
+            }
+        }
+        std::sort(pending.begin(), pending.end(), [](const Slot* a, const Slot* b) { return a->frame_index < b->frame_index; });
+        for (auto* slot : pending) {
+            readbackSlot(renderer, *slot);
+        }
+        slots_.clear();
+        current_slot_ = 0;
+    }
+
+    void FrameCapture::workerLoop() {
+        while (true) {
+            EncodeJob job;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this] { return !jobs_.empty() || is_stopping_; });
+                if (jobs_.empty()) {
+                    return;     // 退出前处理完队列中的所有帧
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            Uint64 start = SDL_GetTicksNS();
+            writeFrame(job);
+            encode_ns_.fetch_add(SDL_GetTicksNS() - start, std::memory_order_relaxed);
+            encoded_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void FrameCapture::writeFrame(const EncodeJob& job) {
+        char file_name[32];
+        std::snprintf(file_name, sizeof(file_name), "frame_%06llu.%s",
+            static_cast<unsigned long long>(job.frame_index), format_ == Format::PNG ? "png" : "raw");
+        const auto path = (std::filesystem::path(directory_) / file_name).string();
+
+        if (format_ == Format::PNG) {
+            if (!IMG_SavePNG(job.surface.get(), path.c_str())) {
+                spdlog::error("保存截帧 '{}' 失败: {}", path, SDL_GetError());
+            }
+            return;
+        }
+
+        // RAW：统一转换为 XRGB8888，逐行写入（去掉行尾填充）
+        SurfacePtr converted(SDL_ConvertSurface(job.surface.get(), SDL_PIXELFORMAT_XRGB8888));
+        if (!converted) {
+            spdlog::error("转换截帧像素格式失败: {}", SDL_GetError());
+            return;
+        }
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            spdlog::error("无法写入截帧文件 '{}'", path);
+            return;
+        }
+        const auto* pixels = static_cast<const char*>(converted->pixels);
+        const auto row_bytes = static_cast<std::streamsize>(converted->w) * 4;
+        for (int y = 0; y < converted->h; ++y) {
+            file.write(pixels + static_cast<std::size_t>(y) * converted->pitch, row_bytes);
+        }
+    }
+
+    void FrameCapture::reportStats(Uint64 now) {
+        constexpr Uint64 REPORT_INTERVAL_NS = 5000000000ull;
+        if (now - stat_start_ns_ < REPORT_INTERVAL_NS || stat_frames_ == 0) {
+            return;
+        }
+        constexpr double NS_TO_MS = 1.0 / 1000000.0;
+        Uint64 encoded = encoded_frames_.load(std::memory_order_relaxed);
+        double encode_ms = encoded > 0 ? static_cast<double>(encode_ns_.load(std::memory_order_relaxed)) / encoded * NS_TO_MS : 0.0;
+        spdlog::info("截帧开销: 渲染线程 {:.3f} ms/帧（其中读回 {:.3f} ms）| 后台编码 {:.2f} ms/帧 | 已写入 {} 帧，丢弃 {} 帧",
+            static_cast<double>(overhead_ns_) / stat_frames_ * NS_TO_MS,
+            static_cast<double>(readback_ns_) / stat_frames_ * NS_TO_MS,
+            encode_ms, encoded, dropped_frames_.load(std::memory_order_relaxed));
+        overhead_ns_ = 0;
+        readback_ns_ = 0;
+        stat_frames_ = 0;
+        stat_start_ns_ = now;
+    }
+
+} // namespace engine::render
@@ -0,0 +1,136 @@
+#pragma once
+#include <SDL3/SDL_stdinc.h>    // 用于 Uint64
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+struct SDL_Surface;
+
+namespace engine::render {
+
+    /**
+     * @brief 截帧：把画面保存为 PNG 或原始像素文件，编码与写盘在后台线程进行。
+     *
+     * 开启后每帧先绘制到一个渲染目标纹理（环形缓冲中的一个槽位），再把该纹理绘制到屏幕上呈现。
+     * 槽位在 ring_size 帧之后被复用时才读回其中的旧画面。读回（SDL_RenderReadPixels）仍然是渲染线程上的阻塞调用，
+     * 会同步刷新渲染命令；延迟只是让它读取较早的一帧，SDL 并不保证此时 GPU 已经完成该帧，因此仍可能停顿。
+     * 读回耗时单独计入周期统计，需要在实际的 GPU 后端上据此评估开销。读回得到的图像交给后台线程编码写盘。
+     *
+     * beginFrame()/endFrame() 由 Renderer 在渲染线程上调用；setEnabled() 可以在任意线程调用
+     * （在下一次 beginFrame 时生效）。截帧在渲染线程上的额外耗时会周期性地输出到日志。
+     */
+    class FrameCapture final {
+    public:
+        enum class Format {
+            PNG,    ///< @brief 由 SDL_image 编码为 PNG
+            RAW,    ///< @brief 直接写入像素数据（XRGB8888，逐行无填充）
+        };
+
+    private:
+        struct SDLTextureDeleter {
+            void operator()(SDL_Texture* texture) const;
+        };
+        struct SDLSurfaceDeleter {
+            void operator()(SDL_Surface* surface) const;
+        };
+        using SurfacePtr = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;
+
+        /// @brief 环形缓冲中的一个渲染目标
+        struct Slot {
+            std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;    ///< @brief 渲染目标纹理
+            Uint64 frame_index = 0;                                     ///< @brief 槽位中画面的帧号
+            bool has_pending_frame = false;                             ///< @brief 是否有尚未读回的画面
+        };
+
+        /// @brief 等待后台线程编码的一帧
+        struct EncodeJob {
+            SurfacePtr surface;
+            Uint64 frame_index = 0;
+        };
+
+        // --- 配置 ---
+        std::string directory_;                     ///< @brief 输出目录
+        Format format_ = Format::PNG;               ///< @brief 输出格式
+        std::size_t ring_size_ = 3;                 ///< @brief 环形缓冲大小（即读回延迟的帧数）
+        std::size_t max_queued_jobs_ = 8;           ///< @brief 编码队列上限，超出时丢弃新读回的帧
+
+        // --- 渲染线程状态 ---
+        std::vector<Slot> slots_;                   ///< @brief 渲染目标环形缓冲
+        std::size_t current_slot_ = 0;              ///< @brief 本帧使用的槽位
+        bool is_frame_active_ = false;              ///< @brief 本帧是否正在绘制到槽位中
+        Uint64 frame_counter_ = 0;                  ///< @brief 已截取的帧数
+        int target_width_ = 0;                      ///< @brief 渲染目标尺寸（逻辑分辨率）
+        int target_height_ = 0;
+
+        // --- 开销统计（渲染线程） ---
+        Uint64 overhead_ns_ = 0;                    ///< @brief 本统计周期内截帧在渲染线程上的耗时
+        Uint64 readback_ns_ = 0;                    ///< @brief 其中读回的耗时
+        Uint64 stat_frames_ = 0;                    ///< @brief 本统计周期内截取的帧数
+        Uint64 stat_start_ns_ = 0;                  ///< @brief 本统计周期开始的时间戳
+
+        std::atomic<bool> is_enabled_ = false;      ///< @brief 是否请求截帧（任意线程可修改）
+        std::atomic<Uint64> dropped_frames_ = 0;    ///< @brief 因编码队列已满而丢弃的帧数
+        std::atomic<Uint64> encoded_frames_ = 0;    ///< @brief 已写盘的帧数
+        std::atomic<Uint64> encode_ns_ = 0;         ///< @brief 后台线程编码与写盘的总耗时
+
+        // --- 后台编码线程 ---
+        std::deque<EncodeJob> jobs_;                ///< @brief 待编码的帧
+        std::mutex jobs_mutex_;
+        std::condition_variable jobs_cv_;
+        bool is_stopping_ = false;                  ///< @brief 通知后台线程退出（受 jobs_mutex_ 保护）
+        std::thread worker_;
+
+    public:
+        /**
+         * @brief 构造函数，启动后台编码线程。
+         * @param directory 输出目录（不存在时自动创建）
+         * @param format 输出格式
+         * @param ring_size 渲染目标数量，即读回延迟的帧数（至少为 2）
+         */
+        FrameCapture(std::string directory, Format format, std::size_t ring_size);
+        ~FrameCapture();
+
+        // 禁止拷贝和移动
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+        FrameCapture(FrameCapture&&) = delete;
+        FrameCapture& operator=(FrameCapture&&) = delete;
+
+        void setEnabled(bool enabled);                              ///< @brief 开启/关闭截帧（下一帧生效）
+        void toggle() { setEnabled(!is_enabled_.load()); }          ///< @brief 切换截帧状态
+        bool isEnabled() const { return is_enabled_.load(); }       ///< @brief 是否已请求截帧
+
+        /**
+         * @brief （渲染线程）清屏之前调用：开启截帧时把渲染目标切换到本帧的槽位，并读回槽位中 ring_size 帧前的画面。
+         */
+        void beginFrame(SDL_Renderer* renderer);
+
+        /**
+         * @brief （渲染线程）呈现之前调用：把槽位中的画面绘制到屏幕上。
+         */
+        void endFrame(SDL_Renderer* renderer);
+
+        /**
+         * @brief （渲染线程）读回所有尚未读回的画面并释放渲染目标，在销毁 SDL_Renderer 之前调用。
+         */
+        void shutdown(SDL_Renderer* renderer);
+
+        static Format parseFormat(const std::string& name);         ///< @brief "png"/"raw" -> Format，未知时返回 PNG
+
+    private:
+        bool ensureTargets(SDL_Renderer* renderer);                 ///< @brief 按当前逻辑分辨率创建（或重建）渲染目标
+        void readbackSlot(SDL_Renderer* renderer, Slot& slot);      ///< @brief 读回槽位中的画面并交给后台线程
+        void releaseTargets(SDL_Renderer* renderer);                ///< @brief 读回剩余画面后释放所有渲染目标
+        void workerLoop();                                          ///< @brief 后台编码线程
+        void writeFrame(const EncodeJob& job);                      ///< @brief 编码并写盘一帧
+        void reportStats(Uint64 now);                               ///< @brief 周期性输出截帧开销
+    };
+
+} // namespace engine::render
@@ -0,0 +1,134 @@
+#include "particle_system.h"
+#include "renderer.h"
+#include "camera.h"
+#include "../resource/resource_manager.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    ParticleSystem::ParticleSystem(engine::resource::ResourceManager& resource_manager, std::size_t capacity)
+        : resource_manager_(resource_manager), capacity_(capacity)
+    {
+        // 一次性分配全部容量，运行期间不再分配
+        positions_.resize(capacity_);
+        velocities_.resize(capacity_);
+        ages_.resize(capacity_);
+        effect_ids_.resize(capacity_);
+        spdlog::trace("ParticleSystem 构造成功，容量: {}", capacity_);
+    }
+
+    std::optional<ParticleEffectId> ParticleSystem::registerEffect(const std::string& name, const std::string& texture_id,
+        const glm::vec2& frame_size, int frame_count, float frame_duration, std::uint8_t layer)
+    {
+        if (auto existing = findEffect(name); existing.has_value()) {
+            return existing;
+        }
+        if (frame_count <= 0 || frame_duration <= 0.0f || frame_size.x <= 0.0f || frame_size.y <= 0.0f) {
+            spdlog::error("注册特效 '{}' 失败：帧参数无效。", name);
+            return std::nullopt;
+        }
+        auto texture = resource_manager_.getTextureHandle(texture_id);
+        if (texture == 0) {
+            spdlog::error("注册特效 '{}' 失败：无法加载纹理 '{}'。", name, texture_id);
+            return std::nullopt;
+        }
+
+        ParticleEffect effect;
+        effect.name = name;
+        effect.texture = texture;
+        effect.frame_size = frame_size;
+        effect.frame_duration = frame_duration;
+        effect.lifetime = frame_duration * frame_count;
+        effect.layer = layer;
+        effect.frames.reserve(frame_count);
+        for (int i = 0; i < frame_count; ++i) {
+            effect.frames.push_back({ static_cast<float>(i) * frame_size.x, 0.0f, frame_size.x, frame_size.y });
+        }
+
+        auto id = static_cast<ParticleEffectId>(effects_.size());
+        effects_.push_back(std::move(effect));
+        effect_lookup_.emplace(name, id);
+        spdlog::debug("注册特效 '{}'（{} 帧）", name, frame_count);
+        return id;
+    }
+
+    std::optional<ParticleEffectId> ParticleSystem::findEffect(const std::string& name) const {
+        if (auto it = effect_lookup_.find(name); it != effect_lookup_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    bool ParticleSystem::emit(ParticleEffectId effect_id, const glm::vec2& center, const glm::vec2& velocity) {
+        if (effect_id >= effects_.size()) {
+            spdlog::warn("发射了未注册的特效: {}", effect_id);
+            return false;
+        }
+        if (count_ >= capacity_) {
+            spdlog::debug("粒子池已满（容量 {}），丢弃一次发射。", capacity_);
+            return false;
+        }
+        positions_[count_] = center;
+        velocities_[count_] = velocity;
+        ages_[count_] = 0.0f;
+        effect_ids_[count_] = effect_id;
+        ++count_;
+        return true;
+    }
+
+    bool ParticleSystem::emit(const std::string& effect_name, const glm::vec2& center, const glm::vec2& velocity) {
+        auto id = findEffect(effect_name);
+        if (!id.has_value()) {
+            spdlog::warn("未知特效类型: {}", effect_name);
+            return false;
+        }
+        return emit(id.value(), center, velocity);
+    }
+
+    void ParticleSystem::update(float delta_time) {
+        for (std::size_t i = 0; i < count_;) {
+            ages_[i] += delta_time;
+            if (ages_[i] >= effects_[effect_ids_[i]].lifetime) {
+                removeAt(i);        // 末尾的粒子被换到 i，本轮不递增，继续处理它
+                continue;
+            }
+            positions_[i] += velocities_[i] * delta_time;
+            ++i;
+        }
+    }
+
+    void ParticleSystem::render(Renderer& renderer, const Camera& camera) {
+        for (std::size_t i = 0; i < count_; ++i) {
+            const auto& effect = effects_[effect_ids_[i]];
+            auto frame_index = static_cast<std::size_t>(ages_[i] / effect.frame_duration);
+            if (frame_index >= effect.frames.size()) {
+                frame_index = effect.frames.size() - 1;
+            }
+            // 粒子位置为中心点，绘制需要左上角
+            renderer.drawTexture(camera, effect.texture, effect.frames[frame_index],
+                positions_[i] - effect.frame_size * 0.5f, effect.frame_size, effect.layer);
+        }
+    }
+
+    void ParticleSystem::clear() {
+        count_ = 0;
+    }
+
+    void ParticleSystem::clearEffects() {
+        count_ = 0;
+        effects_.clear();
+        effect_lookup_.clear();
+    }
+
+    void ParticleSystem::removeAt(std::size_t index) {
+        std::size_t last = count_ - 1;
+        if (index != last) {
+            positions_[index] = positions_[last];
+            velocities_[index] = velocities_[last];
+            ages_[index] = ages_[last];
+            effect_ids_[index] = effect_ids_[last];
+        }
+        --count_;
+    }
+
+} // namespace engine::render
@@ -0,0 +1,108 @@
+#pragma once
+#include "render_queue.h"
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::resource {
+    class ResourceManager;
+}
+
+namespace engine::render {
+    class Renderer;
+    class Camera;
+
+    using ParticleEffectId = std::uint16_t;     ///< @brief 特效定义的编号（注册顺序）
+
+    /**
+     * @brief 特效定义：一段所有实例共享的帧动画剪辑。
+     */
+    struct ParticleEffect {
+        std::string name;                               ///< @brief 特效名称
+        engine::resource::TextureHandle texture = 0;    ///< @brief 纹理句柄
+        std::vector<SDL_FRect> frames;                  ///< @brief 动画帧的源矩形
+        glm::vec2 frame_size = { 0.0f, 0.0f };          ///< @brief 单帧尺寸（绘制尺寸）
+        float frame_duration = 0.1f;                    ///< @brief 每帧持续时间（秒）
+        float lifetime = 0.0f;                          ///< @brief 总时长 = 帧数 * 每帧时长
+        std::uint8_t layer = render_layer::EFFECT;      ///< @brief 渲染层级
+    };
+
+    /**
+     * @brief 池化的特效/粒子系统。
+     *
+     * 所有存活的粒子以 SoA（结构数组）形式存放在固定容量的数组中，
+     * 发射与回收只修改数组内容（回收时与末尾交换），运行期间不会分配内存。
+     * 动画剪辑按特效注册一次，所有粒子共享。
+     * 同一特效的粒子排序键相同，在渲染队列中连续执行，只解析一次纹理。
+     */
+    class ParticleSystem final {
+    private:
+        engine::resource::ResourceManager& resource_manager_;   ///< @brief 资源管理器，用于解析纹理
+        std::vector<ParticleEffect> effects_;                   ///< @brief 已注册的特效（下标即 ParticleEffectId）
+        std::unordered_map<std::string, ParticleEffectId> effect_lookup_;  ///< @brief 特效名称 -> 编号
+
+        // --- SoA 粒子池，[0, count_) 为存活粒子 ---
+        std::size_t capacity_ = 0;                              ///< @brief 池容量
+        std::size_t count_ = 0;                                 ///< @brief 存活粒子数量
+        std::vector<glm::vec2> positions_;                      ///< @brief 中心位置（世界坐标）
+        std::vector<glm::vec2> velocities_;                     ///< @brief 速度（像素/秒）
+        std::vector<float> ages_;                               ///< @brief 已存在时间（秒）
+        std::vector<ParticleEffectId> effect_ids_;              ///< @brief 所属特效
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param resource_manager 资源管理器
+         * @param capacity 粒子池容量，池满时新的发射会被丢弃
+         */
+        ParticleSystem(engine::resource::ResourceManager& resource_manager, std::size_t capacity = 256);
+
+        // 禁止拷贝和移动
+        ParticleSystem(const ParticleSystem&) = delete;
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+        ParticleSystem(ParticleSystem&&) = delete;
+        ParticleSystem& operator=(ParticleSystem&&) = delete;
+
+        /**
+         * @brief 注册一个水平排列的帧动画特效。已存在同名特效时直接返回其编号。
+         * @param name 特效名称
+         * @param texture_id 纹理路径
+         * @param frame_size 单帧尺寸（像素）
+         * @param frame_count 帧数（从纹理左上角开始水平排列）
+         * @param frame_duration 每帧持续时间（秒）
+         * @param layer 渲染层级
+         * @return 特效编号，失败时返回 std::nullopt
+         */
+        std::optional<ParticleEffectId> registerEffect(const std::string& name, const std::string& texture_id,
+            const glm::vec2& frame_size, int frame_count, float frame_duration,
+            std::uint8_t layer = render_layer::EFFECT);
+
+        std::optional<ParticleEffectId> findEffect(const std::string& name) const;   ///< @brief 根据名称查找特效编号
+
+        /**
+         * @brief 发射一个粒子（播放一次特效）。
+         * @param effect_id 特效编号
+         * @param center 中心位置（世界坐标）
+         * @param velocity 速度（像素/秒）
+         * @return 是否发射成功（特效无效或池已满时失败）
+         */
+        bool emit(ParticleEffectId effect_id, const glm::vec2& center, const glm::vec2& velocity = { 0.0f, 0.0f });
+        bool emit(const std::string& effect_name, const glm::vec2& center, const glm::vec2& velocity = { 0.0f, 0.0f });  ///< @brief 按名称发射
+
+        void update(float delta_time);                              ///< @brief 推进所有粒子并回收播放完毕的粒子
+        void render(Renderer& renderer, const Camera& camera);      ///< @brief 提交所有存活粒子的绘制命令
+        void clear();                                               ///< @brief 清除所有存活粒子（保留特效定义）
+        void clearEffects();                                        ///< @brief 清除所有粒子与特效定义
+
+        std::size_t getActiveCount() const { return count_; }       ///< @brief 获取存活粒子数量
+        std::size_t getCapacity() const { return capacity_; }       ///< @brief 获取池容量
+
+    private:
+        void removeAt(std::size_t index);                           ///< @brief 回收粒子（与末尾交换）
+    };
+
+} // namespace engine::render
@@ -0,0 +1,149 @@
+#include "render_queue.h"
+#include "../resource/resource_manager.h"
+#include <SDL3/SDL.h>
+#include <array>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    namespace {
+        constexpr SDL_Color WHITE = { 255, 255, 255, 255 };
+
+        bool isWhite(const SDL_Color& color) {
+            return color.r == 255 && color.g == 255 && color.b == 255 && color.a == 255;
+        }
+
+        void applyColor(SDL_Texture* texture, const SDL_Color& color) {
+            SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+            SDL_SetTextureAlphaMod(texture, color.a);
+        }
+    }
+
+    void RenderQueue::sort() {
+        const std::size_t count = commands_.size();
+        order_.resize(count);
+        scratch_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            order_[i] = { commands_[i].sort_key, static_cast<std::uint32_t>(i) };
+        }
+        if (count < 2) {
+            return;
+        }
+
+        // 每趟处理 8 位，从最低字节到最高字节 (LSD)，计数排序保证稳定性
+        for (int shift = 0; shift < 64; shift += 8) {
+            std::array<std::size_t, 256> histogram{};
+            for (const auto& entry : order_) {
+                ++histogram[(entry.key >> shift) & 0xFF];
+            }
+            // 所有键在这个字节上都相同（例如纹理句柄的高位、未使用的深度），跳过这一趟
+            if (histogram[(order_[0].key >> shift) & 0xFF] == count) {
+                continue;
+            }
+            // 计数转换为每个桶的起始位置
+            std::size_t offset = 0;
+            for (auto& bucket : histogram) {
+                auto bucket_count = bucket;
+                bucket = offset;
+                offset += bucket_count;
+            }
+            for (const auto& entry : order_) {
+                scratch_[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            order_.swap(scratch_);
+        }
+    }
+
+    std::size_t RenderQueue::execute(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager& resource_manager) {
+        return execute(sdl_renderer, resource_manager, 0, {});
+    }
+
+    std::size_t RenderQueue::execute(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager& resource_manager,
+        std::uint8_t split_layer, const std::function<void()>& on_split) {
+        sort();
+
+        std::size_t draw_calls = 0;
+        engine::resource::TextureHandle last_handle = 0;
+        std::uint64_t last_layer = UINT64_MAX;
+        SDL_Texture* texture = nullptr;
+        bool is_modulated = false;      // 当前纹理是否设置了颜色调制（切换纹理或结束时恢复）
+        bool is_split_done = !on_split;
+        for (const auto& entry : order_) {
+            const auto& command = commands_[entry.index];
+            if (!is_split_done && (entry.key >> 56) >= split_layer) {
+                // 到达分界层级：渲染目标可能在回调中切换，纹理状态从头开始
+                if (is_modulated) {
+                    applyColor(texture, WHITE);
+                    is_modulated = false;
+                }
+                last_handle = 0;
+                texture = nullptr;
+                on_split();
+                is_split_done = true;
+            }
+            // 命令按纹理聚合，连续相同的句柄只解析一次
+            const std::uint64_t layer = entry.key >> 56;
+            if (command.texture != last_handle || layer != last_layer) {
+                ++stats_.batches;
+                last_layer = layer;
+            }
+            if (command.texture != last_handle) {
+                if (is_modulated) {
+                    applyColor(texture, WHITE);
+                    is_modulated = false;
+                }
+                last_handle = command.texture;
+                texture = resource_manager.getTextureByHandle(command.texture);
+                ++stats_.texture_switches;
+            }
+            if (!texture) {
+                continue;
+            }
+            const bool needs_color = !isWhite(command.color);
+            if (needs_color || is_modulated) {
+                applyColor(texture, command.color);
+                is_modulated = needs_color;
+            }
+            bool result = command.type == RenderCommandType::TILED ?
+                SDL_RenderTextureTiled(sdl_renderer, texture, &command.src_rect, command.tile_scale, &command.dst_rect) :
+                SDL_RenderTextureRotated(sdl_renderer, texture, &command.src_rect, &command.dst_rect, command.angle,
+                    nullptr, command.is_flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+            if (!result) {
+                spdlog::error("执行渲染命令失败（纹理句柄: {}）：{}", command.texture, SDL_GetError());
+                continue;
+            }
+            ++draw_calls;
+        }
+
+        if (is_modulated) {
+            applyColor(texture, WHITE);
+        }
+        if (!is_split_done) {
+            on_split();     // 没有分界层级及以上的命令，也要完成分界处的处理
+        }
+#if ENGINE_DEBUG_DRAW
+        if (debug_draw_.execute(sdl_renderer)) {
+            ++draw_calls;   // 调试图形叠加在最上层，整批只有一次绘制调用
+        }
+#endif
+
+        stats_.draw_calls += static_cast<std::uint32_t>(draw_calls);
+        clear();
+        return draw_calls;
+    }
+
+    void RenderQueue::clear() {
+        commands_.clear();
+        order_.clear();
+#if ENGINE_DEBUG_DRAW
+        debug_draw_.clear();
+#endif
+    }
+
+    RenderStats RenderQueue::takeStats() {
+        RenderStats stats = stats_;
+        stats_ = {};
+        return stats;
+    }
+
+} // namespace engine::render
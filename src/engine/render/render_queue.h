@@ -0,0 +1,135 @@
+#pragma once
+#include "../resource/resource_manager.h"
+#include "render_stats.h"
+#include "debug_draw.h"
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_pixels.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct SDL_Renderer;
+
+namespace engine::render {
+
+    /**
+     * @brief 常用的渲染层级（排序键的最高 8 位），数值小的先绘制。
+     *
+     * 关卡中的图层按照 Tiled 中的顺序，从 MAP_BASE 开始依次分配层级，
+     * 运行时创建的对象（特效等）使用更靠上的固定层级。
+     */
+    namespace render_layer {
+        inline constexpr std::uint8_t MAP_BASE = 1;     ///< @brief 关卡第一个图层
+        inline constexpr std::uint8_t MAP_MAX = 199;    ///< @brief 关卡图层可用的最大层级
+        inline constexpr std::uint8_t DEFAULT = 100;    ///< @brief 未指定层级的精灵
+        inline constexpr std::uint8_t EFFECT = 200;     ///< @brief 特效
+        inline constexpr std::uint8_t UI = 250;         ///< @brief UI（屏幕坐标）
+    }
+
+    /// @brief 层内深度的最大值（排序键中占 24 位）。对象图层中的精灵按对象顺序分配深度，需要固定在最上方的对象使用此值
+    inline constexpr std::uint32_t MAX_RENDER_DEPTH = 0xFFFFFFu;
+
+    /**
+     * @brief 绘制命令类型
+     */
+    enum class RenderCommandType : std::uint8_t {
+        SPRITE,     ///< @brief 单个（可旋转、翻转的）纹理矩形
+        TILED,      ///< @brief 在目标矩形内平铺源矩形（SDL_RenderTextureTiled），用于视差背景
+    };
+
+    /**
+     * @brief 一条轻量的绘制命令。
+     *
+     * 提交时已经完成相机变换与视口裁剪，目标矩形为屏幕（逻辑）坐标，
+     * 纹理以句柄表示，执行时才解析为 SDL_Texture。
+     */
+    struct RenderCommand {
+        std::uint64_t sort_key = 0;                                 ///< @brief 排序键：层级(8) | 深度(24) | 纹理句柄(32)
+        engine::resource::TextureHandle texture = 0;                ///< @brief 纹理句柄
+        SDL_FRect src_rect = { 0.0f, 0.0f, 0.0f, 0.0f };            ///< @brief 纹理上的源矩形
+        SDL_FRect dst_rect = { 0.0f, 0.0f, 0.0f, 0.0f };            ///< @brief 屏幕上的目标矩形
+        double angle = 0.0;                                         ///< @brief 旋转角度（度）
+        bool is_flipped = false;                                    ///< @brief 是否水平翻转
+        RenderCommandType type = RenderCommandType::SPRITE;         ///< @brief 命令类型
+        float tile_scale = 1.0f;                                    ///< @brief TILED 命令中每个平铺块的缩放
+        SDL_Color color = { 255, 255, 255, 255 };                   ///< @brief 颜色/透明度调制（文字着色），白色表示不调制
+    };
+
+    /**
+     * @brief 渲染命令队列。
+     *
+     * 组件在渲染阶段只提交命令，队列在帧末按 64 位排序键进行基数排序后统一执行。
+     * 绘制顺序因此与场景遍历顺序无关：先按层级，再按深度，最后按纹理聚合以减少纹理切换。
+     * 基数排序是稳定的，排序键相同的命令保持提交顺序。
+     */
+    class RenderQueue final {
+    private:
+        struct SortEntry {
+            std::uint64_t key;      ///< @brief 排序键
+            std::uint32_t index;    ///< @brief 命令在 commands_ 中的索引
+        };
+
+        std::vector<RenderCommand> commands_;   ///< @brief 本帧提交的命令（提交顺序）
+        std::vector<SortEntry> order_;          ///< @brief 排序结果
+        std::vector<SortEntry> scratch_;        ///< @brief 基数排序的临时缓冲区（复用，避免每帧分配）
+        RenderStats stats_;                     ///< @brief 本队列所录制的这一帧的统计
+#if ENGINE_DEBUG_DRAW
+        DebugDraw debug_draw_;                  ///< @brief 本帧的调试图形，在所有命令之后绘制
+#endif
+
+    public:
+        RenderQueue() = default;
+
+        // 禁止拷贝和移动
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+        RenderQueue(RenderQueue&&) = delete;
+        RenderQueue& operator=(RenderQueue&&) = delete;
+
+        /**
+         * @brief 生成排序键。
+         * @param layer 渲染层级（最高 8 位）
+         * @param depth 层内深度（24 位，超出部分被截断）
+         * @param texture 纹理句柄（最低 32 位）
+         */
+        static std::uint64_t makeSortKey(std::uint8_t layer, std::uint32_t depth, engine::resource::TextureHandle texture) {
+            return (static_cast<std::uint64_t>(layer) << 56) |
+                (static_cast<std::uint64_t>(depth & 0xFFFFFFu) << 32) |
+                static_cast<std::uint64_t>(texture);
+        }
+
+        void submit(const RenderCommand& command) { commands_.push_back(command); ++stats_.sprites_submitted; }    ///< @brief 提交一条命令
+        void addCulled(std::uint32_t count = 1) { stats_.sprites_culled += count; }      ///< @brief 记录被裁剪（未提交）的精灵
+        void addSceneRenderTime(Uint64 ns) { stats_.scene_render_ns += ns; }             ///< @brief 记录录制本帧命令的耗时
+
+        /**
+         * @brief 按排序键进行 LSD 基数排序（8 位一趟，所有键在某字节上相同时跳过该趟）。
+         */
+        void sort();
+
+        /**
+         * @brief 按排序结果依次执行所有命令，然后清空队列（统计保留到 takeStats()）。
+         * @param sdl_renderer 执行绘制的 SDL_Renderer
+         * @param resource_manager 用于把纹理句柄解析为 SDL_Texture
+         * @return 实际发出的绘制调用次数
+         */
+        std::size_t execute(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager& resource_manager);
+
+        /**
+         * @brief 同上，但在第一条层级 >= split_layer 的命令之前调用一次 on_split（没有这样的命令时在最后调用）。
+         *
+         * 用于在场景与 UI 之间切换渲染目标（见 DynamicResolution）。
+         */
+        std::size_t execute(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager& resource_manager,
+            std::uint8_t split_layer, const std::function<void()>& on_split);
+
+        void clear();                                                           ///< @brief 清空队列（保留容量）
+        RenderStats takeStats();                                                ///< @brief 取出本帧统计并重新计数
+#if ENGINE_DEBUG_DRAW
+        DebugDraw& getDebugDraw() { return debug_draw_; }                      ///< @brief 获取本帧的调试图形批次
+#endif
+        std::size_t size() const { return commands_.size(); }                   ///< @brief 获取命令数量
+        bool empty() const { return commands_.empty(); }                        ///< @brief 队列是否为空
+    };
+
+} // namespace engine::render
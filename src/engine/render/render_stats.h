@@ -0,0 +1,26 @@
+#pragma once
+#include <SDL3/SDL_stdinc.h>    // 用于 Uint64
+#include <cstdint>
+
+namespace engine::render {
+
+    /**
+     * @brief 一帧的渲染统计。
+     *
+     * 提交相关的计数（提交、裁剪、Scene::render 耗时）在录制时写入该帧的命令队列，
+     * 执行相关的计数（绘制调用、纹理切换、批次）与清屏/呈现耗时在渲染线程上补全，
+     * 因此启用渲染线程时各项仍属于同一帧。每帧重新计数。
+     */
+    struct RenderStats {
+        std::uint32_t draw_calls = 0;           ///< @brief 实际发出的绘制调用次数
+        std::uint32_t sprites_submitted = 0;    ///< @brief 提交到渲染队列的命令数
+        std::uint32_t sprites_culled = 0;       ///< @brief 被裁剪的精灵数（场景对象级裁剪 + 视口裁剪）
+        std::uint32_t texture_switches = 0;     ///< @brief 执行时切换纹理的次数
+        std::uint32_t batches = 0;              ///< @brief 批次数（层级与纹理都相同的连续命令算作一批）
+        Uint64 clear_ns = 0;                    ///< @brief clearScreen 的 CPU 耗时（纳秒）
+        Uint64 scene_render_ns = 0;             ///< @brief Scene::render（录制命令）的 CPU 耗时（纳秒）
+        Uint64 execute_ns = 0;                  ///< @brief 排序并执行命令队列的 CPU 耗时（纳秒）
+        Uint64 present_ns = 0;                  ///< @brief present 的 CPU 耗时（纳秒，可能包含垂直同步等待）
+    };
+
+} // namespace engine::render
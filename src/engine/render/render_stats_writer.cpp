@@ -0,0 +1,43 @@
+#include "render_stats_writer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    RenderStatsWriter::RenderStatsWriter(std::string path, std::uint32_t interval_frames)
+        : path_(std::move(path)), interval_frames_(std::max<std::uint32_t>(interval_frames, 1))
+    {
+        file_.open(path_, std::ios::out | std::ios::trunc);
+        if (!file_.is_open()) {
+            throw std::runtime_error("无法创建渲染统计文件: " + path_);
+        }
+        file_ << "frame,scene,camera_x,camera_y,draw_calls,sprites_submitted,sprites_culled,texture_switches,batches,"
+            "clear_ms,scene_render_ms,execute_ms,present_ms\n";
+        spdlog::info("渲染统计每 {} 帧写入 '{}'。", interval_frames_, path_);
+    }
+
+    RenderStatsWriter::~RenderStatsWriter() {
+        file_.flush();
+        spdlog::info("渲染统计已写入 '{}'（{} 行）。", path_, rows_written_);
+    }
+
+    void RenderStatsWriter::record(std::uint64_t frame, const RenderStats& stats, std::string_view scene_name, const glm::vec2& camera_position) {
+        if (frames_until_write_ > 0) {
+            --frames_until_write_;
+            return;
+        }
+        frames_until_write_ = interval_frames_ - 1;
+
+        constexpr double NS_TO_MS = 1.0 / 1000000.0;
+        file_ << frame << ',' << scene_name << ',' << camera_position.x << ',' << camera_position.y << ','
+            << stats.draw_calls << ',' << stats.sprites_submitted << ',' << stats.sprites_culled << ','
+            << stats.texture_switches << ',' << stats.batches << ','
+            << static_cast<double>(stats.clear_ns) * NS_TO_MS << ','
+            << static_cast<double>(stats.scene_render_ns) * NS_TO_MS << ','
+            << static_cast<double>(stats.execute_ns) * NS_TO_MS << ','
+            << static_cast<double>(stats.present_ns) * NS_TO_MS << '\n';
+        ++rows_written_;
+    }
+
+} // namespace engine::render
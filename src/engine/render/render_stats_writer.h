@@ -0,0 +1,51 @@
+#pragma once
+#include "render_stats.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <glm/vec2.hpp>
+
+namespace engine::render {
+
+    /**
+     * @brief 把渲染统计按固定帧间隔写入 CSV 文件。
+     *
+     * 每行记录一帧的统计，以及当时的场景名称与相机位置，便于把掉帧对应到具体关卡或镜头位置。
+     * 只在游戏线程上使用。
+     */
+    class RenderStatsWriter final {
+    private:
+        std::ofstream file_;                    ///< @brief 输出文件
+        std::string path_;                      ///< @brief 输出路径
+        std::uint32_t interval_frames_ = 30;    ///< @brief 每隔多少帧写入一行
+        std::uint32_t frames_until_write_ = 0;  ///< @brief 距离下一次写入的帧数
+        std::uint64_t rows_written_ = 0;        ///< @brief 已写入的行数
+
+    public:
+        /**
+         * @brief 构造函数，创建（覆盖）CSV 文件并写入表头。
+         * @param path 输出路径
+         * @param interval_frames 写入间隔（帧），0 视为 1
+         * @throws std::runtime_error 如果无法创建文件
+         */
+        RenderStatsWriter(std::string path, std::uint32_t interval_frames);
+        ~RenderStatsWriter();
+
+        // 禁止拷贝和移动
+        RenderStatsWriter(const RenderStatsWriter&) = delete;
+        RenderStatsWriter& operator=(const RenderStatsWriter&) = delete;
+        RenderStatsWriter(RenderStatsWriter&&) = delete;
+        RenderStatsWriter& operator=(RenderStatsWriter&&) = delete;
+
+        /**
+         * @brief 每帧调用一次，到达间隔时写入一行。
+         * @param frame 帧序号
+         * @param stats 最近完成的一帧的统计
+         * @param scene_name 当前场景名称
+         * @param camera_position 当前相机位置
+         */
+        void record(std::uint64_t frame, const RenderStats& stats, std::string_view scene_name, const glm::vec2& camera_position);
+    };
+
+} // namespace engine::render
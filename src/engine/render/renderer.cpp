@@ -2,7 +2,11 @@
 #include "../resource/resource_manager.h"
 #include "camera.h"
 #include "sprite.h"
+#include "frame_capture.h"
+#include "dynamic_resolution.h"
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept> // For std::runtime_error
 #include <spdlog/spdlog.h>
 
@@ -17,21 +21,21 @@ namespace engine::render {
             throw std::runtime_error("Renderer 构造失败: 提供的 SDL_Renderer 指针为空。");
         }
         if (!resource_manager_) {
-            // ResourceManager 是 drawSprite 所必需的
+            // ResourceManager 是解析纹理与执行绘制命令所必需的
             throw std::runtime_error("Renderer 构造失败: 提供的 ResourceManager 指针为空。");
         }
         setDrawColor(0, 0, 0, 255);
         spdlog::trace("Renderer 构造成功。");
     }
 
-    void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, double angle) {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
-            spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
-            return;
+    void Renderer::drawSprite(const Camera& camera, engine::resource::TextureHandle texture, const glm::vec2& texture_size,
+        const Sprite& sprite, const glm::vec2& position, const glm::vec2& scale, double angle, std::uint8_t layer, std::uint32_t depth) {
+        // 录制阶段只使用预先解析的句柄和尺寸，不加锁、不查找，也不触碰 SDL_Texture（可能运行在游戏线程上）
+        if (texture == 0) {
+            return;     // 解析失败时已经在解析处报告过
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, texture_size);
         if (!src_rect.has_value()) {
             spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
             return;
@@ -50,28 +54,34 @@ namespace engine::render {
             scaled_h
         };
 
-        if (!isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不绘制
-            // spdlog::info("精灵超出视口范围，ID: {}", sprite.getTextureId());
+        if (!isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不提交
+            recordingQueue().addCulled();
             return;
         }
 
-        // 执行绘制(默认旋转中心为精灵的中心点)
-        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-            spdlog::error("渲染旋转纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
-        }
+        // 提交绘制命令(默认旋转中心为精灵的中心点)
+        recordingQueue().submit({ RenderQueue::makeSortKey(layer, depth, texture), texture, src_rect.value(), dest_rect, angle, sprite.isFlipped() });
     }
 
-    void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scroll_factor, const glm::bvec2& repeat, const glm::vec2& scale)
+    void Renderer::drawTexture(const Camera& camera, engine::resource::TextureHandle texture, const SDL_FRect& src_rect,
+        const glm::vec2& position, const glm::vec2& size, std::uint8_t layer, std::uint32_t depth, bool is_flipped)
     {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
-            spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
+        if (texture == 0) {
             return;
         }
+        glm::vec2 position_screen = camera.worldToScreen(position);
+        SDL_FRect dest_rect = { position_screen.x, position_screen.y, size.x, size.y };
+        if (!isRectInViewport(camera, dest_rect)) {
+            recordingQueue().addCulled();
+            return;
+        }
+        recordingQueue().submit({ RenderQueue::makeSortKey(layer, depth, texture), texture, src_rect, dest_rect, 0.0, is_flipped });
+    }
 
-        auto src_rect = getSpriteSrcRect(sprite);
-        if (!src_rect.has_value()) {
-            spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
+    void Renderer::drawParallax(const Camera& camera, engine::resource::TextureHandle texture, const glm::vec2& texture_size,
+        const glm::vec2& position, const glm::vec2& scroll_factor, const glm::bvec2& repeat, const glm::vec2& scale, std::uint8_t layer)
+    {
+        if (texture == 0 || texture_size.x <= 0.0f || texture_size.y <= 0.0f) {
             return;
         }
 
@@ -79,8 +89,11 @@ namespace engine::render {
         glm::vec2 position_screen = camera.worldToScreenWithParallax(position, scroll_factor);
 
         // 计算缩放后的纹理尺寸 
-        float scaled_tex_w = src_rect.value().w * scale.x;
-        float scaled_tex_h = src_rect.value().h * scale.y;
+        float scaled_tex_w = texture_size.x * scale.x;
+        float scaled_tex_h = texture_size.y * scale.y;
+        if (scaled_tex_w <= 0.0f || scaled_tex_h <= 0.0f) {
+            return;
+        }
 
         glm::vec2 start, stop;
         glm::vec2 viewport_size = camera.getViewportSize();
@@ -102,26 +115,43 @@ namespace engine::render {
             start.y = position_screen.y;
             stop.y = glm::min(position_screen.y + scaled_tex_h, viewport_size.y); // 结束点是一个纹理高度之后，但不超过视口高度
         }
+        if (stop.x <= start.x || stop.y <= start.y) {
+            return; // 完全在视口之外
+        }
+
+        SDL_FRect src_rect = { 0.0f, 0.0f, texture_size.x, texture_size.y };
+        auto sort_key = RenderQueue::makeSortKey(layer, 0, texture);
+        if (scale.x == scale.y) {
+            // 平铺从目标矩形左上角开始，因此一条命令即可覆盖整个可见区域
+            RenderCommand command;
+            command.sort_key = sort_key;
+            command.texture = texture;
+            command.src_rect = src_rect;
+            command.dst_rect = { start.x, start.y, stop.x - start.x, stop.y - start.y };
+            command.type = RenderCommandType::TILED;
+            command.tile_scale = scale.x;
+            recordingQueue().submit(command);
+            return;
+        }
 
+        // 非等比缩放无法用 SDL_RenderTextureTiled 表达，退回逐块提交（同一排序键，保持提交顺序）
         for (float y = start.y; y < stop.y; y += scaled_tex_h) {
             for (float x = start.x; x < stop.x; x += scaled_tex_w) {
                 SDL_FRect dest_rect = { x, y, scaled_tex_w, scaled_tex_h };
-                if (!SDL_RenderTexture(renderer_, texture, nullptr, &dest_rect)) {
-                    spdlog::error("渲染视差纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
-                    return;
-                }
+                recordingQueue().submit({ sort_key, texture, src_rect, dest_rect, 0.0, false });
             }
         }
     }
 
     void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size) {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
+        // 录制阶段只使用句柄和尺寸，不触碰 SDL_Texture（可能运行在游戏线程上）
+        auto handle = resource_manager_->getTextureHandle(sprite.getTextureId());
+        if (handle == 0) {
             spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
             return;
         }
 
-        auto src_rect = getSpriteSrcRect(sprite);
+        auto src_rect = getSpriteSrcRect(sprite, resource_manager_->getTextureSizeByHandle(handle));
         if (!src_rect.has_value()) {
             spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
             return;
@@ -137,10 +167,93 @@ namespace engine::render {
             dest_rect.h = src_rect.value().h;
         }
 
-        // 执行绘制(未考虑UI旋转)
-        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-            spdlog::error("渲染 UI Sprite 失败 (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+        // 提交到 UI 层级(未考虑UI旋转)
+        recordingQueue().submit({ RenderQueue::makeSortKey(render_layer::UI, 0, handle), handle, src_rect.value(), dest_rect, 0.0, sprite.isFlipped() });
+    }
+
+    void Renderer::drawUITexture(engine::resource::TextureHandle texture, const SDL_FRect& src_rect, const glm::vec2& position,
+        const glm::vec2& size, const SDL_Color& color, std::uint8_t layer) {
+        if (texture == 0) {
+            return;
+        }
+        RenderCommand command;
+        command.sort_key = RenderQueue::makeSortKey(layer, 0, texture);
+        command.texture = texture;
+        command.src_rect = src_rect;
+        command.dst_rect = { position.x, position.y, size.x, size.y };
+        command.color = color;
+        recordingQueue().submit(command);
+    }
+
+    void Renderer::flushRenderQueue() {
+        executeQueue(recordingQueue());
+    }
+
+    void Renderer::executeQueue(RenderQueue& queue) {
+        Uint64 start = SDL_GetTicksNS();
+        if (dynamic_resolution_ && dynamic_resolution_->beginScene(renderer_)) {
+            // UI 以下的层级绘制到降低分辨率的目标中，放大后再以原生分辨率绘制 UI
+            queue.execute(renderer_, *resource_manager_, render_layer::UI, [this] { dynamic_resolution_->endScene(renderer_); });
+        }
+        else {
+            queue.execute(renderer_, *resource_manager_);
+        }
+        frame_stats_ = queue.takeStats();
+        frame_stats_.execute_ns = SDL_GetTicksNS() - start;
+        frame_stats_.clear_ns = clear_ns_;
+    }
+
+    RenderStats Renderer::getLastFrameStats() const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return last_stats_;
+    }
+
+    void Renderer::submitFrame() {
+        std::unique_lock<std::mutex> lock(exchange_mutex_);
+        // 等待渲染线程取走并执行完上一帧，另一个队列才能用于录制
+        exchange_cv_.wait(lock, [this] { return (pending_index_ < 0 && !is_executing_) || is_exchange_stopped_; });
+        if (is_exchange_stopped_) {
+            recordingQueue().clear();
+            recordingQueue().takeStats();
+            return;
+        }
+        pending_index_ = recording_index_;
+        recording_index_ = 1 - recording_index_;
+        lock.unlock();
+        exchange_cv_.notify_all();
+    }
+
+    bool Renderer::renderSubmittedFrame(std::chrono::milliseconds timeout) {
+        int index = -1;
+        {
+            std::unique_lock<std::mutex> lock(exchange_mutex_);
+            if (!exchange_cv_.wait_for(lock, timeout, [this] { return pending_index_ >= 0 || is_exchange_stopped_; }) ||
+                pending_index_ < 0) {
+                return false;
+            }
+            index = pending_index_;
+            pending_index_ = -1;
+            is_executing_ = true;
+        }
+
+        clearScreen();
+        executeQueue(render_queues_[index]);
+        {
+            std::lock_guard<std::mutex> lock(exchange_mutex_);
+            is_executing_ = false;
+        }
+        // 队列已经执行完毕，游戏线程可以开始复用它，呈现（可能被 VSync 阻塞）与下一帧的模拟重叠
+        exchange_cv_.notify_all();
+        present();
+        return true;
+    }
+
+    void Renderer::stopFrameExchange() {
+        {
+            std::lock_guard<std::mutex> lock(exchange_mutex_);
+            is_exchange_stopped_ = true;
         }
+        exchange_cv_.notify_all();
     }
 
     void Renderer::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
@@ -157,24 +270,36 @@ namespace engine::render {
     }
 
     void Renderer::clearScreen() {
+        Uint64 start = SDL_GetTicksNS();
+        if (frame_capture_) {
+            frame_capture_->beginFrame(renderer_);  // 截帧开启时，本帧绘制到截帧渲染目标中
+        }
         if (!SDL_RenderClear(renderer_)) {
             spdlog::error("清除渲染器失败：{}", SDL_GetError());
         }
+        clear_ns_ = SDL_GetTicksNS() - start;
     }
 
     void Renderer::present()
     {
+        Uint64 start = SDL_GetTicksNS();
+        if (frame_capture_) {
+            frame_capture_->endFrame(renderer_);
+        }
         SDL_RenderPresent(renderer_);
+        frame_stats_.present_ns = SDL_GetTicksNS() - start;
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            last_stats_ = frame_stats_;
+        }
+        frame_stats_ = {};
+        if (dynamic_resolution_) {
+            dynamic_resolution_->recordFrame();
+        }
     }
 
-    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite)
+    std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite, const glm::vec2& texture_size)
     {
-        SDL_Texture* texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture) {
-            spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
-            return std::nullopt;
-        }
-
         auto src_rect = sprite.getSourceRect();
         if (src_rect.has_value()) {     // 如果Sprite中存在指定rect，则判断尺寸是否有效
             if (src_rect.value().w <= 0 || src_rect.value().h <= 0) {
@@ -184,14 +309,55 @@ namespace engine::render {
             return src_rect;
         }
         else {                        // 否则获取纹理尺寸并返回整个纹理大小
-            SDL_FRect result = { 0, 0, 0, 0 };
-            if (!SDL_GetTextureSize(texture, &result.w, &result.h)) {
+            if (texture_size.x <= 0 || texture_size.y <= 0) {
                 spdlog::error("无法获取纹理尺寸，ID: {}", sprite.getTextureId());
                 return std::nullopt;
             }
-            return result;
+            return SDL_FRect{ 0, 0, texture_size.x, texture_size.y };
+        }
+    }
+
+#if ENGINE_DEBUG_DRAW
+    void Renderer::debugLine(const Camera& camera, const glm::vec2& start, const glm::vec2& end, const SDL_FColor& color) {
+        const glm::vec2 a = camera.worldToScreen(start);
+        const glm::vec2 b = camera.worldToScreen(end);
+        const SDL_FRect bounds = { std::min(a.x, b.x), std::min(a.y, b.y), std::abs(b.x - a.x), std::abs(b.y - a.y) };
+        if (isRectInViewport(camera, bounds)) {
+            recordingQueue().getDebugDraw().addLine(a, b, color);
+        }
+    }
+
+    void Renderer::debugRect(const Camera& camera, const engine::utils::Rect& rect, const SDL_FColor& color, bool is_filled) {
+        const glm::vec2 position = camera.worldToScreen(rect.position);
+        const SDL_FRect screen_rect = { position.x, position.y, rect.size.x, rect.size.y };
+        if (!isRectInViewport(camera, screen_rect)) {
+            return;
+        }
+        auto& debug_draw = recordingQueue().getDebugDraw();
+        if (is_filled) {
+            debug_draw.addFilledRect(screen_rect, color);
+        }
+        else {
+            debug_draw.addRect(screen_rect, color);
+        }
+    }
+
+    void Renderer::debugCircle(const Camera& camera, const glm::vec2& center, float radius, const SDL_FColor& color) {
+        constexpr int SEGMENTS = 16;
+        const glm::vec2 screen_center = camera.worldToScreen(center);
+        if (!isRectInViewport(camera, { screen_center.x - radius, screen_center.y - radius, radius * 2.0f, radius * 2.0f })) {
+            return;
+        }
+        auto& debug_draw = recordingQueue().getDebugDraw();
+        glm::vec2 previous = screen_center + glm::vec2(radius, 0.0f);
+        for (int i = 1; i <= SEGMENTS; ++i) {
+            const float angle = 6.2831853f * static_cast<float>(i) / SEGMENTS;
+            const glm::vec2 point = screen_center + glm::vec2(std::cos(angle), std::sin(angle)) * radius;
+            debug_draw.addLine(previous, point, color);
+            previous = point;
         }
     }
+#endif
 
     bool Renderer::isRectInViewport(const Camera& camera, const SDL_FRect& rect)
     {
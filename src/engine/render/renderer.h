@@ -1,5 +1,12 @@
 #pragma once
 #include "sprite.h"
+#include "render_queue.h"
+#include "../utils/math.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <optional> // For std::optional
 #include <glm/glm.hpp>
@@ -13,11 +20,18 @@ namespace engine::resource {
 
 namespace engine::render {
     class Camera;
+    class FrameCapture;
+    class DynamicResolution;
 
     /**
      * @brief 封装 SDL3 渲染操作
      *
      * 包装 SDL_Renderer 并提供清除屏幕、绘制精灵和呈现最终图像的方法。
+     * draw* 系列方法只向内部的 RenderQueue 提交命令，实际绘制在 flushRenderQueue() 中按排序键统一执行。
+     *
+     * 渲染线程模式下使用两个命令队列：游戏线程向其中一个录制下一帧（submitFrame() 交出），
+     * 渲染线程（拥有 SDL_Renderer）同时执行另一个（renderSubmittedFrame()）。
+     * 命令在录制时已完成相机变换，因此渲染线程不会访问任何游戏对象。
      * 在构造时初始化。依赖于一个有效的 SDL_Renderer 和 ResourceManager。
      * 构造失败会抛出异常。
      */
@@ -25,6 +39,26 @@ namespace engine::render {
     private:
         SDL_Renderer* renderer_ = nullptr;                              ///< @brief 指向 SDL_Renderer 的非拥有指针
         engine::resource::ResourceManager* resource_manager_ = nullptr; ///< @brief 指向 ResourceManager 的非拥有指针
+        FrameCapture* frame_capture_ = nullptr;                         ///< @brief 截帧（可选，非拥有），在清屏与呈现时介入
+        DynamicResolution* dynamic_resolution_ = nullptr;               ///< @brief 动态分辨率（可选，非拥有），场景层级绘制到降低分辨率的目标
+
+        // --- 双缓冲命令队列 ---
+        std::array<RenderQueue, 2> render_queues_;                      ///< @brief 两个命令队列，一个录制，一个执行
+        int recording_index_ = 0;                                       ///< @brief 游戏线程正在录制的队列下标
+        int pending_index_ = -1;                                        ///< @brief 已提交、等待渲染线程执行的队列下标（-1 表示无）
+        bool is_executing_ = false;                                     ///< @brief 渲染线程是否正在执行某个队列
+        bool is_exchange_stopped_ = false;                              ///< @brief 帧交换是否已停止（退出时唤醒所有等待）
+        std::mutex exchange_mutex_;                                     ///< @brief 保护帧交换状态
+        std::condition_variable exchange_cv_;                           ///< @brief 帧交换状态变化通知
+
+        // --- 渲染统计 ---
+        RenderStats frame_stats_;                                       ///< @brief （渲染线程）正在执行的这一帧的统计
+        Uint64 clear_ns_ = 0;                                           ///< @brief （渲染线程）本帧清屏耗时
+        RenderStats last_stats_;                                        ///< @brief 最近完成的一帧的统计
+        mutable std::mutex stats_mutex_;                                ///< @brief 保护 last_stats_
+#if ENGINE_DEBUG_DRAW
+        bool is_debug_draw_enabled_ = false;                            ///< @brief （游戏线程）是否录制调试图形
+#endif
 
     public:
         /**
@@ -39,24 +73,54 @@ namespace engine::render {
         /**
          * @brief 绘制一个精灵
          *
-         * @param sprite 包含纹理ID、源矩形和翻转状态的 Sprite 对象。
+         * 纹理句柄与尺寸由调用方预先解析并缓存（见 SpriteComponent::init、Sprite::getTextureHandle），这里不做任何查找。
+         *
+         * @param texture 纹理句柄。
+         * @param texture_size 纹理尺寸（像素），仅在精灵没有源矩形时使用。
+         * @param sprite 包含源矩形和翻转状态的 Sprite 对象。
          * @param position 世界坐标中的左上角位置。
          * @param scale 缩放因子。
          * @param angle 旋转角度（度）。
+         * @param layer 渲染层级，决定绘制先后。
+         * @param depth 同一层级内的深度（24 位），数值小的先绘制。
+         */
+        void drawSprite(const Camera& camera, engine::resource::TextureHandle texture, const glm::vec2& texture_size,
+            const Sprite& sprite, const glm::vec2& position,
+            const glm::vec2& scale = { 1.0f, 1.0f }, double angle = 0.0f,
+            std::uint8_t layer = render_layer::DEFAULT, std::uint32_t depth = 0);
+
+        /**
+         * @brief 使用已解析的纹理句柄绘制纹理的一部分（无需按纹理 ID 查找，适合大量同类对象）
+         *
+         * @param texture 纹理句柄。
+         * @param src_rect 纹理上的源矩形。
+         * @param position 世界坐标中的左上角位置。
+         * @param size 绘制尺寸（世界单位）。
+         * @param layer 渲染层级，决定绘制先后。
+         * @param depth 同一层级内的深度（24 位）。
+         * @param is_flipped 是否水平翻转。
          */
-        void drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position,
-            const glm::vec2& scale = { 1.0f, 1.0f }, double angle = 0.0f);
+        void drawTexture(const Camera& camera, engine::resource::TextureHandle texture, const SDL_FRect& src_rect,
+            const glm::vec2& position, const glm::vec2& size, std::uint8_t layer = render_layer::DEFAULT,
+            std::uint32_t depth = 0, bool is_flipped = false);
 
         /**
          * @brief 绘制视差滚动背景
          *
-         * @param sprite 包含纹理ID、源矩形和翻转状态的 Sprite 对象。
+         * 整个视差层只提交一条 TILED 命令（SDL_RenderTextureTiled），与视口大小和重复次数无关。
+         * 纹理句柄与尺寸由调用方预先解析（见 ParallaxComponent::init），这里不做任何查找。
+         *
+         * @param texture 纹理句柄。
+         * @param texture_size 纹理尺寸（像素）。
          * @param position 世界坐标。
          * @param scroll_factor 滚动因子。
+         * @param repeat 是否沿 X/Y 轴重复。
          * @param scale 缩放因子。
+         * @param layer 渲染层级，决定绘制先后。
          */
-        void drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position,
-            const glm::vec2& scroll_factor, const glm::bvec2& repeat = { true, true }, const glm::vec2& scale = { 1.0f, 1.0f });
+        void drawParallax(const Camera& camera, engine::resource::TextureHandle texture, const glm::vec2& texture_size,
+            const glm::vec2& position, const glm::vec2& scroll_factor, const glm::bvec2& repeat = { true, true },
+            const glm::vec2& scale = { 1.0f, 1.0f }, std::uint8_t layer = render_layer::MAP_BASE);
 
         /**
          * @brief 在屏幕坐标中直接渲染一个用于UI的Sprite对象。
@@ -67,7 +131,55 @@ namespace engine::render {
          */
         void drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size = std::nullopt);
 
+        /**
+         * @brief 在屏幕坐标中使用纹理句柄绘制纹理的一部分（文字字形等）。
+         *
+         * @param texture 纹理句柄。
+         * @param src_rect 纹理上的源矩形。
+         * @param position 屏幕坐标中的左上角位置。
+         * @param size 绘制尺寸。
+         * @param color 颜色调制，默认为白色（不调制）。
+         * @param layer 渲染层级，默认为 UI。
+         */
+        void drawUITexture(engine::resource::TextureHandle texture, const SDL_FRect& src_rect, const glm::vec2& position,
+            const glm::vec2& size, const SDL_Color& color = { 255, 255, 255, 255 }, std::uint8_t layer = render_layer::UI);
+
+
+#if ENGINE_DEBUG_DRAW
+        /**
+         * @brief 录制一条世界坐标中的调试线段（只在调试绘制开启时调用，见 isDebugDrawEnabled()）。
+         */
+        void debugLine(const Camera& camera, const glm::vec2& start, const glm::vec2& end, const SDL_FColor& color);
+
+        /**
+         * @brief 录制一个世界坐标中的调试矩形，完全在视口外时跳过。
+         * @param is_filled true 为填充矩形，false 为 1 像素边框
+         */
+        void debugRect(const Camera& camera, const engine::utils::Rect& rect, const SDL_FColor& color, bool is_filled = false);
+
+        void debugCircle(const Camera& camera, const glm::vec2& center, float radius, const SDL_FColor& color);   ///< @brief 录制一个调试圆（16 段折线）
+
+        void toggleDebugDraw() { is_debug_draw_enabled_ = !is_debug_draw_enabled_; }      ///< @brief 切换调试绘制
+        bool isDebugDrawEnabled() const { return is_debug_draw_enabled_; }                  ///< @brief 调试绘制是否开启
+#endif
+
+        void flushRenderQueue();                                            ///< @brief 排序并执行本帧提交的所有渲染命令，需在 present() 之前调用（单线程模式）
+
+        /**
+         * @brief （游戏线程）交出录制完成的一帧，并切换到另一个队列继续录制。
+         *
+         * 如果渲染线程还没有执行完上一帧，会阻塞等待，因此游戏线程最多领先渲染线程一帧。
+         */
+        void submitFrame();
+
+        /**
+         * @brief （渲染线程）等待游戏线程提交的一帧，清屏、执行并呈现。
+         * @param timeout 最长等待时间，超时返回 false，便于渲染线程继续处理窗口事件。
+         * @return 是否渲染了一帧
+         */
+        bool renderSubmittedFrame(std::chrono::milliseconds timeout);
 
+        void stopFrameExchange();                                           ///< @brief 停止帧交换，唤醒所有等待中的线程（退出时调用）
         void present();                                                     ///< @brief 更新屏幕，包装 SDL_RenderPresent 函数
         void clearScreen();                                                 ///< @brief 清屏，包装 SDL_RenderClear 函数
 
@@ -75,6 +187,11 @@ namespace engine::render {
         void setDrawColorFloat(float r, float g, float b, float a = 1.0f);  ///< @brief 设置绘制颜色，包装 SDL_SetRenderDrawColorFloat 函数，使用 float 类型
 
         SDL_Renderer* getSDLRenderer() const { return renderer_; }          ///< @brief 获取底层的 SDL_Renderer 指针
+        RenderStats getLastFrameStats() const;                              ///< @brief 获取最近完成（已呈现）的一帧的统计，任意线程可调用
+        void addCulledSprites(std::uint32_t count) { recordingQueue().addCulled(count); }  ///< @brief （游戏线程）记录场景中被裁剪的对象
+        void addSceneRenderTime(Uint64 ns) { recordingQueue().addSceneRenderTime(ns); }    ///< @brief （游戏线程）记录 Scene::render 的耗时
+        void setFrameCapture(FrameCapture* frame_capture) { frame_capture_ = frame_capture; }  ///< @brief 设置截帧模块（nullptr 表示不使用）
+        void setDynamicResolution(DynamicResolution* dynamic_resolution) { dynamic_resolution_ = dynamic_resolution; }  ///< @brief 设置动态分辨率（nullptr 表示不使用）
 
         // 禁用拷贝和移动语义
         Renderer(const Renderer&) = delete;
@@ -83,7 +200,9 @@ namespace engine::render {
         Renderer& operator=(Renderer&&) = delete;
 
     private:
-        std::optional<SDL_FRect> getSpriteSrcRect(const Sprite& sprite);     ///< @brief 获取精灵的源矩形，用于具体绘制。出现错误则返回std::nullopt并跳过绘制
+        std::optional<SDL_FRect> getSpriteSrcRect(const Sprite& sprite, const glm::vec2& texture_size);  ///< @brief 获取精灵的源矩形，用于具体绘制。出现错误则返回std::nullopt并跳过绘制
+        RenderQueue& recordingQueue() { return render_queues_[recording_index_]; }              ///< @brief 当前录制中的命令队列
+        void executeQueue(RenderQueue& queue);                                                  ///< @brief 执行命令队列（启用动态分辨率时场景与 UI 分开绘制）
         bool isRectInViewport(const Camera& camera, const SDL_FRect& rect);  ///< @brief 判断矩形是否在视口中，用于视口裁剪
 
     };
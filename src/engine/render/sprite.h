@@ -1,4 +1,5 @@
 #pragma once
+#include "../resource/resource_manager.h"   // 用于 TextureHandle
 #include <SDL3/SDL_rect.h>   // 用于 SDL_FRect
 #include <optional>          // 用于 std::optional 表示可选的源矩形
 #include <string>
@@ -9,6 +10,8 @@ namespace engine::render {
      * @brief 表示要绘制的视觉精灵的数据。
      *
      * 包含纹理标识符、要绘制的纹理部分（源矩形）以及翻转状态。
+     * 纹理句柄由持有者在加载时解析一次并缓存（见 SpriteComponent::init、LevelLoader 的构建阶段），
+     * 每帧绘制时直接使用句柄，不再按纹理 ID 查找。
      * 位置、缩放和旋转由外部（例如 SpriteComponent）标识。
      * 渲染工作由 Renderer 类完成。（传入Sprite作为参数）
      */
@@ -17,6 +20,7 @@ namespace engine::render {
         std::string texture_id_;                      ///< @brief 纹理资源的标识符
         std::optional<SDL_FRect> source_rect_;        ///< @brief 可选：要绘制的纹理部分
         bool is_flipped_ = false;                     ///< @brief 是否水平翻转
+        engine::resource::TextureHandle texture_handle_ = 0;    ///< @brief 缓存的纹理句柄（0 表示尚未解析）
 
     public:
         /**
@@ -42,8 +46,10 @@ namespace engine::render {
         const std::string& getTextureId() const { return texture_id_; }                                     ///< @brief 获取纹理 ID
         const std::optional<SDL_FRect>& getSourceRect() const { return source_rect_; }                      ///< @brief 获取源矩形 (如果使用整个纹理则为 std::nullopt)
         bool isFlipped() const { return is_flipped_; }                                                      ///< @brief 获取是否水平翻转
+        engine::resource::TextureHandle getTextureHandle() const { return texture_handle_; }                ///< @brief 获取缓存的纹理句柄（未解析时为 0）
 
-        void setTextureId(const std::string& texture_id) { texture_id_ = texture_id; }                      ///< @brief 设置纹理 ID
+        void setTextureId(const std::string& texture_id) { texture_id_ = texture_id; texture_handle_ = 0; }  ///< @brief 设置纹理 ID（缓存的句柄随之失效）
+        void setTextureHandle(engine::resource::TextureHandle handle) { texture_handle_ = handle; }         ///< @brief 缓存纹理句柄
         void setSourceRect(const std::optional<SDL_FRect>& source_rect) { source_rect_ = source_rect; }     ///< @brief 设置源矩形 (如果使用整个纹理则为 std::nullopt)
         void setFlipped(bool flipped) { is_flipped_ = flipped; }                                            ///< @brief 设置是否水平翻转
 
@@ -0,0 +1,246 @@
+#include "text_renderer.h"
+#include "renderer.h"
+#include "../resource/resource_manager.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    void TextRenderer::SDLSurfaceDeleter::operator()(SDL_Surface* surface) const {
+        if (surface) {
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    TextRenderer::TextRenderer(Renderer& renderer, engine::resource::ResourceManager& resource_manager)
+        : renderer_(renderer), resource_manager_(resource_manager)
+    {
+        spdlog::trace("TextRenderer 构造成功。");
+    }
+
+    TextRenderer::~TextRenderer() = default;
+
+    void TextRenderer::drawText(std::string_view text, const std::string& font_path, int font_size, const glm::vec2& position,
+        const SDL_Color& color, std::uint8_t layer) {
+        auto* atlas = getAtlas(font_path, font_size);
+        if (!atlas) {
+            return;
+        }
+        layoutText(*atlas, text, scratch_layout_);
+        submitLayout(scratch_layout_, position, color, layer);
+    }
+
+    bool TextRenderer::setStaticText(const std::string& id, std::string_view text, const std::string& font_path, int font_size) {
+        auto& entry = static_texts_[id];
+        if (entry.text == text && entry.font.first == font_path && entry.font.second == font_size && !entry.layout.quads.empty()) {
+            return false;
+        }
+        auto* atlas = getAtlas(font_path, font_size);
+        if (!atlas) {
+            return false;
+        }
+        entry.text = text;
+        entry.font = { font_path, font_size };
+        layoutText(*atlas, text, entry.layout);
+        return true;
+    }
+
+    void TextRenderer::drawStaticText(const std::string& id, const glm::vec2& position, const SDL_Color& color, std::uint8_t layer) {
+        auto it = static_texts_.find(id);
+        if (it == static_texts_.end()) {
+            spdlog::warn("静态文字 '{}' 不存在，请先调用 setStaticText。", id);
+            return;
+        }
+        submitLayout(it->second.layout, position, color, layer);
+    }
+
+    glm::vec2 TextRenderer::getStaticTextSize(const std::string& id) const {
+        auto it = static_texts_.find(id);
+        return it != static_texts_.end() ? it->second.layout.size : glm::vec2(0.0f);
+    }
+
+    glm::vec2 TextRenderer::getTextSize(std::string_view text, const std::string& font_path, int font_size) {
+        auto* atlas = getAtlas(font_path, font_size);
+        if (!atlas) {
+            return glm::vec2(0.0f);
+        }
+        layoutText(*atlas, text, scratch_layout_);
+        return scratch_layout_.size;
+    }
+
+    void TextRenderer::clear() {
+        static_texts_.clear();
+        atlases_.clear();
+        spdlog::debug("TextRenderer 已清空所有字形图集。");
+    }
+
+    TextRenderer::GlyphAtlas* TextRenderer::getAtlas(const std::string& font_path, int font_size) {
+        FontKey key = { font_path, font_size };
+        if (auto it = atlases_.find(key); it != atlases_.end()) {
+            return it->second.get();
+        }
+
+        TTF_Font* font = resource_manager_.getFont(font_path, font_size);
+        if (!font) {
+            spdlog::error("无法为字形图集加载字体: {} ({})", font_path, font_size);
+            return nullptr;
+        }
+        auto atlas = std::make_unique<GlyphAtlas>();
+        atlas->font = font;
+        atlas->name = "glyph_atlas:" + font_path + ":" + std::to_string(font_size);
+        atlas->line_height = static_cast<float>(TTF_GetFontLineSkip(font));
+
+        // 预先光栅化 ASCII 可见字符，一次上传
+        for (char32_t code_point = 32; code_point < 127; ++code_point) {
+            getGlyph(*atlas, code_point);
+        }
+        uploadDirtyPages(*atlas);
+        spdlog::debug("创建字形图集 '{}'，{} 个字形。", atlas->name, atlas->glyphs.size());
+
+        auto* result = atlas.get();
+        atlases_.emplace(std::move(key), std::move(atlas));
+        return result;
+    }
+
+    const TextRenderer::Glyph* TextRenderer::getGlyph(GlyphAtlas& atlas, char32_t code_point) {
+        if (auto it = atlas.glyphs.find(code_point); it != atlas.glyphs.end()) {
+            return &it->second;
+        }
+        Glyph glyph;
+        if (!rasterizeGlyph(atlas, code_point, glyph)) {
+            return nullptr;
+        }
+        return &atlas.glyphs.emplace(code_point, glyph).first->second;
+    }
+
+    bool TextRenderer::rasterizeGlyph(GlyphAtlas& atlas, char32_t code_point, Glyph& glyph) {
+        if (!TTF_FontHasGlyph(atlas.font, code_point)) {
+            spdlog::debug("字体 '{}' 中没有字符 U+{:04X}", atlas.name, static_cast<std::uint32_t>(code_point));
+            return false;
+        }
+        int advance = 0;
+        if (!TTF_GetGlyphMetrics(atlas.font, code_point, nullptr, nullptr, nullptr, nullptr, &advance)) {
+            spdlog::warn("无法获取字符 U+{:04X} 的度量: {}", static_cast<std::uint32_t>(code_point), SDL_GetError());
+            return false;
+        }
+        glyph.advance = static_cast<float>(advance);
+        if (code_point == U' ') {
+            return true;    // 空格只需要步进
+        }
+
+        // 白色光栅化，绘制时通过颜色调制着色
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> glyph_surface(
+            TTF_RenderGlyph_Blended(atlas.font, code_point, SDL_Color{ 255, 255, 255, 255 }));
+        if (!glyph_surface) {
+            spdlog::warn("光栅化字符 U+{:04X} 失败: {}", static_cast<std::uint32_t>(code_point), SDL_GetError());
+            return false;
+        }
+        const int width = glyph_surface->w;
+        const int height = glyph_surface->h;
+        if (width <= 0 || height <= 0) {
+            return true;
+        }
+        if (width > PAGE_SIZE || height > PAGE_SIZE) {
+            spdlog::error("字符 U+{:04X} 尺寸超过图集页大小", static_cast<std::uint32_t>(code_point));
+            return false;
+        }
+
+        // 在最后一页中按行放置，放不下时换行或新开一页（字形之间留 1 像素间隔，避免采样串色）
+        AtlasPage* page = atlas.pages.empty() ? allocatePage(atlas) : &atlas.pages.back();
+        if (page && page->pen_x + width > PAGE_SIZE) {
+            page->pen_x = 0;
+            page->pen_y += page->row_height + 1;
+            page->row_height = 0;
+        }
+        if (page && page->pen_y + height > PAGE_SIZE) {
+            page = allocatePage(atlas);
+        }
+        if (!page) {
+            return false;
+        }
+
+        SDL_Rect dst_rect = { page->pen_x, page->pen_y, width, height };
+        SDL_SetSurfaceBlendMode(glyph_surface.get(), SDL_BLENDMODE_NONE);   // 直接拷贝透明度
+        if (!SDL_BlitSurface(glyph_surface.get(), nullptr, page->surface.get(), &dst_rect)) {
+            spdlog::warn("写入字形图集失败: {}", SDL_GetError());
+            return false;
+        }
+        glyph.page = static_cast<std::uint16_t>(atlas.pages.size() - 1);
+        glyph.src_rect = { static_cast<float>(page->pen_x), static_cast<float>(page->pen_y),
+            static_cast<float>(width), static_cast<float>(height) };
+        page->pen_x += width + 1;
+        page->row_height = std::max(page->row_height, height);
+        page->is_dirty = true;
+        return true;
+    }
+
+    TextRenderer::AtlasPage* TextRenderer::allocatePage(GlyphAtlas& atlas) {
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface(SDL_CreateSurface(PAGE_SIZE, PAGE_SIZE, SDL_PIXELFORMAT_RGBA32));
+        if (!surface) {
+            spdlog::error("无法创建字形图集页: {}", SDL_GetError());
+            return nullptr;
+        }
+        SDL_FillSurfaceRect(surface.get(), nullptr, 0);     // 全透明
+
+        auto& page = atlas.pages.emplace_back();
+        page.surface = std::move(surface);
+        page.texture_key = atlas.name + "#" + std::to_string(atlas.pages.size() - 1);
+        page.is_dirty = true;
+        // 立即注册以分配句柄，排版结果可以直接引用它；内容随后由 uploadDirtyPages 更新
+        page.texture = resource_manager_.setTextureSurface(page.texture_key, SDL_DuplicateSurface(page.surface.get()));
+        return &page;
+    }
+
+    void TextRenderer::layoutText(GlyphAtlas& atlas, std::string_view text, TextLayout& layout) {
+        layout.quads.clear();
+        layout.size = { 0.0f, 0.0f };
+
+        glm::vec2 pen = { 0.0f, 0.0f };
+        const char* cursor = text.data();
+        std::size_t remaining = text.size();
+        while (remaining > 0) {
+            const char32_t code_point = SDL_StepUTF8(&cursor, &remaining);
+            if (code_point == U'\n') {
+                layout.size.x = std::max(layout.size.x, pen.x);
+                pen = { 0.0f, pen.y + atlas.line_height };
+                continue;
+            }
+            const Glyph* glyph = getGlyph(atlas, code_point);
+            if (!glyph) {
+                glyph = getGlyph(atlas, U'?');      // 字体中没有的字符用 '?' 代替
+                if (!glyph) {
+                    continue;
+                }
+            }
+            if (glyph->src_rect.w > 0.0f) {
+                layout.quads.push_back({ atlas.pages[glyph->page].texture, glyph->src_rect, pen });
+            }
+            pen.x += glyph->advance;
+        }
+        layout.size.x = std::max(layout.size.x, pen.x);
+        layout.size.y = text.empty() ? 0.0f : pen.y + atlas.line_height;
+
+        uploadDirtyPages(atlas);    // 新加入的字形需要重新上传（句柄不变）
+    }
+
+    void TextRenderer::uploadDirtyPages(GlyphAtlas& atlas) {
+        for (auto& page : atlas.pages) {
+            if (!page.is_dirty) {
+                continue;
+            }
+            // 提交副本：原图像继续用于追加字形，副本由 ResourceManager 接管并在渲染线程上传
+            page.texture = resource_manager_.setTextureSurface(page.texture_key, SDL_DuplicateSurface(page.surface.get()));
+            page.is_dirty = false;
+        }
+    }
+
+    void TextRenderer::submitLayout(const TextLayout& layout, const glm::vec2& position, const SDL_Color& color, std::uint8_t layer) {
+        for (const auto& quad : layout.quads) {
+            renderer_.drawUITexture(quad.texture, quad.src_rect, position + quad.offset,
+                { quad.src_rect.w, quad.src_rect.h }, color, layer);
+        }
+    }
+
+} // namespace engine::render
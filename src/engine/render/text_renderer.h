@@ -0,0 +1,164 @@
+#pragma once
+#include "render_queue.h"
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/vec2.hpp>
+
+struct SDL_Surface;
+struct TTF_Font;
+
+namespace engine::resource {
+    class ResourceManager;
+}
+
+namespace engine::render {
+    class Renderer;
+
+    /**
+     * @brief 排版后的一个字形：位于哪张图集页、源矩形和相对文字左上角的偏移。
+     */
+    struct GlyphQuad {
+        engine::resource::TextureHandle texture = 0;    ///< @brief 图集页的纹理句柄
+        SDL_FRect src_rect = { 0.0f, 0.0f, 0.0f, 0.0f }; ///< @brief 图集上的源矩形
+        glm::vec2 offset = { 0.0f, 0.0f };              ///< @brief 相对文字左上角的偏移
+    };
+
+    /**
+     * @brief 一段排版完成的文字。
+     */
+    struct TextLayout {
+        std::vector<GlyphQuad> quads;           ///< @brief 需要绘制的字形
+        glm::vec2 size = { 0.0f, 0.0f };        ///< @brief 文字包围盒尺寸
+    };
+
+    /**
+     * @brief 基于字形图集的文字渲染器。
+     *
+     * 每种（字体, 字号）对应一个图集：字形只光栅化一次（ASCII 可见字符在创建图集时预先光栅化，
+     * 其它字符第一次出现时加入），保存在 CPU 端的图集页中，并通过 ResourceManager 作为纹理上传。
+     * 排版只使用缓存的字形度量，绘制时每个字形提交一条 UI 命令，经由渲染队列按纹理聚合执行。
+     *
+     * 对于很少变化的文字（分数、标签等），可以使用静态文字缓存：
+     * setStaticText() 只在内容变化时重新排版，drawStaticText() 直接提交缓存的字形。
+     * 只在游戏线程上使用。
+     */
+    class TextRenderer final {
+    private:
+        using FontKey = std::pair<std::string, int>;    ///< @brief 字体路径 + 字号
+
+        struct FontKeyHash {
+            std::size_t operator()(const FontKey& key) const {
+                return std::hash<std::string>()(key.first) ^ std::hash<int>()(key.second);
+            }
+        };
+
+        struct SDLSurfaceDeleter {
+            void operator()(SDL_Surface* surface) const;
+        };
+
+        /// @brief 缓存的字形度量
+        struct Glyph {
+            std::uint16_t page = 0;                         ///< @brief 所在图集页
+            SDL_FRect src_rect = { 0.0f, 0.0f, 0.0f, 0.0f }; ///< @brief 图集上的源矩形（空字形宽高为 0）
+            float advance = 0.0f;                           ///< @brief 水平步进
+        };
+
+        /// @brief 一张图集页（CPU 端图像 + 纹理句柄），按行（shelf）依次放置字形
+        struct AtlasPage {
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface;   ///< @brief CPU 端图像
+            std::string texture_key;                                    ///< @brief 注册到 ResourceManager 的纹理键
+            engine::resource::TextureHandle texture = 0;                ///< @brief 纹理句柄
+            int pen_x = 0;                                              ///< @brief 当前行的下一个放置位置
+            int pen_y = 0;                                              ///< @brief 当前行的顶部
+            int row_height = 0;                                         ///< @brief 当前行的高度
+            bool is_dirty = false;                                      ///< @brief 是否有新字形尚未上传
+        };
+
+        /// @brief 一种（字体, 字号）的字形图集
+        struct GlyphAtlas {
+            TTF_Font* font = nullptr;                                   ///< @brief 字体（由 ResourceManager 持有）
+            std::string name;                                           ///< @brief 用于生成纹理键
+            float line_height = 0.0f;                                   ///< @brief 行高
+            std::vector<AtlasPage> pages;                               ///< @brief 图集页
+            std::unordered_map<char32_t, Glyph> glyphs;                 ///< @brief 码点 -> 字形
+        };
+
+        /// @brief 静态文字缓存项
+        struct StaticText {
+            std::string text;                   ///< @brief 当前内容
+            FontKey font;                       ///< @brief 使用的字体
+            TextLayout layout;                  ///< @brief 排版结果
+        };
+
+        static constexpr int PAGE_SIZE = 512;   ///< @brief 图集页边长（像素）
+
+        Renderer& renderer_;
+        engine::resource::ResourceManager& resource_manager_;
+        std::unordered_map<FontKey, std::unique_ptr<GlyphAtlas>, FontKeyHash> atlases_;    ///< @brief 字形图集
+        std::unordered_map<std::string, StaticText> static_texts_;                         ///< @brief 静态文字缓存
+        TextLayout scratch_layout_;                                                         ///< @brief drawText 复用的排版缓冲
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param renderer 用于提交绘制命令
+         * @param resource_manager 用于获取字体和注册图集纹理
+         */
+        TextRenderer(Renderer& renderer, engine::resource::ResourceManager& resource_manager);
+        ~TextRenderer();
+
+        // 禁止拷贝和移动
+        TextRenderer(const TextRenderer&) = delete;
+        TextRenderer& operator=(const TextRenderer&) = delete;
+        TextRenderer(TextRenderer&&) = delete;
+        TextRenderer& operator=(TextRenderer&&) = delete;
+
+        /**
+         * @brief 在屏幕坐标中绘制一段文字（每次调用都重新排版，适合经常变化的文字）。
+         * @param text UTF-8 文字，支持 '\n' 换行
+         * @param font_path 字体路径
+         * @param font_size 字号
+         * @param position 屏幕坐标中的左上角位置
+         * @param color 文字颜色
+         * @param layer 渲染层级
+         */
+        void drawText(std::string_view text, const std::string& font_path, int font_size, const glm::vec2& position,
+            const SDL_Color& color = { 255, 255, 255, 255 }, std::uint8_t layer = render_layer::UI);
+
+        /**
+         * @brief 设置静态文字的内容，只有内容或字体变化时才重新排版。
+         * @param id 静态文字的标识
+         * @return 是否重新排版
+         */
+        bool setStaticText(const std::string& id, std::string_view text, const std::string& font_path, int font_size);
+
+        /**
+         * @brief 绘制缓存的静态文字（需先调用 setStaticText）。
+         */
+        void drawStaticText(const std::string& id, const glm::vec2& position,
+            const SDL_Color& color = { 255, 255, 255, 255 }, std::uint8_t layer = render_layer::UI);
+
+        void removeStaticText(const std::string& id) { static_texts_.erase(id); }              ///< @brief 移除静态文字
+        glm::vec2 getStaticTextSize(const std::string& id) const;                               ///< @brief 获取静态文字尺寸，不存在返回 (0, 0)
+        glm::vec2 getTextSize(std::string_view text, const std::string& font_path, int font_size);   ///< @brief 计算文字排版后的尺寸
+
+        void clear();                                                                           ///< @brief 清空所有图集与静态文字
+
+    private:
+        GlyphAtlas* getAtlas(const std::string& font_path, int font_size);     ///< @brief 获取或创建图集，字体加载失败返回 nullptr
+        const Glyph* getGlyph(GlyphAtlas& atlas, char32_t code_point);          ///< @brief 获取字形，首次出现时光栅化
+        bool rasterizeGlyph(GlyphAtlas& atlas, char32_t code_point, Glyph& glyph);  ///< @brief 光栅化字形并放入图集页
+        AtlasPage* allocatePage(GlyphAtlas& atlas);                             ///< @brief 添加一张新的图集页
+        void layoutText(GlyphAtlas& atlas, std::string_view text, TextLayout& layout);  ///< @brief 排版
+        void uploadDirtyPages(GlyphAtlas& atlas);                               ///< @brief 把有新字形的图集页重新提交为纹理
+        void submitLayout(const TextLayout& layout, const glm::vec2& position, const SDL_Color& color, std::uint8_t layer);
+    };
+
+} // namespace engine::render
@@ -0,0 +1,60 @@
+#include "animation_library.h"
+#include "../render/animation.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+
+    AnimationSet::AnimationSet(std::vector<std::unique_ptr<engine::render::Animation>>&& clips)
+        : clips_(std::move(clips))
+    {
+        for (std::size_t i = 0; i < clips_.size(); ++i) {
+            clip_ids_.emplace(clips_[i]->getName(), static_cast<AnimationClipId>(i));
+        }
+    }
+
+    AnimationSet::~AnimationSet() = default;
+
+    AnimationClipId AnimationSet::findClip(const std::string& name) const {
+        if (auto it = clip_ids_.find(name); it != clip_ids_.end()) {
+            return it->second;
+        }
+        return INVALID_ANIMATION_CLIP;
+    }
+
+    std::size_t AnimationSet::getFrameCount() const {
+        std::size_t count = 0;
+        for (const auto& clip : clips_) {
+            count += clip->getFrameCount();
+        }
+        return count;
+    }
+
+    AnimationLibrary::~AnimationLibrary() = default;
+
+    const AnimationSet* AnimationLibrary::findAnimationSet(const std::string& tileset_path, int tile_id) const {
+        if (auto it = sets_.find({ tileset_path, tile_id }); it != sets_.end()) {
+            return it->second.get();
+        }
+        return nullptr;
+    }
+
+    const AnimationSet* AnimationLibrary::addAnimationSet(const std::string& tileset_path, int tile_id,
+        std::vector<std::unique_ptr<engine::render::Animation>>&& clips)
+    {
+        auto key = std::make_pair(tileset_path, tile_id);
+        if (auto it = sets_.find(key); it != sets_.end()) {
+            return it->second.get();
+        }
+        auto set = std::make_unique<AnimationSet>(std::move(clips));
+        spdlog::debug("构建动画剪辑集: '{}' 瓦片 {}（{} 个剪辑，{} 帧）", tileset_path, tile_id, set->getClipCount(), set->getFrameCount());
+        return sets_.emplace(std::move(key), std::move(set)).first->second.get();
+    }
+
+    void AnimationLibrary::clearAnimationSets() {
+        if (!sets_.empty()) {
+            spdlog::debug("正在清除所有 {} 个动画剪辑集。", sets_.size());
+            sets_.clear();
+        }
+    }
+
+} // namespace engine::resource
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::render {
+    class Animation;
+}
+
+namespace engine::resource {
+
+    using AnimationClipId = std::uint16_t;                          ///< @brief 剪辑在 AnimationSet 中的编号
+    inline constexpr AnimationClipId INVALID_ANIMATION_CLIP = 0xFFFF; ///< @brief 无效剪辑编号
+
+    /**
+     * @brief 一组不可变的动画剪辑（同一个瓦片定义的全部动画）。
+     *
+     * 由 AnimationLibrary 持有并在多个对象间共享，
+     * AnimationComponent 只保存指向它的指针和当前剪辑编号。
+     */
+    class AnimationSet final {
+    private:
+        std::vector<std::unique_ptr<engine::render::Animation>> clips_;     ///< @brief 剪辑（下标即剪辑编号）
+        std::unordered_map<std::string, AnimationClipId> clip_ids_;         ///< @brief 剪辑名称 -> 编号
+
+    public:
+        explicit AnimationSet(std::vector<std::unique_ptr<engine::render::Animation>>&& clips);
+        ~AnimationSet();
+
+        // 禁止拷贝和移动
+        AnimationSet(const AnimationSet&) = delete;
+        AnimationSet& operator=(const AnimationSet&) = delete;
+        AnimationSet(AnimationSet&&) = delete;
+        AnimationSet& operator=(AnimationSet&&) = delete;
+
+        AnimationClipId findClip(const std::string& name) const;            ///< @brief 根据名称查找剪辑，不存在时返回 INVALID_ANIMATION_CLIP
+        const engine::render::Animation& getClip(AnimationClipId id) const { return *clips_[id]; }   ///< @brief 获取剪辑（编号必须有效）
+        std::size_t getClipCount() const { return clips_.size(); }          ///< @brief 获取剪辑数量
+        std::size_t getFrameCount() const;                                  ///< @brief 获取所有剪辑的帧数之和
+    };
+
+    /**
+     * @brief 共享动画剪辑库。
+     *
+     * 以 (瓦片集路径, 瓦片局部 ID) 为键缓存 AnimationSet。同一瓦片生成的所有对象共享同一组剪辑，
+     * 剪辑只在第一次遇到时构建。使用瓦片集路径而不是 gid，因为 gid 只在单个地图内有意义，
+     * 这样不同关卡引用同一个瓦片集时也能复用。
+     */
+    class AnimationLibrary final {
+        friend class ResourceManager;
+
+    private:
+        std::map<std::pair<std::string, int>, std::unique_ptr<AnimationSet>> sets_;   ///< @brief (瓦片集路径, 瓦片 ID) -> 剪辑集
+
+    public:
+        AnimationLibrary() = default;
+        ~AnimationLibrary();
+
+        // 禁止拷贝和移动
+        AnimationLibrary(const AnimationLibrary&) = delete;
+        AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+        AnimationLibrary(AnimationLibrary&&) = delete;
+        AnimationLibrary& operator=(AnimationLibrary&&) = delete;
+
+    private: // 仅供 ResourceManager 访问的方法
+        const AnimationSet* findAnimationSet(const std::string& tileset_path, int tile_id) const;   ///< @brief 查找剪辑集，不存在返回 nullptr
+        const AnimationSet* addAnimationSet(const std::string& tileset_path, int tile_id,
+            std::vector<std::unique_ptr<engine::render::Animation>>&& clips);                       ///< @brief 添加剪辑集（已存在时返回已有的）
+        std::size_t getAnimationSetCount() const { return sets_.size(); }                           ///< @brief 获取剪辑集数量
+        void clearAnimationSets();                                                                  ///< @brief 清空所有剪辑集
+    };
+
+} // namespace engine::resource
@@ -1,6 +1,8 @@
 #include "audio_manager.h"
+#include "resource_manager.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <chrono>
 
 namespace engine::resource {
 
@@ -40,6 +42,11 @@ namespace engine::resource {
 
     // --- 音效管理 ---
     Mix_Chunk* AudioManager::loadSound(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loadSoundLocked(file_path);
+    }
+
+    Mix_Chunk* AudioManager::loadSoundLocked(const std::string& file_path) {
         // 首先检查缓存
         auto it = sounds_.find(file_path);
         if (it != sounds_.end()) {
@@ -48,7 +55,10 @@ namespace engine::resource {
 
         // 加载音效块
         spdlog::debug("加载音效: {}", file_path);
+        auto load_start = std::chrono::steady_clock::now();
         Mix_Chunk* raw_chunk = Mix_LoadWAV(file_path.c_str());
+        ++load_count_;
+        load_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count();
         if (!raw_chunk) {
             spdlog::error("加载音效失败: '{}': {}", file_path, SDL_GetError());
             return nullptr;
@@ -61,15 +71,37 @@ namespace engine::resource {
     }
 
     Mix_Chunk* AudioManager::getSound(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = sounds_.find(file_path);
         if (it != sounds_.end()) {
             return it->second.get();
         }
         spdlog::warn("音效 '{}' 未找到缓存，尝试加载。", file_path);
-        return loadSound(file_path);
+        return loadSoundLocked(file_path);
+    }
+
+    bool AudioManager::preloadSound(const std::string& file_path) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (sounds_.contains(file_path)) {
+                return true;
+            }
+        }
+        // 解码在锁外进行，不阻塞游戏线程播放其它音效
+        std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter> chunk(Mix_LoadWAV(file_path.c_str()));
+        if (!chunk) {
+            spdlog::error("预加载音效失败: '{}': {}", file_path, SDL_GetError());
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (sounds_.emplace(file_path, std::move(chunk)).second) {     // 解码期间已被加载时丢弃这一份
+            spdlog::debug("成功预加载音效: {}", file_path);
+        }
+        return true;
     }
 
     void AudioManager::unloadSound(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = sounds_.find(file_path);
         if (it != sounds_.end()) {
             spdlog::debug("卸载音效: {}", file_path);
@@ -81,6 +113,7 @@ namespace engine::resource {
     }
 
     void AudioManager::clearSounds() {
+        std::lock_guard<std::mutex> lock(mutex_);
         if (!sounds_.empty()) {
             spdlog::debug("正在清除所有 {} 个缓存的音效。", sounds_.size());
             sounds_.clear(); // unique_ptr处理删除
@@ -89,6 +122,11 @@ namespace engine::resource {
 
     // --- 音乐管理 ---
     Mix_Music* AudioManager::loadMusic(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loadMusicLocked(file_path);
+    }
+
+    Mix_Music* AudioManager::loadMusicLocked(const std::string& file_path) {
         // 首先检查缓存
         auto it = music_.find(file_path);
         if (it != music_.end()) {
@@ -97,7 +135,10 @@ namespace engine::resource {
 
         // 加载音乐
         spdlog::debug("加载音乐: {}", file_path);
+        auto load_start = std::chrono::steady_clock::now();
         Mix_Music* raw_music = Mix_LoadMUS(file_path.c_str());
+        ++load_count_;
+        load_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count();
         if (!raw_music) {
             spdlog::error("加载音乐失败: '{}': {}", file_path, SDL_GetError());
             return nullptr;
@@ -110,15 +151,17 @@ namespace engine::resource {
     }
 
     Mix_Music* AudioManager::getMusic(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = music_.find(file_path);
         if (it != music_.end()) {
             return it->second.get();
         }
         spdlog::warn("音乐 '{}' 未找到缓存，尝试加载。", file_path);
-        return loadMusic(file_path);
+        return loadMusicLocked(file_path);
     }
 
     void AudioManager::unloadMusic(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = music_.find(file_path);
         if (it != music_.end()) {
             spdlog::debug("卸载音乐: {}", file_path);
@@ -130,6 +173,7 @@ namespace engine::resource {
     }
 
     void AudioManager::clearMusic() {
+        std::lock_guard<std::mutex> lock(mutex_);
         if (!music_.empty()) {
             spdlog::debug("正在清除所有 {} 个缓存的音乐曲目。", music_.size());
             music_.clear(); // unique_ptr处理删除
@@ -142,4 +186,10 @@ namespace engine::resource {
         clearMusic();
     }
 
+    ResourceLoadStats AudioManager::getLoadStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return { load_count_, load_ms_ };
+    }
+
 } // namespace engine::resource
\ No newline at end of file
@@ -3,16 +3,19 @@
 #include <stdexcept>    // 用于 std::runtime_error
 #include <string>       // 用于 std::string
 #include <unordered_map> // 用于 std::unordered_map
+#include <mutex>        // 用于 std::mutex
+#include <cstdint>      // 用于 std::uint64_t
 
 #include <SDL_mixer.h>// SDL_mixer 主头文件
 
 namespace engine::resource {
+    struct ResourceLoadStats;
 
     /**
      * @brief 管理 SDL_mixer 音效 (Mix_Chunk) 和音乐 (Mix_Music)。
      *
      * 提供音频资源的加载和缓存功能。构造失败时会抛出异常。
-     * 仅供 ResourceManager 内部使用。
+     * 仅供 ResourceManager 内部使用。缓存受互斥锁保护，preloadSound 可以在后台线程上调用。
      */
     class AudioManager final {
         friend class ResourceManager;
@@ -40,6 +43,9 @@ namespace engine::resource {
         std::unordered_map<std::string, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>> sounds_;
         // 音乐存储 (文件路径 -> Mix_Music)
         std::unordered_map<std::string, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>> music_;
+        std::uint64_t load_count_ = 0;  ///< @brief 同步加载（loadSound/loadMusic 及其缓存未命中）的次数
+        double load_ms_ = 0.0;          ///< @brief 同步加载的累计耗时
+        mutable std::mutex mutex_;      ///< @brief 保护 sounds_、music_ 与统计
 
     public:
         /**
@@ -60,6 +66,7 @@ namespace engine::resource {
 
         Mix_Chunk* loadSound(const std::string& file_path);     ///< @brief 从文件路径加载音效
         Mix_Chunk* getSound(const std::string& file_path);      ///< @brief 尝试获取已加载音效的指针，如果未加载则尝试加载
+        bool preloadSound(const std::string& file_path);        ///< @brief 解码音效并缓存（解码时不持有锁），任意线程可用
         void unloadSound(const std::string& file_path);         ///< @brief 卸载指定的音效资源
         void clearSounds();                                      ///< @brief 清空所有音效资源
 
@@ -69,6 +76,11 @@ namespace engine::resource {
         void clearMusic();                                      ///< @brief 清空所有音乐资源
 
         void clearAudio();                                      ///< @brief 清空所有音频资源
+        ResourceLoadStats getLoadStats() const;                 ///< @brief 同步加载的累计统计（不含 preloadSound）
+
+        // --- 内部辅助函数（调用前必须持有 mutex_） ---
+        Mix_Chunk* loadSoundLocked(const std::string& file_path);
+        Mix_Music* loadMusicLocked(const std::string& file_path);
     };
 
 } // namespace
\ No newline at end of file
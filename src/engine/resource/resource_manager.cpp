@@ -2,6 +2,9 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h" 
+#include "animation_library.h"
+#include "tileset_cache.h"
+#include "../render/animation.h"
 #include <SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h> 
 #include <glm/glm.hpp>
@@ -16,12 +19,16 @@ namespace engine::resource {
         texture_manager_ = std::make_unique<TextureManager>(renderer);
         audio_manager_ = std::make_unique<AudioManager>();
         font_manager_ = std::make_unique<FontManager>();
+        animation_library_ = std::make_unique<AnimationLibrary>();
+        tileset_cache_ = std::make_unique<TilesetCache>();
 
         spdlog::trace("ResourceManager 构造成功。");
         // RAII: 构造成功即代表资源管理器可以正常工作，无需再初始化，无需检查指针是否为空
     }
 
     void ResourceManager::clear() {
+        tileset_cache_->clearTilesets();
+        animation_library_->clearAnimationSets();
         font_manager_->clearFonts();
         audio_manager_->clearSounds();
         texture_manager_->clearTextures();
@@ -34,6 +41,10 @@ namespace engine::resource {
         return texture_manager_->loadTexture(file_path);
     }
 
+    bool ResourceManager::preloadTexture(const std::string& file_path) {
+        return texture_manager_->preloadTexture(file_path);
+    }
+
     SDL_Texture* ResourceManager::getTexture(const std::string& file_path) {
         return texture_manager_->getTexture(file_path);
     }
@@ -50,6 +61,26 @@ namespace engine::resource {
         texture_manager_->clearTextures();
     }
 
+    TextureHandle ResourceManager::getTextureHandle(const std::string& file_path) {
+        return texture_manager_->getTextureHandle(file_path);
+    }
+
+    SDL_Texture* ResourceManager::getTextureByHandle(TextureHandle handle) {
+        return texture_manager_->getTextureByHandle(handle);
+    }
+
+    glm::vec2 ResourceManager::getTextureSizeByHandle(TextureHandle handle) {
+        return texture_manager_->getTextureSizeByHandle(handle);
+    }
+
+    TextureHandle ResourceManager::setTextureSurface(const std::string& key, SDL_Surface* surface) {
+        return texture_manager_->setTextureSurface(key, surface);
+    }
+
+    ResourceLoadStats ResourceManager::getTextureLoadStats() const {
+        return texture_manager_->getLoadStats();
+    }
+
     // --- 音频接口实现 ---
     Mix_Chunk* ResourceManager::loadSound(const std::string& file_path) {
         return audio_manager_->loadSound(file_path);
@@ -59,6 +90,10 @@ namespace engine::resource {
         return audio_manager_->getSound(file_path);
     }
 
+    bool ResourceManager::preloadSound(const std::string& file_path) {
+        return audio_manager_->preloadSound(file_path);
+    }
+
     void ResourceManager::unloadSound(const std::string& file_path) {
         audio_manager_->unloadSound(file_path);
     }
@@ -83,6 +118,10 @@ namespace engine::resource {
         audio_manager_->clearMusic();
     }
 
+    ResourceLoadStats ResourceManager::getAudioLoadStats() const {
+        return audio_manager_->getLoadStats();
+    }
+
     // --- 字体接口实现 ---
     TTF_Font* ResourceManager::loadFont(const std::string& file_path, int point_size) {
         return font_manager_->loadFont(file_path, point_size);
@@ -100,4 +139,39 @@ namespace engine::resource {
         font_manager_->clearFonts();
     }
 
+    // --- 动画剪辑集接口实现 ---
+    const AnimationSet* ResourceManager::findAnimationSet(const std::string& tileset_path, int tile_id) {
+        return animation_library_->findAnimationSet(tileset_path, tile_id);
+    }
+
+    const AnimationSet* ResourceManager::addAnimationSet(const std::string& tileset_path, int tile_id,
+        std::vector<std::unique_ptr<engine::render::Animation>>&& clips) {
+        return animation_library_->addAnimationSet(tileset_path, tile_id, std::move(clips));
+    }
+
+    std::size_t ResourceManager::getAnimationSetCount() const {
+        return animation_library_->getAnimationSetCount();
+    }
+
+    void ResourceManager::clearAnimationSets() {
+        animation_library_->clearAnimationSets();
+    }
+
+    // --- 图块集接口实现 ---
+    std::shared_ptr<const Tileset> ResourceManager::getTileset(const std::string& file_path) {
+        return tileset_cache_->getTileset(file_path);
+    }
+
+    void ResourceManager::invalidateTileset(const std::string& file_path) {
+        tileset_cache_->invalidateTileset(file_path);
+    }
+
+    std::size_t ResourceManager::getTilesetCount() const {
+        return tileset_cache_->getTilesetCount();
+    }
+
+    void ResourceManager::clearTilesets() {
+        tileset_cache_->clearTilesets();
+    }
+
 } // namespace
\ No newline at end of file
@@ -1,21 +1,41 @@
 #pragma once
+#include <cstdint> // 用于 std::uint32_t
 #include <memory> // 用于 std::unique_ptr
 #include <string> // 用于 std::string
+#include <vector> // 用于 std::vector
 #include <glm/glm.hpp>
 
 // 前向声明 SDL 类型
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Surface;
 struct Mix_Chunk;
 struct Mix_Music;
 struct TTF_Font;
 
+namespace engine::render {
+    class Animation;
+}
+
 namespace engine::resource {
 
+    /// @brief 纹理句柄：纹理在 TextureManager 中的稠密整数编号，0 表示无效句柄
+    using TextureHandle = std::uint32_t;
+
+    /// @brief 同步加载（第一次访问时在调用线程上解码，不含后台预加载）的累计统计
+    struct ResourceLoadStats {
+        std::uint64_t count = 0;    ///< @brief 加载次数
+        double ms = 0.0;            ///< @brief 累计耗时（毫秒）
+    };
+
     // 前向声明内部管理器
     class TextureManager;
     class AudioManager;
     class FontManager;
+    class AnimationLibrary;
+    class AnimationSet;
+    class TilesetCache;
+    class Tileset;
 
     /**
      * @brief 作为访问各种资源管理器的中央控制点（外观模式 Facade）。
@@ -27,6 +47,8 @@ namespace engine::resource {
         std::unique_ptr<TextureManager> texture_manager_;
         std::unique_ptr<AudioManager> audio_manager_;
         std::unique_ptr<FontManager> font_manager_;
+        std::unique_ptr<AnimationLibrary> animation_library_;
+        std::unique_ptr<TilesetCache> tileset_cache_;
 
     public:
         /**
@@ -48,14 +70,21 @@ namespace engine::resource {
         // --- 统一资源访问接口 ---
         // -- Texture --
         SDL_Texture* loadTexture(const std::string& file_path);     ///< @brief 载入纹理资源
+        bool preloadTexture(const std::string& file_path);          ///< @brief 在调用线程上解码纹理，上传推迟到渲染线程第一次使用时（任意线程可用）
         SDL_Texture* getTexture(const std::string& file_path);      ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
         void unloadTexture(const std::string& file_path);          ///< @brief 卸载指定的纹理资源
         glm::vec2 getTextureSize(const std::string& file_path);    ///< @brief 获取指定纹理的尺寸
         void clearTextures();                                      ///< @brief 清空所有纹理资源
+        TextureHandle getTextureHandle(const std::string& file_path);  ///< @brief 获取纹理的整数句柄（首次访问时分配），失败返回 0
+        SDL_Texture* getTextureByHandle(TextureHandle handle);         ///< @brief 通过句柄获取纹理，如果纹理已被卸载则重新加载（仅渲染线程）
+        glm::vec2 getTextureSizeByHandle(TextureHandle handle);        ///< @brief 通过句柄获取纹理尺寸，任意线程可用
+        TextureHandle setTextureSurface(const std::string& key, SDL_Surface* surface);  ///< @brief 用程序生成的图像（接管所有权）创建或替换纹理，句柄保持不变
+        ResourceLoadStats getTextureLoadStats() const;                 ///< @brief 获取纹理首次访问时同步解码/创建的累计统计
 
         // -- Sound Effects (Chunks) --
         Mix_Chunk* loadSound(const std::string& file_path);         ///< @brief 载入音效资源
         Mix_Chunk* getSound(const std::string& file_path);          ///< @brief 尝试获取已加载音效的指针，如果未加载则尝试加载
+        bool preloadSound(const std::string& file_path);            ///< @brief 在调用线程上解码并缓存音效（任意线程可用）
         void unloadSound(const std::string& file_path);             ///< @brief 卸载指定的音效资源
         void clearSounds();                                         ///< @brief 清空所有音效资源
 
@@ -64,12 +93,26 @@ namespace engine::resource {
         Mix_Music* getMusic(const std::string& file_path);          ///< @brief 尝试获取已加载音乐的指针，如果未加载则尝试加载
         void unloadMusic(const std::string& file_path);             ///< @brief 卸载指定的音乐资源
         void clearMusic();                                          ///< @brief 清空所有音乐资源
+        ResourceLoadStats getAudioLoadStats() const;                ///< @brief 获取音效与音乐同步加载的累计统计
 
         // -- Fonts --
         TTF_Font* loadFont(const std::string& file_path, int point_size);     ///< @brief 载入字体资源
         TTF_Font* getFont(const std::string& file_path, int point_size);      ///< @brief 尝试获取已加载字体的指针，如果未加载则尝试加载
         void unloadFont(const std::string& file_path, int point_size);        ///< @brief 卸载指定的字体资源
         void clearFonts();                                                  ///< @brief 清空所有字体资源
+
+        // -- Animation Sets --
+        const AnimationSet* findAnimationSet(const std::string& tileset_path, int tile_id);     ///< @brief 查找共享动画剪辑集，不存在返回 nullptr
+        const AnimationSet* addAnimationSet(const std::string& tileset_path, int tile_id,
+            std::vector<std::unique_ptr<engine::render::Animation>>&& clips);                   ///< @brief 添加共享动画剪辑集（已存在时返回已有的）
+        std::size_t getAnimationSetCount() const;                                               ///< @brief 获取已缓存的动画剪辑集数量
+        void clearAnimationSets();                                                              ///< @brief 清空所有动画剪辑集
+
+        // -- Tilesets --
+        std::shared_ptr<const Tileset> getTileset(const std::string& file_path);    ///< @brief 获取共享图块集，未缓存或文件已修改时加载，失败返回 nullptr（任意线程可用）
+        void invalidateTileset(const std::string& file_path);                       ///< @brief 丢弃缓存的图块集，下次获取时重新加载（用于热重载）
+        std::size_t getTilesetCount() const;                                        ///< @brief 获取已缓存的图块集数量
+        void clearTilesets();                                                       ///< @brief 清空图块集缓存
     };
 
 } // namespace engine::resource
\ No newline at end of file
@@ -1,79 +1,97 @@
 #include "texture_manager.h"
-#include <SDL3_image/SDL_image.h> // 用于 IMG_LoadTexture, IMG_Init, IMG_Quit
+#include "resource_manager.h"
+#include <SDL3_image/SDL_image.h> // 用于 IMG_Load
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <chrono>
 
 namespace engine::resource {
-    TextureManager::TextureManager(SDL_Renderer* renderer) : renderer_(renderer) {
+    TextureManager::TextureManager(SDL_Renderer* renderer) : renderer_(renderer), render_thread_id_(std::this_thread::get_id()) {
         if (!renderer_) {
             // 关键错误，无法继续，抛出异常 （它将由catch语句捕获（位于GameApp），并进行处理）
             throw std::runtime_error("TextureManager 构造失败: 渲染器指针为空。");
         }
+        // 下标 0 保留为无效句柄
+        slots_.emplace_back();
         // SDL3中不再需要手动调用IMG_Init/IMG_Quit
         spdlog::trace("TextureManager 构造成功。");
     }
 
     SDL_Texture* TextureManager::loadTexture(const std::string& file_path) {
-        // 检查是否已加载
-        auto it = textures_.find(file_path);
-        if (it != textures_.end()) {
-            return it->second.get();
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto handle = acquireHandle(lock, file_path);
+        if (handle == 0) {
+            return nullptr;
         }
+        return resolveLocked(slots_[handle]);
+    }
 
-        // 如果没加载则尝试加载纹理
-        SDL_Texture* raw_texture = IMG_LoadTexture(renderer_, file_path.c_str());
-
-        // 载入纹理时，设置纹理缩放模式为最邻近插值(必不可少，否则TileLayer渲染中会出现边缘空隙/模糊)
-        if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
-            spdlog::warn("无法设置纹理缩放模式为最邻近插值");
+    bool TextureManager::preloadTexture(const std::string& file_path) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = handles_.find(file_path); it != handles_.end() && (slots_[it->second].texture || slots_[it->second].pending_surface)) {
+                return true;    // 已加载或已解码
+            }
         }
 
-        if (!raw_texture) {
-            spdlog::error("加载纹理失败: '{}': {}", file_path, SDL_GetError());
-            return nullptr;
+        // 解码可能耗时数毫秒，在锁外进行，不阻塞渲染线程取用其它纹理
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface(IMG_Load(file_path.c_str()));
+        if (!surface) {
+            spdlog::error("预加载纹理失败: '{}': {}", file_path, SDL_GetError());
+            return false;
         }
 
-        // 使用带有自定义删除器的 unique_ptr 存储加载的纹理
-        textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
-        spdlog::debug("成功加载并缓存纹理: {}", file_path);
-
-        return raw_texture;
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::uint32_t handle = 0;
+        if (auto it = handles_.find(file_path); it != handles_.end()) {
+            handle = it->second;
+        }
+        else {
+            handle = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back().file_path = file_path;
+            handles_.emplace(file_path, handle);
+        }
+        auto& slot = slots_[handle];
+        if (slot.texture || slot.pending_surface) {
+            return true;        // 解码期间已被其它线程加载，丢弃这一份
+        }
+        slot.size = { static_cast<float>(surface->w), static_cast<float>(surface->h) };
+        slot.pending_surface = std::move(surface);
+        spdlog::debug("纹理已预加载，等待渲染线程上传: {}", file_path);
+        return true;
     }
 
     SDL_Texture* TextureManager::getTexture(const std::string& file_path) {
+        std::unique_lock<std::mutex> lock(mutex_);
         // 查找现有纹理
-        auto it = textures_.find(file_path);
-        if (it != textures_.end()) {
-            return it->second.get();
+        auto it = handles_.find(file_path);
+        if (it == handles_.end() || (!slots_[it->second].texture && !slots_[it->second].pending_surface)) {
+            // 如果未找到，尝试加载它
+            spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。", file_path);
         }
-
-        // 如果未找到，尝试加载它
-        spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。", file_path);
-        return loadTexture(file_path);
+        auto handle = acquireHandle(lock, file_path);
+        if (handle == 0) {
+            return nullptr;
+        }
+        return resolveLocked(slots_[handle]);
     }
 
     glm::vec2 TextureManager::getTextureSize(const std::string& file_path) {
-        // 获取纹理
-        SDL_Texture* texture = getTexture(file_path);
-        if (!texture) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto handle = acquireHandle(lock, file_path);
+        if (handle == 0) {
             spdlog::error("无法获取纹理: {}", file_path);
             return glm::vec2(0);
         }
-
-        // 获取纹理尺寸
-        glm::vec2 size;
-        if (!SDL_GetTextureSize(texture, &size.x, &size.y)) {
-            spdlog::error("无法查询纹理尺寸: {}", file_path);
-            return glm::vec2(0);
-        }
-        return size;
+        return slots_[handle].size;
     }
 
     void TextureManager::unloadTexture(const std::string& file_path) {
-        auto it = textures_.find(file_path);
-        if (it != textures_.end()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = handles_.find(file_path);
+        if (it != handles_.end() && (slots_[it->second].texture || slots_[it->second].pending_surface)) {
             spdlog::debug("卸载纹理: {}", file_path);
-            textures_.erase(it); // unique_ptr 通过自定义删除器处理删除
+            releaseSlotLocked(slots_[it->second]);
         }
         else {
             spdlog::warn("尝试卸载不存在的纹理: {}", file_path);
@@ -81,10 +99,164 @@ namespace engine::resource {
     }
 
     void TextureManager::clearTextures() {
-        if (!textures_.empty()) {
-            spdlog::debug("正在清除所有 {} 个缓存的纹理。", textures_.size());
-            textures_.clear(); // unique_ptr 处理所有元素的删除
+        std::lock_guard<std::mutex> lock(mutex_);
+        spdlog::debug("正在清除所有 {} 个纹理槽位。", slots_.size() - 1);
+        for (auto& slot : slots_) {
+            releaseSlotLocked(slot);
+        }
+        if (isRenderThread()) {
+            retired_textures_.clear();
+        }
+    }
+
+    std::uint32_t TextureManager::getTextureHandle(const std::string& file_path) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return acquireHandle(lock, file_path);
+    }
+
+    SDL_Texture* TextureManager::getTextureByHandle(std::uint32_t handle) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (handle == 0 || handle >= slots_.size()) {
+            return nullptr;
+        }
+        if (!slots_[handle].texture && !slots_[handle].pending_surface) {
+            // 纹理被卸载过，按路径重新加载
+            if (!decodeSlot(lock, handle)) {
+                return nullptr;
+            }
+        }
+        return resolveLocked(slots_[handle]);
+    }
+
+    glm::vec2 TextureManager::getTextureSizeByHandle(std::uint32_t handle) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (handle == 0 || handle >= slots_.size()) {
+            return glm::vec2(0);
+        }
+        return slots_[handle].size;
+    }
+
+    std::uint32_t TextureManager::setTextureSurface(const std::string& key, SDL_Surface* surface) {
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> owned_surface(surface);
+        if (!owned_surface) {
+            spdlog::error("无法为 '{}' 设置纹理图像：图像为空。", key);
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::uint32_t handle = 0;
+        if (auto it = handles_.find(key); it != handles_.end()) {
+            handle = it->second;
+        }
+        else {
+            handle = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back().file_path = key;
+            handles_.emplace(key, handle);
+        }
+
+        // 旧纹理交给 releaseSlotLocked 处理（非渲染线程上推迟到渲染线程销毁），新图像等待渲染线程上传
+        auto& slot = slots_[handle];
+        releaseSlotLocked(slot);
+        slot.is_generated = true;
+        slot.size = { static_cast<float>(owned_surface->w), static_cast<float>(owned_surface->h) };
+        slot.pending_surface = std::move(owned_surface);
+        return handle;
+    }
+
+    ResourceLoadStats TextureManager::getLoadStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return { load_count_, load_ms_ };
+    }
+
+    std::uint32_t TextureManager::acquireHandle(std::unique_lock<std::mutex>& lock, const std::string& file_path) {
+        std::uint32_t handle = 0;
+        if (auto it = handles_.find(file_path); it != handles_.end()) {
+            handle = it->second;
+            if (slots_[handle].texture || slots_[handle].pending_surface) {
+                return handle;
+            }
+        }
+        else {
+            // 先登记槽位再解码：解码期间其它线程请求同一路径时等待这次解码，而不是重复解码
+            handle = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back().file_path = file_path;
+            handles_.emplace(file_path, handle);
+        }
+        return decodeSlot(lock, handle) ? handle : 0;
+    }
+
+    bool TextureManager::decodeSlot(std::unique_lock<std::mutex>& lock, std::uint32_t handle) {
+        // 其它线程正在解码这个槽位：等待结果
+        decode_cv_.wait(lock, [this, handle] { return !slots_[handle].is_decoding; });
+        if (slots_[handle].texture || slots_[handle].pending_surface) {
+            return true;
+        }
+        if (slots_[handle].is_generated) {
+            // 生成的纹理没有图像文件可以重新加载，需要由生成者重新设置
+            spdlog::warn("生成的纹理 '{}' 已被卸载，无法重新加载。", slots_[handle].file_path);
+            return false;
+        }
+
+        // 解码可能耗时数毫秒，在锁外进行（与 preloadTexture 相同），不阻塞其它线程取用已加载的纹理。
+        // 渲染线程上解码后由 resolveLocked 立即上传，其它线程等待渲染线程第一次使用时上传。
+        slots_[handle].is_decoding = true;
+        const std::string file_path = slots_[handle].file_path;     // 解锁期间 slots_ 可能扩容，不持有引用
+        lock.unlock();
+        auto start_time = std::chrono::steady_clock::now();
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface(IMG_Load(file_path.c_str()));
+        const double decode_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+        lock.lock();
+
+        auto& slot = slots_[handle];
+        slot.is_decoding = false;
+        decode_cv_.notify_all();
+        ++load_count_;
+        load_ms_ += decode_ms;
+        if (!surface) {
+            spdlog::error("加载纹理失败: '{}': {}", file_path, SDL_GetError());
+            return false;
+        }
+        if (slot.texture || slot.pending_surface) {
+            return true;        // 解码期间已被设置（例如 setTextureSurface），丢弃这一份
+        }
+        slot.size = { static_cast<float>(surface->w), static_cast<float>(surface->h) };
+        slot.pending_surface = std::move(surface);
+        spdlog::debug("纹理已解码: {}", file_path);
+        return true;
+    }
+
+    SDL_Texture* TextureManager::resolveLocked(TextureSlot& slot) {
+        if (!isRenderThread()) {
+            return slot.texture.get();  // 可能为空：尚未上传
+        }
+        retired_textures_.clear();      // 渲染线程上顺带销毁其它线程卸载的纹理
+
+        if (!slot.texture && slot.pending_surface) {
+            SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, slot.pending_surface.get());
+            if (!raw_texture) {
+                spdlog::error("上传纹理失败: '{}': {}", slot.file_path, SDL_GetError());
+                return nullptr;
+            }
+            if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+                spdlog::warn("无法设置纹理缩放模式为最邻近插值");
+            }
+            slot.texture.reset(raw_texture);
+            slot.pending_surface.reset();
+            spdlog::debug("渲染线程上传纹理: {}", slot.file_path);
+        }
+        return slot.texture.get();
+    }
+
+    void TextureManager::releaseSlotLocked(TextureSlot& slot) {
+        slot.pending_surface.reset();
+        if (!slot.texture) {
+            return;
+        }
+        if (isRenderThread()) {
+            slot.texture.reset();           // unique_ptr 通过自定义删除器处理删除
+        }
+        else {
+            retired_textures_.push_back(std::move(slot.texture));
         }
     }
 
-} // namespace
\ No newline at end of file
+} // namespace
@@ -3,16 +3,26 @@
 #include <stdexcept>    // 用于 std::runtime_error
 #include <string>       // 用于 std::string
 #include <unordered_map> // 用于 std::unordered_map
+#include <vector>       // 用于 std::vector
+#include <cstdint>      // 用于 std::uint32_t
+#include <mutex>        // 用于 std::mutex
+#include <condition_variable> // 用于 std::condition_variable
+#include <thread>       // 用于 std::thread::id
 #include <SDL3/SDL_render.h> // 用于 SDL_Texture 和 SDL_Renderer
 #include <glm/glm.hpp>
 
 namespace engine::resource {
+    struct ResourceLoadStats;
 
     /**
      * @brief 管理 SDL_Texture 资源的加载、存储和检索。
      *
      * 在构造时初始化。使用文件路径作为键，确保纹理只加载一次并正确释放。
      * 依赖于一个有效的 SDL_Renderer，构造失败会抛出异常。
+     *
+     * 构造 TextureManager 的线程被视为渲染线程，只有它可以创建/销毁 SDL_Texture。
+     * 纹理第一次被请求时在请求线程上、锁外解码为 SDL_Surface 并记录尺寸（不阻塞其它线程取用已加载的纹理），
+     * 真正的上传推迟到渲染线程第一次通过句柄访问该纹理时进行。所有接口都是线程安全的。
      */
     class TextureManager final {
         friend class ResourceManager;
@@ -26,11 +36,37 @@ namespace engine::resource {
                 }
             }
         };
+        // SDL_Surface 的删除器函数对象
+        struct SDLSurfaceDeleter {
+            void operator()(SDL_Surface* surface) const {
+                if (surface) {
+                    SDL_DestroySurface(surface);
+                }
+            }
+        };
 
-        // 存储文件路径和指向管理纹理的 unique_ptr 的映射。
-        std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_;
+        /// @brief 一个纹理槽位，下标即纹理句柄
+        struct TextureSlot {
+            std::string file_path;                                          ///< @brief 纹理文件路径
+            std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;        ///< @brief 已上传的纹理
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> pending_surface;///< @brief 已解码、等待渲染线程上传的图像
+            glm::vec2 size = { 0.0f, 0.0f };                                ///< @brief 纹理尺寸（解码后即可用）
+            bool is_generated = false;                                      ///< @brief 由程序生成（如字形图集），没有对应的图像文件
+            bool is_decoding = false;                                       ///< @brief 某个线程正在锁外解码该槽位
+        };
 
-        SDL_Renderer* renderer_ = nullptr; // 指向主渲染器的非拥有指针
+        // 句柄一经分配在整个运行期内保持不变，卸载纹理只清空对应槽位，再次访问时按路径重新加载。
+        // 下标 0 保留为无效句柄。
+        std::unordered_map<std::string, std::uint32_t> handles_;    ///< @brief 文件路径 -> 句柄
+        std::vector<TextureSlot> slots_;                            ///< @brief 句柄 -> 纹理槽位
+        std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>> retired_textures_; ///< @brief 非渲染线程卸载的纹理，等待渲染线程销毁
+
+        SDL_Renderer* renderer_ = nullptr;          ///< @brief 指向主渲染器的非拥有指针
+        std::thread::id render_thread_id_;          ///< @brief 渲染线程（构造线程）ID
+        std::uint64_t load_count_ = 0;              ///< @brief decodeSlot 的解码次数（首次访问时的同步加载）
+        double load_ms_ = 0.0;                      ///< @brief decodeSlot 的累计解码耗时
+        mutable std::mutex mutex_;                  ///< @brief 保护以上所有容器与统计
+        std::condition_variable decode_cv_;         ///< @brief 槽位解码完成时通知等待同一槽位的线程
 
     public:
         /**
@@ -48,11 +84,28 @@ namespace engine::resource {
 
     private: // 仅供 ResourceManager 访问的方法
 
-        SDL_Texture* loadTexture(const std::string& file_path);      ///< @brief 从文件路径加载纹理
+        SDL_Texture* loadTexture(const std::string& file_path);      ///< @brief 从文件路径加载纹理（非渲染线程上只解码，返回 nullptr 直到上传完成）
+        bool preloadTexture(const std::string& file_path);           ///< @brief 在调用线程上解码为 Surface（不持有锁），等待渲染线程第一次使用时上传
         SDL_Texture* getTexture(const std::string& file_path);       ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
         glm::vec2 getTextureSize(const std::string& file_path);      ///< @brief 获取指定纹理的尺寸
         void unloadTexture(const std::string& file_path);            ///< @brief 卸载指定的纹理资源
         void clearTextures();                                        ///< @brief 清空所有纹理资源
+        std::uint32_t getTextureHandle(const std::string& file_path); ///< @brief 获取纹理句柄（首次访问时加载并分配），失败返回 0
+        SDL_Texture* getTextureByHandle(std::uint32_t handle);       ///< @brief 通过句柄获取纹理（渲染线程上会完成延迟上传），槽位为空时按路径重新加载
+        glm::vec2 getTextureSizeByHandle(std::uint32_t handle) const; ///< @brief 通过句柄获取纹理尺寸，无效句柄返回 (0, 0)
+        std::uint32_t setTextureSurface(const std::string& key, SDL_Surface* surface); ///< @brief 用程序生成的图像创建/替换纹理（接管 surface），返回句柄
+        ResourceLoadStats getLoadStats() const;                      ///< @brief 首次访问时同步加载的累计统计（不含 preloadTexture）
+
+        // --- 内部辅助函数（调用前必须持有 mutex_） ---
+        bool isRenderThread() const { return std::this_thread::get_id() == render_thread_id_; }
+        std::uint32_t acquireHandle(std::unique_lock<std::mutex>& lock, const std::string& file_path);  ///< @brief 查找或分配句柄，槽位为空时解码（见 decodeSlot）
+        /**
+         * @brief 把空槽位解码为 Surface（上传推迟到 resolveLocked）。调用时持有 lock，解码期间释放，
+         * 同一槽位同时只有一个线程解码，其它线程等待结果。返回后槽位引用可能已失效，需要按句柄重新取。
+         */
+        bool decodeSlot(std::unique_lock<std::mutex>& lock, std::uint32_t handle);
+        SDL_Texture* resolveLocked(TextureSlot& slot);                     ///< @brief 获取槽位纹理，渲染线程上完成延迟上传
+        void releaseSlotLocked(TextureSlot& slot);                         ///< @brief 释放槽位中的纹理与 Surface
     };
 
-} // namespace engine::resource
\ No newline at end of file
+} // namespace engine::resource
@@ -0,0 +1,216 @@
+#include "tileset_cache.h"
+#include "../component/tilelayer_component.h"
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+
+    namespace {
+        /// @brief 解析图块集中的图片路径（相对于图块集文件），与 LevelLoader::resolvePath 一致
+        std::string resolveImagePath(const std::string& relative_path, const std::string& tileset_path) {
+            std::error_code ec;
+            auto final_path = std::filesystem::canonical(std::filesystem::path(tileset_path).parent_path() / relative_path, ec);
+            if (ec) {
+                spdlog::error("解析路径失败: {}", ec.message());
+                return relative_path;
+            }
+            return final_path.string();
+        }
+
+        /// @brief 根据瓦片json的自定义属性获取瓦片类型
+        engine::component::TileType getTileType(const nlohmann::json& tile_json) {
+            using engine::component::TileType;
+            if (!tile_json.contains("properties")) {
+                return TileType::NORMAL;
+            }
+            for (const auto& property : tile_json["properties"]) {
+                if (!property.contains("name")) {
+                    continue;
+                }
+                const auto& name = property["name"];
+                if (name == "solid") {
+                    return property.value("value", false) ? TileType::SOLID : TileType::NORMAL;
+                }
+                if (name == "slope") {
+                    const auto slope_type = property.value("value", "");
+                    if (slope_type == "0_1") return TileType::SLOPE_0_1;
+                    if (slope_type == "1_0") return TileType::SLOPE_1_0;
+                    if (slope_type == "0_2") return TileType::SLOPE_0_2;
+                    if (slope_type == "2_0") return TileType::SLOPE_2_0;
+                    if (slope_type == "2_1") return TileType::SLOPE_2_1;
+                    if (slope_type == "1_2") return TileType::SLOPE_1_2;
+                    spdlog::error("未知的斜坡类型: {}", slope_type);
+                    return TileType::NORMAL;
+                }
+                if (name == "unisolid") {
+                    return property.value("value", false) ? TileType::UNISOLID : TileType::NORMAL;
+                }
+                if (name == "hazard") {
+                    return property.value("value", false) ? TileType::HAZARD : TileType::NORMAL;
+                }
+                if (name == "ladder") {
+                    return property.value("value", false) ? TileType::LADDER : TileType::NORMAL;
+                }
+            }
+            return TileType::NORMAL;
+        }
+    }
+
+    // --- Tileset ---
+
+    std::shared_ptr<const Tileset> Tileset::load(const std::string& file_path) {
+        std::ifstream tileset_file(file_path);
+        if (!tileset_file.is_open()) {
+            spdlog::error("无法打开 Tileset 文件: {}", file_path);
+            return nullptr;
+        }
+
+        nlohmann::json ts_json;
+        try {
+            tileset_file >> ts_json;
+        }
+        catch (const nlohmann::json::parse_error& e) {
+            spdlog::error("解析 Tileset JSON 文件 '{}' 失败: {} (at byte {})", file_path, e.what(), e.byte);
+            return nullptr;
+        }
+        return std::make_shared<const Tileset>(file_path, std::move(ts_json));
+    }
+
+    Tileset::Tileset(std::string file_path, nlohmann::json&& json)
+        : file_path_(std::move(file_path)), json_(std::move(json))
+    {
+        // 多图片图块集的 id 可能不连续（删除过瓦片），表的长度取 tilecount 与最大 id + 1 中的较大者
+        int tile_count = json_.value("tilecount", 0);
+        const nlohmann::json* tiles_json = json_.contains("tiles") && json_["tiles"].is_array() ? &json_["tiles"] : nullptr;
+        if (tiles_json) {
+            for (const auto& tile_json : *tiles_json) {
+                tile_count = std::max(tile_count, tile_json.value("id", -1) + 1);
+            }
+        }
+        tiles_.resize(static_cast<std::size_t>(std::max(tile_count, 0)));
+
+        if (json_.contains("image")) {    // 单一图片：纹理路径只解析一次，源矩形按网格计算
+            const auto texture_id = resolveImagePath(json_["image"].get<std::string>(), file_path_);
+            const int columns = json_.value("columns", 0);
+            const int tile_width = json_.value("tilewidth", 0);
+            const int tile_height = json_.value("tileheight", 0);
+            if (columns <= 0 || tile_width <= 0 || tile_height <= 0) {
+                spdlog::error("Tileset 文件 '{}' 缺少有效的 'columns' / 'tilewidth' / 'tileheight' 属性。", file_path_);
+                tiles_.clear();
+                return;
+            }
+            for (int local_id = 0; local_id < tile_count; ++local_id) {
+                auto& tile = tiles_[local_id];
+                tile.texture_id = texture_id;
+                tile.src_rect = {
+                    static_cast<float>(local_id % columns * tile_width),
+                    static_cast<float>(local_id / columns * tile_height),
+                    static_cast<float>(tile_width),
+                    static_cast<float>(tile_height)
+                };
+                tile.type = engine::component::TileType::NORMAL;
+                tile.local_id = local_id;
+                tile.is_present = true;
+            }
+        }
+        else if (!tiles_json) {
+            spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", file_path_);
+            return;
+        }
+
+        // tiles 数组：记录瓦片json的位置与类型；多图片图块集在这里解析每个瓦片的图片与源矩形
+        if (tiles_json) {
+            for (const auto& tile_json : *tiles_json) {
+                const int local_id = tile_json.value("id", -1);
+                if (local_id < 0) {
+                    continue;
+                }
+                auto& tile = tiles_[local_id];
+                tile.json = &tile_json;
+                tile.type = getTileType(tile_json);
+                tile.local_id = local_id;
+                tile.is_present = true;
+                if (json_.contains("image")) {
+                    continue;
+                }
+                if (!tile_json.contains("image")) {
+                    spdlog::error("Tileset 文件 '{}' 中瓦片 {} 缺少 'image' 属性。", file_path_, local_id);
+                    continue;
+                }
+                tile.texture_id = resolveImagePath(tile_json["image"].get<std::string>(), file_path_);
+                const auto image_width = tile_json.value("imagewidth", 0);
+                const auto image_height = tile_json.value("imageheight", 0);
+                tile.src_rect = {      // tiled中源矩形信息只有设置了才会有值，没有就是默认值
+                    static_cast<float>(tile_json.value("x", 0)),
+                    static_cast<float>(tile_json.value("y", 0)),
+                    static_cast<float>(tile_json.value("width", image_width)),    // 如果未设置，则使用图片尺寸
+                    static_cast<float>(tile_json.value("height", image_height))
+                };
+            }
+        }
+    }
+
+    // --- TilesetCache ---
+
+    TilesetCache::~TilesetCache() = default;
+
+    std::shared_ptr<const Tileset> TilesetCache::getTileset(const std::string& file_path) {
+        const auto key = getCacheKey(file_path);
+        std::error_code ec;
+        const auto write_time = std::filesystem::last_write_time(key, ec);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = tilesets_.find(key); it != tilesets_.end()) {
+                if (!ec && it->second.write_time == write_time) {
+                    ++hit_count_;
+                    return it->second.tileset;
+                }
+                spdlog::info("Tileset 文件 '{}' 已修改，重新加载。", file_path);
+                tilesets_.erase(it);
+            }
+        }
+
+        // 在锁外读取和解析，不阻塞其它线程获取已缓存的图块集
+        auto tileset = Tileset::load(file_path);
+        if (!tileset) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++load_count_;
+        auto& entry = tilesets_[key];
+        if (!entry.tileset || entry.write_time != write_time) {    // 另一个线程可能同时加载了同一个文件
+            entry = { std::move(tileset), write_time };
+        }
+        spdlog::debug("Tileset 缓存：{} 个图块集，命中 {} 次，加载 {} 次。", tilesets_.size(), hit_count_, load_count_);
+        return entry.tileset;
+    }
+
+    void TilesetCache::invalidateTileset(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tilesets_.erase(getCacheKey(file_path)) > 0) {
+            spdlog::debug("Tileset '{}' 已从缓存中移除。", file_path);
+        }
+    }
+
+    std::size_t TilesetCache::getTilesetCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tilesets_.size();
+    }
+
+    void TilesetCache::clearTilesets() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!tilesets_.empty()) {
+            spdlog::debug("正在清除所有 {} 个缓存的图块集。", tilesets_.size());
+            tilesets_.clear();
+        }
+    }
+
+    std::string TilesetCache::getCacheKey(const std::string& file_path) {
+        std::error_code ec;
+        auto canonical_path = std::filesystem::weakly_canonical(std::filesystem::path(file_path), ec);
+        return ec ? std::filesystem::path(file_path).lexically_normal().string() : canonical_path.string();
+    }
+
+} // namespace engine::resource
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+#include <nlohmann/json.hpp>
+
+namespace engine::component {
+    enum class TileType;
+}
+
+namespace engine::resource {
+
+    /// @brief 图块集中单个瓦片的预解析信息（局部 ID 查找表的一项）
+    struct TilesetTile {
+        std::string texture_id;                         ///< @brief 已解析的纹理路径（空表示没有图片）
+        SDL_FRect src_rect = { 0.0f, 0.0f, 0.0f, 0.0f };///< @brief 源矩形
+        engine::component::TileType type{};             ///< @brief 瓦片类型
+        const nlohmann::json* json = nullptr;           ///< @brief 图块集中该瓦片的json（指向 Tileset 持有的数据，没有条目时为 nullptr）
+        int local_id = 0;                               ///< @brief 图块集中的局部 ID
+        bool is_present = false;                        ///< @brief 图块集中是否有该瓦片
+    };
+
+    /**
+     * @brief 解析后的 Tiled 图块集（.tsj），构造后不可变。
+     *
+     * 持有图块集json与按局部 ID 索引的瓦片表（纹理路径、源矩形与瓦片类型都在加载时一次性解析），
+     * 不依赖 firstgid，因此可以被引用同一图块集的多个地图共享。瓦片表中的json指针指向本对象持有的数据。
+     */
+    class Tileset final {
+    private:
+        std::string file_path_;                 ///< @brief 图块集文件路径
+        nlohmann::json json_;                   ///< @brief 图块集json数据
+        std::vector<TilesetTile> tiles_;        ///< @brief 局部 ID -> 瓦片信息
+
+    public:
+        /**
+         * @brief 读取并解析图块集文件。
+         * @param file_path 图块集文件路径
+         * @return 解析后的图块集，文件无法打开或解析失败时返回 nullptr
+         */
+        static std::shared_ptr<const Tileset> load(const std::string& file_path);
+
+        Tileset(std::string file_path, nlohmann::json&& json);   ///< @brief 由 load() 调用，构建瓦片表
+
+        // 禁止拷贝和移动（瓦片表中的json指针指向 json_）
+        Tileset(const Tileset&) = delete;
+        Tileset& operator=(const Tileset&) = delete;
+        Tileset(Tileset&&) = delete;
+        Tileset& operator=(Tileset&&) = delete;
+
+        const std::string& getFilePath() const { return file_path_; }               ///< @brief 获取图块集文件路径
+        const nlohmann::json& getJson() const { return json_; }                     ///< @brief 获取图块集json数据
+        int getTileCount() const { return static_cast<int>(tiles_.size()); }        ///< @brief 瓦片表长度（tilecount 与最大 id + 1 中的较大者）
+        const TilesetTile* getTiles() const { return tiles_.data(); }               ///< @brief 瓦片表（按局部 ID 索引）
+    };
+
+    /**
+     * @brief 跨关卡共享的图块集缓存。
+     *
+     * 以规范路径为键缓存 Tileset，并记录加载时文件的修改时间：再次获取时如果文件已被修改则重新加载，
+     * 因此编辑器中保存图块集后下一次加载关卡即可看到变化；也可以用 invalidate() 显式丢弃。
+     * 关卡准备阶段可能在后台线程上运行（见 LevelPreloader），所有方法都是线程安全的。
+     */
+    class TilesetCache final {
+        friend class ResourceManager;
+
+    private:
+        /// @brief 缓存项
+        struct Entry {
+            std::shared_ptr<const Tileset> tileset;             ///< @brief 图块集
+            std::filesystem::file_time_type write_time{};       ///< @brief 加载时文件的修改时间
+        };
+
+        std::unordered_map<std::string, Entry> tilesets_;       ///< @brief 规范路径 -> 缓存项
+        std::size_t hit_count_ = 0;                             ///< @brief 命中次数
+        std::size_t load_count_ = 0;                            ///< @brief 从磁盘加载的次数
+        mutable std::mutex mutex_;                              ///< @brief 保护以上成员
+
+    public:
+        TilesetCache() = default;
+        ~TilesetCache();
+
+        // 禁止拷贝和移动
+        TilesetCache(const TilesetCache&) = delete;
+        TilesetCache& operator=(const TilesetCache&) = delete;
+        TilesetCache(TilesetCache&&) = delete;
+        TilesetCache& operator=(TilesetCache&&) = delete;
+
+    private: // 仅供 ResourceManager 访问的方法
+        std::shared_ptr<const Tileset> getTileset(const std::string& file_path);    ///< @brief 获取图块集，未缓存或文件已修改时从磁盘加载，失败返回 nullptr
+        void invalidateTileset(const std::string& file_path);                       ///< @brief 丢弃指定图块集（正在使用它的加载器不受影响）
+        std::size_t getTilesetCount() const;                                        ///< @brief 获取已缓存的图块集数量
+        void clearTilesets();                                                       ///< @brief 清空缓存
+
+        static std::string getCacheKey(const std::string& file_path);               ///< @brief 缓存键：规范路径
+    };
+
+} // namespace engine::resource
@@ -0,0 +1,179 @@
+#include "cooked_level.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene::cooked {
+
+    static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Tile>
+        && std::is_trivially_copyable_v<TileFrame> && std::is_trivially_copyable_v<Clip>
+        && std::is_trivially_copyable_v<ClipFrame> && std::is_trivially_copyable_v<Sound>
+        && std::is_trivially_copyable_v<Layer> && std::is_trivially_copyable_v<Object>,
+        "烘焙关卡的记录必须可以直接按字节读写");
+
+    namespace {
+        constexpr std::size_t SECTION_ALIGNMENT = 8;
+
+        std::size_t alignUp(std::size_t value) {
+            return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+        }
+
+        /// @brief 把一段记录追加到缓冲区（按 8 字节对齐），并填写段信息
+        template<typename T>
+        void appendSection(std::vector<char>& buffer, Header& header, SectionId id, const T* data, std::size_t count) {
+            buffer.resize(alignUp(buffer.size()), 0);
+            auto& section = header.sections[static_cast<std::size_t>(id)];
+            section.offset = static_cast<std::uint32_t>(buffer.size());
+            section.count = static_cast<std::uint32_t>(count);
+            if (count > 0) {
+                const auto* bytes = reinterpret_cast<const char*>(data);
+                buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+            }
+        }
+
+        template<typename T>
+        void appendSection(std::vector<char>& buffer, Header& header, SectionId id, const std::vector<T>& records) {
+            appendSection(buffer, header, id, records.data(), records.size());
+        }
+
+        /// @brief 各段记录的大小与对齐要求，用于校验
+        struct SectionLayout {
+            std::size_t size;
+            std::size_t alignment;
+        };
+
+        template<SectionId Id>
+        constexpr SectionLayout layoutOf() {
+            using T = typename SectionRecord<Id>::type;
+            return { sizeof(T), alignof(T) };
+        }
+
+        constexpr SectionLayout SECTION_LAYOUTS[] = {
+            layoutOf<SectionId::STRINGS>(),
+            layoutOf<SectionId::SOURCES>(),
+            layoutOf<SectionId::TILES>(),
+            layoutOf<SectionId::TILE_FRAMES>(),
+            layoutOf<SectionId::CLIPS>(),
+            layoutOf<SectionId::CLIP_FRAMES>(),
+            layoutOf<SectionId::SOUNDS>(),
+            layoutOf<SectionId::LAYERS>(),
+            layoutOf<SectionId::CELLS>(),
+            layoutOf<SectionId::OBJECTS>(),
+        };
+        static_assert(std::size(SECTION_LAYOUTS) == static_cast<std::size_t>(SectionId::COUNT));
+    }
+
+    void LevelWriter::setMapInfo(int map_width, int map_height, int tile_width, int tile_height) {
+        header_.map_width = map_width;
+        header_.map_height = map_height;
+        header_.tile_width = tile_width;
+        header_.tile_height = tile_height;
+    }
+
+    StringRef LevelWriter::addString(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        std::string key(text);
+        if (auto it = string_refs_.find(key); it != string_refs_.end()) {
+            return it->second;
+        }
+        StringRef ref{ static_cast<std::uint32_t>(strings_.size()), static_cast<std::uint32_t>(text.size()) };
+        strings_.append(text);
+        strings_.push_back('\0');   // 方便调试时直接查看
+        string_refs_.emplace(std::move(key), ref);
+        return ref;
+    }
+
+    bool LevelWriter::write(const std::string& path) {
+        Header header = header_;
+        std::vector<char> buffer(sizeof(Header), 0);
+        appendSection(buffer, header, SectionId::STRINGS, strings_.data(), strings_.size());
+        appendSection(buffer, header, SectionId::SOURCES, sources_);
+        appendSection(buffer, header, SectionId::TILES, tiles);
+        appendSection(buffer, header, SectionId::TILE_FRAMES, tile_frames);
+        appendSection(buffer, header, SectionId::CLIPS, clips);
+        appendSection(buffer, header, SectionId::CLIP_FRAMES, clip_frames);
+        appendSection(buffer, header, SectionId::SOUNDS, sounds);
+        appendSection(buffer, header, SectionId::LAYERS, layers);
+        appendSection(buffer, header, SectionId::CELLS, cells);
+        appendSection(buffer, header, SectionId::OBJECTS, objects);
+        buffer.resize(alignUp(buffer.size()), 0);
+        header.file_size = static_cast<std::uint32_t>(buffer.size());
+        std::memcpy(buffer.data(), &header, sizeof(Header));
+
+        const std::string temp_path = path + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::error("无法创建烘焙关卡文件: {}", temp_path);
+                return false;
+            }
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!file) {
+                spdlog::error("写入烘焙关卡文件失败: {}", temp_path);
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec) {
+            spdlog::error("无法替换烘焙关卡文件 '{}': {}", path, ec.message());
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+        spdlog::info("已写入烘焙关卡 '{}'（{} 字节，{} 个瓦片，{} 个格子，{} 个对象）。",
+            path, buffer.size(), tiles.size(), cells.size(), objects.size());
+        return true;
+    }
+
+    bool LevelView::open(const std::string& path) {
+        header_ = nullptr;
+        if (!file_.open(path)) {
+            return false;
+        }
+        if (file_.size() < sizeof(Header)) {
+            spdlog::warn("烘焙关卡 '{}' 太小，忽略。", path);
+            return false;
+        }
+        const auto* header = reinterpret_cast<const Header*>(file_.data());
+        if (header->magic != MAGIC || header->header_size != sizeof(Header)) {
+            spdlog::warn("'{}' 不是烘焙关卡文件，忽略。", path);
+            return false;
+        }
+        if (header->version != VERSION) {
+            spdlog::info("烘焙关卡 '{}' 的版本为 {}，当前版本为 {}，需要重新烘焙。", path, header->version, VERSION);
+            return false;
+        }
+        if (header->file_size != file_.size()) {
+            spdlog::warn("烘焙关卡 '{}' 大小不符（{} / {}），可能已损坏。", path, file_.size(), header->file_size);
+            return false;
+        }
+        for (std::size_t i = 0; i < static_cast<std::size_t>(SectionId::COUNT); ++i) {
+            const auto& section = header->sections[i];
+            const auto& layout = SECTION_LAYOUTS[i];
+            if (section.offset % layout.alignment != 0 || section.offset < sizeof(Header)
+                || section.offset > file_.size()
+                || section.count > (file_.size() - section.offset) / layout.size) {
+                spdlog::warn("烘焙关卡 '{}' 的第 {} 段越界，可能已损坏。", path, i);
+                return false;
+            }
+        }
+        if (header->map_width < 0 || header->map_height < 0) {
+            spdlog::warn("烘焙关卡 '{}' 的地图尺寸无效。", path);
+            return false;
+        }
+        header_ = header;
+        return true;
+    }
+
+    std::string_view LevelView::getString(const StringRef& ref) const {
+        const auto strings = get<SectionId::STRINGS>();
+        if (ref.offset > strings.size() || ref.length > strings.size() - ref.offset) {
+            return {};
+        }
+        return { strings.data() + ref.offset, ref.length };
+    }
+
+} // namespace engine::scene::cooked
@@ -0,0 +1,236 @@
+#pragma once
+#include "../utils/mapped_file.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 烘焙关卡（.lvl）的二进制格式。
+ *
+ * 由 LevelLoader::cookLevel 从 Tiled 地图及其图块集离线生成，运行时内存映射后直接按结构体读取，不做任何 JSON 解析。
+ * 文件由文件头与若干段组成，每段是同一种定长记录的数组（8 字节对齐），字符串统一存放在 STRINGS 段并以 StringRef 引用。
+ * 数值按本机字节序（小端）存储；格式变化时提高 VERSION，旧文件会被拒绝并回退到 .tmj。
+ */
+namespace engine::scene::cooked {
+
+    inline constexpr std::uint32_t MAGIC = 0x4C563347;      ///< @brief "G3VL"（小端）
+    inline constexpr std::uint32_t VERSION = 1;             ///< @brief 格式版本
+    inline constexpr const char* FILE_EXTENSION = ".lvl";   ///< @brief 烘焙文件扩展名（与 .tmj 同目录同名）
+
+    /// @brief 段编号
+    enum class SectionId : std::uint32_t {
+        STRINGS,        ///< @brief 字符串数据（char）
+        SOURCES,        ///< @brief 源文件路径（StringRef），用于判断烘焙文件是否过期
+        TILES,          ///< @brief 瓦片表（Tile），下标即瓦片调色板下标，0 为空瓦片
+        TILE_FRAMES,    ///< @brief 瓦片动画帧（TileFrame）
+        CLIPS,          ///< @brief 对象动画剪辑（Clip）
+        CLIP_FRAMES,    ///< @brief 剪辑帧（ClipFrame）
+        SOUNDS,         ///< @brief 音效表（Sound）
+        LAYERS,         ///< @brief 图层（Layer），按 Tiled 中的顺序
+        CELLS,          ///< @brief 瓦片层格子（std::uint16_t 瓦片表下标）
+        OBJECTS,        ///< @brief 对象（Object）
+        COUNT
+    };
+
+    struct StringRef {
+        std::uint32_t offset = 0;       ///< @brief 在 STRINGS 段中的偏移
+        std::uint32_t length = 0;       ///< @brief 长度（不含结尾的 0）
+    };
+
+    struct Section {
+        std::uint32_t offset = 0;       ///< @brief 距文件开头的字节偏移
+        std::uint32_t count = 0;        ///< @brief 记录数量
+    };
+
+    struct Header {
+        std::uint32_t magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint32_t header_size = sizeof(Header);     ///< @brief 用于校验结构体布局
+        std::uint32_t file_size = 0;                    ///< @brief 文件总大小，用于发现截断
+        std::int32_t map_width = 0;                     ///< @brief 地图尺寸（瓦片数）
+        std::int32_t map_height = 0;
+        std::int32_t tile_width = 0;                    ///< @brief 瓦片尺寸（像素）
+        std::int32_t tile_height = 0;
+        Section sections[static_cast<std::size_t>(SectionId::COUNT)];
+    };
+
+    /// @brief Tile::flags 的位
+    namespace tile_flag {
+        inline constexpr std::uint8_t HAS_COLLIDER = 1 << 0;        ///< @brief 有自定义碰撞盒
+        inline constexpr std::uint8_t HAS_TAG = 1 << 1;             ///< @brief 有 tag 属性
+        inline constexpr std::uint8_t HAS_GRAVITY = 1 << 2;         ///< @brief 有 gravity 属性
+        inline constexpr std::uint8_t GRAVITY = 1 << 3;             ///< @brief gravity 属性的值
+        inline constexpr std::uint8_t HAS_HEALTH = 1 << 4;          ///< @brief 有 health 属性
+        inline constexpr std::uint8_t HAS_ANIMATION_SET = 1 << 5;   ///< @brief 有 animation 属性（对象动画剪辑）
+        inline constexpr std::uint8_t HAS_SOUNDS = 1 << 6;          ///< @brief 有 sound 属性
+        inline constexpr std::uint8_t INVALID_OBJECT = 1 << 7;      ///< @brief 属性 JSON 无效，对象层引用此瓦片时跳过（与 .tmj 加载行为一致）
+    }
+
+    /// @brief 一个瓦片（只包含地图中实际引用到的瓦片）
+    struct Tile {
+        StringRef texture_id;                   ///< @brief 纹理路径（相对工作目录）
+        StringRef tileset;                      ///< @brief 所属图块集路径（共享资源的键）
+        float src_rect[4] = {};                 ///< @brief 源矩形 x, y, w, h
+        float collider[4] = {};                 ///< @brief 自定义碰撞盒 x, y, w, h（HAS_COLLIDER）
+        StringRef tag;                          ///< @brief tag 属性（HAS_TAG）
+        std::int32_t local_id = 0;              ///< @brief 图块集中的局部 ID
+        std::int32_t health = 0;                ///< @brief health 属性（HAS_HEALTH）
+        std::uint32_t first_tile_frame = 0;     ///< @brief Tiled 瓦片动画帧（TILE_FRAMES 中的范围）
+        std::uint32_t tile_frame_count = 0;
+        std::uint32_t first_clip = 0;           ///< @brief 对象动画剪辑（CLIPS 中的范围）
+        std::uint32_t clip_count = 0;
+        std::uint32_t first_sound = 0;          ///< @brief 音效（SOUNDS 中的范围）
+        std::uint32_t sound_count = 0;
+        std::uint8_t type = 0;                  ///< @brief engine::component::TileType
+        std::uint8_t flags = 0;                 ///< @brief tile_flag 的组合
+        std::uint16_t reserved = 0;
+    };
+
+    struct TileFrame {
+        std::uint32_t tile = 0;                 ///< @brief 该帧显示的瓦片（TILES 下标）
+        float duration = 0.0f;                  ///< @brief 持续时间（秒）
+    };
+
+    struct Clip {
+        StringRef name;                         ///< @brief 剪辑名称
+        std::uint32_t first_frame = 0;          ///< @brief CLIP_FRAMES 中的范围
+        std::uint32_t frame_count = 0;
+        std::uint32_t is_looping = 1;
+    };
+
+    struct ClipFrame {
+        float src_rect[4] = {};                 ///< @brief 源矩形
+        float duration = 0.0f;                  ///< @brief 持续时间（秒）
+    };
+
+    struct Sound {
+        StringRef id;                           ///< @brief 音效名称
+        StringRef path;                         ///< @brief 音频文件路径
+    };
+
+    enum class LayerKind : std::uint8_t {
+        IMAGE,          ///< @brief 图片（视差）图层
+        TILE,           ///< @brief 瓦片图层
+        OBJECT,         ///< @brief 对象图层
+    };
+
+    struct Layer {
+        StringRef name;                         ///< @brief 图层名称
+        StringRef texture_id;                   ///< @brief 图片图层的纹理
+        float offset[2] = {};                   ///< @brief 图片图层的偏移
+        float scroll_factor[2] = { 1.0f, 1.0f };///< @brief 图片图层的视差因子
+        std::uint32_t first = 0;                ///< @brief 瓦片层：CELLS 中的起点；对象层：OBJECTS 中的起点
+        std::uint32_t count = 0;                ///< @brief 格子数 / 对象数
+        LayerKind kind = LayerKind::TILE;
+        std::uint8_t render_layer = 0;          ///< @brief 渲染层级（按 Tiled 中的顺序分配）
+        std::uint8_t repeat_x = 0;              ///< @brief 图片图层是否沿 X/Y 重复
+        std::uint8_t repeat_y = 0;
+    };
+
+    struct Object {
+        StringRef name;                         ///< @brief 对象名称
+        StringRef tag;                          ///< @brief 自定义形状对象的 tag 属性（has_tag）
+        float position[2] = {};                 ///< @brief Tiled 中的位置（瓦片对象为左下角）
+        float size[2] = {};                     ///< @brief 尺寸
+        float rotation = 0.0f;                  ///< @brief 旋转角度
+        std::uint32_t tile = 0;                 ///< @brief 瓦片对象引用的瓦片（TILES 下标），0 表示自定义形状（矩形）
+        std::uint8_t is_trigger = 1;            ///< @brief 自定义形状是否为触发器
+        std::uint8_t has_tag = 0;
+        std::uint16_t reserved = 0;
+    };
+
+    /// @brief 段编号 -> 记录类型
+    template<SectionId> struct SectionRecord;
+    template<> struct SectionRecord<SectionId::STRINGS> { using type = char; };
+    template<> struct SectionRecord<SectionId::SOURCES> { using type = StringRef; };
+    template<> struct SectionRecord<SectionId::TILES> { using type = Tile; };
+    template<> struct SectionRecord<SectionId::TILE_FRAMES> { using type = TileFrame; };
+    template<> struct SectionRecord<SectionId::CLIPS> { using type = Clip; };
+    template<> struct SectionRecord<SectionId::CLIP_FRAMES> { using type = ClipFrame; };
+    template<> struct SectionRecord<SectionId::SOUNDS> { using type = Sound; };
+    template<> struct SectionRecord<SectionId::LAYERS> { using type = Layer; };
+    template<> struct SectionRecord<SectionId::CELLS> { using type = std::uint16_t; };
+    template<> struct SectionRecord<SectionId::OBJECTS> { using type = Object; };
+
+    /**
+     * @brief 烘焙文件的写入器：收集各段记录，最后一次性写出。
+     */
+    class LevelWriter final {
+    private:
+        Header header_;
+        std::string strings_;                                       ///< @brief STRINGS 段
+        std::unordered_map<std::string, StringRef> string_refs_;    ///< @brief 相同字符串只存一份
+        std::vector<StringRef> sources_;
+
+    public:
+        std::vector<Tile> tiles;
+        std::vector<TileFrame> tile_frames;
+        std::vector<Clip> clips;
+        std::vector<ClipFrame> clip_frames;
+        std::vector<Sound> sounds;
+        std::vector<Layer> layers;
+        std::vector<std::uint16_t> cells;
+        std::vector<Object> objects;
+
+        LevelWriter() = default;
+
+        // 禁止拷贝和移动
+        LevelWriter(const LevelWriter&) = delete;
+        LevelWriter& operator=(const LevelWriter&) = delete;
+        LevelWriter(LevelWriter&&) = delete;
+        LevelWriter& operator=(LevelWriter&&) = delete;
+
+        void setMapInfo(int map_width, int map_height, int tile_width, int tile_height);   ///< @brief 设置地图尺寸与瓦片尺寸
+        StringRef addString(std::string_view text);                                         ///< @brief 添加字符串（去重）
+        void addSource(const std::string& path) { sources_.push_back(addString(path)); }   ///< @brief 记录一个源文件
+
+        /**
+         * @brief 写出文件（先写到临时文件再替换，避免留下不完整的文件）。
+         * @return 是否成功
+         */
+        bool write(const std::string& path);
+    };
+
+    /**
+     * @brief 只读访问一个内存映射的烘焙文件。
+     *
+     * open() 校验文件头、版本以及每个段的范围，之后所有访问都直接指向映射的内存。
+     */
+    class LevelView final {
+    private:
+        engine::utils::MappedFile file_;
+        const Header* header_ = nullptr;
+
+    public:
+        LevelView() = default;
+
+        // 禁止拷贝和移动
+        LevelView(const LevelView&) = delete;
+        LevelView& operator=(const LevelView&) = delete;
+        LevelView(LevelView&&) = delete;
+        LevelView& operator=(LevelView&&) = delete;
+
+        /**
+         * @brief 映射并校验文件。
+         * @return 是否是当前版本的有效烘焙文件
+         */
+        bool open(const std::string& path);
+
+        const Header& getHeader() const { return *header_; }       ///< @brief 获取文件头（open 成功后有效）
+
+        /// @brief 获取某个段的全部记录
+        template<SectionId Id>
+        std::span<const typename SectionRecord<Id>::type> get() const {
+            using T = typename SectionRecord<Id>::type;
+            const auto& section = header_->sections[static_cast<std::size_t>(Id)];
+            return { reinterpret_cast<const T*>(file_.data() + section.offset), section.count };
+        }
+
+        std::string_view getString(const StringRef& ref) const;    ///< @brief 解析字符串引用（越界时返回空）
+    };
+
+} // namespace engine::scene::cooked
@@ -12,8 +12,15 @@
 #include "../scene/scene.h"
 #include "../core/context.h"
 #include "../resource/resource_manager.h"
+#include "../resource/tileset_cache.h"
 #include "../render/sprite.h"
 #include "../render/animation.h"
+#include "../render/render_queue.h"
+#include "../render/animation_system.h"
+#include "../core/job_pool.h"
+#include "cooked_level.h"
+#include "tile_chunk_streamer.h"
+#include "../utils/compression.h"
 
 
 #include "../utils/math.h"
@@ -22,65 +29,345 @@
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <set>
+#include <unordered_set>
 
 namespace engine::scene {
 
+    namespace {
+        /// @brief 烘焙文件中保存相对于工作目录的路径，使烘焙结果可以随工程一起移动
+        std::string toPortablePath(const std::string& path) {
+            std::error_code ec;
+            auto relative_path = std::filesystem::relative(path, ec);
+            return ec || relative_path.empty() ? path : relative_path.generic_string();
+        }
+
+        /// @brief 把烘焙文件中的路径转换为规范路径（与 LevelLoader::resolvePath 的结果一致）
+        std::string toRuntimePath(std::string_view path) {
+            std::error_code ec;
+            auto canonical_path = std::filesystem::canonical(std::filesystem::path(path), ec);
+            return ec ? std::string(path) : canonical_path.string();
+        }
+
+        /// @brief 读取小端 uint32 gid（base64 解码结果与流式解析得到的二进制数据都是这种格式）
+        std::uint32_t readGid(const std::uint8_t* bytes) {
+            return std::uint32_t{ bytes[0] } | (std::uint32_t{ bytes[1] } << 8) |
+                (std::uint32_t{ bytes[2] } << 16) | (std::uint32_t{ bytes[3] } << 24);
+        }
+
+        /**
+         * @brief 流式解析地图json：键为 "data" 的整数数组（瓦片层与分块的 csv 数据）不构建json节点，
+         * 解析时直接写入预留好的字节缓冲（小端 uint32），数组结束时以 json 二进制值替换，每格只占 4 字节。
+         * 其它内容照常构建为json。
+         */
+        class MapJsonParser final {
+        private:
+            bool is_data_key_ = false;          ///< @brief 上一个键是否为 "data"
+            int data_depth_ = -1;               ///< @brief 正在收集的 "data" 数组的深度（-1 表示不在数组中）
+            bool is_data_valid_ = true;         ///< @brief 数组中是否只有整数
+            std::vector<std::uint8_t> bytes_;   ///< @brief 正在收集的 gid
+            std::size_t reserve_bytes_ = 0;     ///< @brief 上一个数组的字节数（同一地图的图层尺寸通常相同，用于预留）
+
+        public:
+            std::size_t cell_count = 0;         ///< @brief 流式收集的格子总数
+            std::size_t array_count = 0;        ///< @brief 流式收集的数组数量
+
+            bool operator()(int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+                using event_t = nlohmann::json::parse_event_t;
+                if (data_depth_ >= 0) {
+                    if (event == event_t::value && depth == data_depth_ + 1) {
+                        if (!parsed.is_number_integer()) {
+                            is_data_valid_ = false;
+                            return false;
+                        }
+                        const auto gid = parsed.get<std::uint32_t>();
+                        bytes_.insert(bytes_.end(), { static_cast<std::uint8_t>(gid), static_cast<std::uint8_t>(gid >> 8),
+                            static_cast<std::uint8_t>(gid >> 16), static_cast<std::uint8_t>(gid >> 24) });
+                        return false;   // 不保留json节点
+                    }
+                    if (event == event_t::array_end && depth == data_depth_) {
+                        data_depth_ = -1;
+                        if (!is_data_valid_) {
+                            spdlog::error("瓦片数据数组中包含非整数值。");
+                            parsed = nullptr;
+                            return true;
+                        }
+                        reserve_bytes_ = bytes_.size();
+                        cell_count += bytes_.size() / 4;
+                        ++array_count;
+                        parsed = nlohmann::json::binary(std::move(bytes_));
+                        bytes_ = {};
+                        return true;
+                    }
+                    is_data_valid_ = false;     // 数组中嵌套了对象或数组
+                    return false;
+                }
+                if (event == event_t::key) {
+                    is_data_key_ = parsed == "data";
+                    return true;
+                }
+                if (event == event_t::array_start && is_data_key_) {
+                    data_depth_ = depth;
+                    is_data_valid_ = true;
+                    bytes_.reserve(reserve_bytes_);
+                }
+                is_data_key_ = false;
+                return true;
+            }
+        };
+
+        /**
+         * @brief 依次读取瓦片层的 gid。支持 CSV 风格的json数组（流式解析后为二进制值），以及 base64 编码（可选 zlib / gzip 压缩）的字符串：
+         * 后者解码后直接按小端 uint32 读取，不构建json数组。
+         * @param layer_json 瓦片层json
+         * @param visit 对每个 gid 调用
+         * @return bool 是否成功（失败时已记录错误日志）
+         */
+        template<typename Visit>
+        bool forEachTileGid(const nlohmann::json& layer_json, Visit&& visit) {
+            const std::string layer_name = layer_json.value("name", "Unnamed");
+            if (!layer_json.contains("data")) {
+                spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_name);
+                return false;
+            }
+            const auto& data = layer_json["data"];
+            if (data.is_array()) {
+                for (const auto& gid : data) {
+                    visit(gid.get<int>());
+                }
+                return true;
+            }
+            if (data.is_binary()) {     // 流式解析得到的 gid
+                const auto& bytes = data.get_binary();
+                for (std::size_t i = 0; i + 4 <= bytes.size(); i += 4) {
+                    visit(static_cast<int>(readGid(bytes.data() + i)));
+                }
+                return true;
+            }
+            if (!data.is_string() || layer_json.value("encoding", "") != "base64") {
+                spdlog::error("图层 '{}' 的 'data' 编码不受支持（只支持 csv 与 base64）。", layer_name);
+                return false;
+            }
+
+            const auto cell_count = static_cast<std::size_t>(std::max(layer_json.value("width", 0), 0)) *
+                static_cast<std::size_t>(std::max(layer_json.value("height", 0), 0));
+            std::vector<std::uint8_t> encoded;
+            if (!engine::utils::decodeBase64(data.get_ref<const std::string&>(), encoded)) {
+                spdlog::error("图层 '{}' 的 base64 数据无效。", layer_name);
+                return false;
+            }
+            std::vector<std::uint8_t> decompressed;
+            const std::string compression = layer_json.value("compression", "");
+            bool is_decoded = true;
+            if (compression == "zlib") {
+                is_decoded = engine::utils::inflateZlib(encoded, decompressed, cell_count * 4);
+            }
+            else if (compression == "gzip") {
+                is_decoded = engine::utils::inflateGzip(encoded, decompressed, cell_count * 4);
+            }
+            else if (compression.empty()) {
+                decompressed = std::move(encoded);
+            }
+            else {
+                spdlog::error("图层 '{}' 的压缩方式 '{}' 不受支持（只支持 zlib 与 gzip）。", layer_name, compression);
+                return false;
+            }
+            if (!is_decoded || decompressed.size() != cell_count * 4) {
+                spdlog::error("图层 '{}' 的瓦片数据无效：解码得到 {} 字节，应为 {} 字节。", layer_name, decompressed.size(), cell_count * 4);
+                return false;
+            }
+            for (std::size_t i = 0; i < decompressed.size(); i += 4) {
+                visit(static_cast<int>(readGid(decompressed.data() + i)));
+            }
+            return true;
+        }
+    }
+
+    LevelLoader::LevelLoader(engine::resource::ResourceManager* resource_manager, engine::core::JobPool* job_pool)
+        : resource_manager_(resource_manager), job_pool_(job_pool)
+    {
+    }
+
+    LevelLoader::~LevelLoader() = default;
+
     bool LevelLoader::loadLevel(const std::string& level_path, Scene& scene) {
-        // 1. 加载 JSON 文件
-        std::ifstream file(level_path);
-        if (!file.is_open()) {
-            spdlog::error("无法打开关卡文件: {}", level_path);
+        // 没有预先准备（或准备的是其它地图）时在这里同步准备
+        if (prepared_path_ != level_path && !prepareLevel(level_path)) {
             return false;
         }
+        const bool is_loaded = cooked_view_ ? buildCookedLevel(scene) : buildJsonLevel(scene);
+        releasePreparedLevel();
+        return is_loaded;
+    }
 
-        // 2. 解析 JSON 数据
-        nlohmann::json json_data;
-        try {
-            file >> json_data;
+    bool LevelLoader::prepareLevel(const std::string& level_path) {
+        auto start_time = std::chrono::steady_clock::now();
+        releasePreparedLevel();
+        load_profile_.reset(level_path);
+
+        // 优先使用烘焙文件（不存在、无效或已过期时回退到 .tmj）
+        bool is_prepared = false;
+        if (const auto cooked_path = getCookedPath(level_path); std::filesystem::exists(cooked_path)) {
+            is_prepared = prepareCookedLevel(cooked_path);
+            if (!is_prepared) {
+                releasePreparedLevel();
+                spdlog::info("烘焙关卡 '{}' 不可用，改为加载 '{}'。", cooked_path, level_path);
+            }
         }
-        catch (const nlohmann::json::parse_error& e) {
-            spdlog::error("解析 JSON 数据失败: {}", e.what());
+        if (!is_prepared && !prepareJsonLevel(level_path)) {
+            releasePreparedLevel();
             return false;
         }
+        prepared_path_ = level_path;
+        load_profile_.setField("source", cooked_view_ ? "cooked" : "tmj");
+        spdlog::info("关卡 '{}' 准备完成（{}，{} 个纹理，{} 个音效），耗时 {:.3f} ms", level_path, cooked_view_ ? "烘焙文件" : "Tiled JSON",
+            texture_paths_.size(), sound_paths_.size(),
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count());
+        return true;
+    }
 
-        // 3. 获取基本地图信息 (名称、地图尺寸、瓦片尺寸)
-        map_path_ = level_path;
-        map_size_ = glm::ivec2(json_data.value("width", 0), json_data.value("height", 0));
-        tile_size_ = glm::ivec2(json_data.value("tilewidth", 0), json_data.value("tileheight", 0));
+    void LevelLoader::releasePreparedLevel() {
+        prepared_path_.clear();
+        map_json_ = nlohmann::json();
+        cooked_view_.reset();
+        cooked_path_.clear();
+        cooked_paths_.clear();
+        prepared_cells_.clear();
+        prepared_chunks_.clear();
+        object_prefabs_.clear();
+        palette_gids_.clear();
+        texture_paths_.clear();
+        sound_paths_.clear();
+    }
 
-        // 4. 加载 tileset 数据
-        if (json_data.contains("tilesets") && json_data["tilesets"].is_array()) {
-            for (const auto& tileset_json : json_data["tilesets"]) {
-                if (!tileset_json.contains("source") || !tileset_json["source"].is_string() ||
-                    !tileset_json.contains("firstgid") || !tileset_json["firstgid"].is_number_integer()) {
-                    spdlog::error("tilesets 对象中缺少有效 'source' 或 'firstgid' 字段。");
-                    continue;
+    bool LevelLoader::prepareJsonLevel(const std::string& level_path) {
+        // 1~4. 解析地图并加载 tileset 数据（准备阶段可能在后台线程上运行，不登记瓦片动画，不解析纹理句柄）
+        animation_system_ = nullptr;
+        texture_source_ = nullptr;
+        if (!loadMapJson(level_path, map_json_)) {
+            return false;
+        }
+
+        // 5. 把瓦片层转换为调色板下标，并记录需要预先解码的纹理与音效
+        const auto& layers = map_json_["layers"];
+        prepared_cells_.assign(layers.size(), {});
+        prepared_chunks_.assign(layers.size(), nullptr);
+        palette_gids_.assign(1, 0);
+        const bool is_infinite = map_json_.value("infinite", false);
+        load_profile_.setField("infinite", is_infinite);
+        if (is_infinite) {
+            auto chunk_scope = load_profile_.measure("prepare.chunked_layers");
+            if (!prepareChunkedLayers()) {
+                return false;
+            }
+        }
+        else {
+            auto tile_scope = load_profile_.measure("prepare.tile_layers");
+            buildTileLayerCells();      // 各图层并行转换，调色板顺序与图层顺序一致
+        }
+        auto asset_scope = load_profile_.measure("prepare.asset_lists");
+        std::set<std::string> texture_paths;
+        std::set<std::string> sound_paths;
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& layer_json = layers[i];
+            if (!layer_json.value("visible", true)) {
+                continue;
+            }
+            const std::string layer_type = layer_json.value("type", "none");
+            if (layer_type == "imagelayer") {
+                if (const std::string image_path = layer_json.value("image", ""); !image_path.empty()) {
+                    texture_paths.insert(resolvePath(image_path, map_path_));
+                }
+            }
+            else if (layer_type == "objectgroup" && layer_json.contains("objects") && layer_json["objects"].is_array()) {
+                for (const auto& object : layer_json["objects"]) {
+                    const auto* entry = findTile(object.value("gid", 0));
+                    if (!entry || entry->texture_id.empty()) {
+                        continue;
+                    }
+                    texture_paths.insert(entry->texture_id);
+                    if (!entry->json) {
+                        continue;
+                    }
+                    if (auto sound_string = getTileProperty<std::string>(*entry->json, "sound"); sound_string) {
+                        // 解析失败时在构建阶段报告
+                        const auto sound_json = nlohmann::json::parse(sound_string.value(), nullptr, false);
+                        if (!sound_json.is_discarded()) {
+                            for (auto& [sound_id, sound_path] : parseSoundTable(sound_json)) {
+                                sound_paths.insert(std::move(sound_path));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        // 调色板中的瓦片及其 Tiled 动画帧
+        for (std::size_t i = 1; i < palette_gids_.size(); ++i) {
+            const auto* entry = findTile(palette_gids_[i]);
+            if (!entry || entry->texture_id.empty()) {
+                continue;
+            }
+            texture_paths.insert(entry->texture_id);
+            if (!entry->json || !entry->json->contains("animation") || !(*entry->json)["animation"].is_array()) {
+                continue;
+            }
+            const auto& tileset = findTileset(palette_gids_[i]);
+            for (const auto& frame_json : (*entry->json)["animation"]) {
+                const int frame_id = frame_json.value("tileid", -1);
+                if (const auto* frame = frame_id >= 0 && frame_id < tileset.tile_count ? findTile(tileset.first_gid + frame_id) : nullptr;
+                    frame && !frame->texture_id.empty()) {
+                    texture_paths.insert(frame->texture_id);
                 }
-                auto tileset_path = resolvePath(tileset_json["source"], map_path_);  // 支持隐式转换，可以省略.get<T>()方法，
-                auto first_gid = tileset_json["firstgid"];
-                loadTileset(tileset_path, first_gid);
             }
         }
+        texture_paths_.assign(texture_paths.begin(), texture_paths.end());
+        sound_paths_.assign(sound_paths.begin(), sound_paths.end());
+        return true;
+    }
 
-        // 5. 加载图层数据
-        if (!json_data.contains("layers") || !json_data["layers"].is_array()) {       // 地图文件中必须有 layers 数组
-            spdlog::error("地图文件 '{}' 中缺少或无效的 'layers' 数组。", level_path);
-            return false;
+    bool LevelLoader::buildJsonLevel(Scene& scene) {
+        resolveTileTextures(scene);
+
+        // 登记调色板中的瓦片动画（AnimationSystem 只在游戏线程上使用）
+        animation_system_ = &scene.getContext().getAnimationSystem();
+        {
+            auto animation_scope = load_profile_.measure("build.tile_animations");
+            for (std::size_t i = 1; i < palette_gids_.size(); ++i) {
+                if (const auto* entry = findTile(palette_gids_[i]); entry && entry->json && !entry->texture_id.empty()) {
+                    (*tile_palette_)[i].animation_index = getTileAnimationIndex(findTileset(palette_gids_[i]), *entry->json, entry->local_id);
+                }
+            }
         }
-        for (const auto& layer_json : json_data["layers"]) {
+
+        // 加载图层数据
+        const auto& layers = map_json_["layers"];
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& layer_json = layers[i];
+            // 渲染层级按照图层在 Tiled 中的顺序分配，后面的图层绘制在上方
+            current_render_layer_ = static_cast<std::uint8_t>(std::min<int>(
+                engine::render::render_layer::MAP_BASE + static_cast<int>(i), engine::render::render_layer::MAP_MAX));
             // 获取各图层对象中的类型（type）字段
             std::string layer_type = layer_json.value("type", "none");
             if (!layer_json.value("visible", true)) {
                 spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
                 continue;
             }
+            auto layer_scope = load_profile_.measure("build.layer:" + layer_json.value("name", "Unnamed"));
 
             // 根据图层类型决定加载方法
             if (layer_type == "imagelayer") {
                 loadImageLayer(layer_json, scene);
             }
             else if (layer_type == "tilelayer") {
-                loadTileLayer(layer_json, scene);
+                if (prepared_chunks_[i]) {
+                    addChunkedTileLayer(scene, layer_json.value("name", "Unnamed"), std::move(prepared_chunks_[i]));
+                }
+                else {
+                    loadTileLayer(layer_json, std::move(prepared_cells_[i]), scene);
+                }
             }
             else if (layer_type == "objectgroup") {
                 loadObjectLayer(layer_json, scene);
@@ -90,7 +377,237 @@ namespace engine::scene {
             }
         }
 
-        spdlog::info("关卡加载完成: {}", level_path);
+        if (tile_cell_count_ > 0) {
+            std::size_t palette_bytes = tile_palette_->capacity() * sizeof(engine::component::TileInfo);
+            for (const auto& tile : *tile_palette_) {
+                palette_bytes += tile.sprite.getTextureId().capacity();
+            }
+            spdlog::info("瓦片层: {} 个格子，调色板 {} 项，格子 {:.1f} KB + 调色板 {:.1f} KB（逐格保存 TileInfo 约 {:.1f} KB），耗时 {:.3f} ms",
+                tile_cell_count_, tile_palette_->size(), tile_cell_count_ * sizeof(std::uint16_t) / 1024.0,
+                palette_bytes / 1024.0, per_cell_tile_bytes_ / 1024.0, tile_layer_ms_);
+        }
+        if (animated_object_count_ > 0) {
+            spdlog::info("动画剪辑: {} 个对象共享剪辑集，本次新建 {} 个剪辑集（{} 帧），剪辑库共 {} 个剪辑集，耗时 {:.3f} ms",
+                animated_object_count_, animation_sets_built_, animation_frames_built_,
+                scene.getContext().getResourceManager().getAnimationSetCount(), animation_build_ms_);
+        }
+        if (object_instance_count_ > 0) {
+            spdlog::info("瓦片对象: {} 个对象来自 {} 个预制体，编译 {:.3f} ms，实例化 {:.3f} ms（平均每个对象 {:.2f} us）",
+                object_instance_count_, object_prefabs_.size(), prefab_compile_ms_, object_instance_ms_,
+                object_instance_ms_ * 1000.0 / object_instance_count_);
+        }
+        spdlog::info("关卡加载完成: {}", map_path_);
+        return true;
+    }
+
+    bool LevelLoader::loadMapJson(const std::string& level_path, nlohmann::json& json_data) {
+        // 1. 读取 JSON 文件（整体读入，与解析分开计时；文本在解析后立即释放）
+        std::string map_text;
+        {
+            auto read_scope = load_profile_.measure("prepare.file_read");
+            std::ifstream file(level_path, std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                spdlog::error("无法打开关卡文件: {}", level_path);
+                return false;
+            }
+            map_text.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            if (!file.read(map_text.data(), static_cast<std::streamsize>(map_text.size()))) {
+                spdlog::error("读取关卡文件失败: {}", level_path);
+                return false;
+            }
+        }
+
+        // 2. 解析 JSON 数据（流式：瓦片数据数组直接写入二进制缓冲，不为每个格子构建json节点）
+        auto parse_start = std::chrono::steady_clock::now();
+        MapJsonParser parser;
+        {
+            auto parse_scope = load_profile_.measure("prepare.json_parse");
+            try {
+                json_data = nlohmann::json::parse(map_text, [&parser](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+                    return parser(depth, event, parsed);
+                });
+            }
+            catch (const nlohmann::json::parse_error& e) {
+                spdlog::error("解析 JSON 数据失败: {}", e.what());
+                return false;
+            }
+            std::string().swap(map_text);
+        }
+        spdlog::debug("地图 '{}' 解析完成：{} 个瓦片数据数组（{} 个格子）流式读取，耗时 {:.3f} ms", level_path, parser.array_count,
+            parser.cell_count, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - parse_start).count());
+
+        // 3. 获取基本地图信息 (名称、地图尺寸、瓦片尺寸)
+        animated_object_count_ = 0;
+        animation_sets_built_ = 0;
+        animation_frames_built_ = 0;
+        animation_build_ms_ = 0.0;
+        object_prefabs_.clear();
+        object_instance_count_ = 0;
+        prefab_compile_ms_ = 0.0;
+        object_instance_ms_ = 0.0;
+        map_path_ = level_path;
+        tilesets_.clear();
+        gid_table_.clear();
+        tile_palette_ = std::make_shared<std::vector<engine::component::TileInfo>>(1);   // 下标 0：空瓦片
+        palette_index_.clear();
+        tile_cell_count_ = 0;
+        per_cell_tile_bytes_ = 0;
+        tile_layer_ms_ = 0.0;
+        map_origin_ = glm::vec2(0.0f);
+        map_size_ = glm::ivec2(json_data.value("width", 0), json_data.value("height", 0));
+        tile_size_ = glm::ivec2(json_data.value("tilewidth", 0), json_data.value("tileheight", 0));
+
+        // 4. 加载 tileset 数据：图块集之间相互独立，先在任务池上并行读取与解析，再按 firstgid 顺序映射到 gid 查找表
+        if (json_data.contains("tilesets") && json_data["tilesets"].is_array()) {
+            auto tileset_start = std::chrono::steady_clock::now();
+            auto tileset_scope = load_profile_.measure("prepare.tilesets");
+            std::vector<std::pair<std::string, int>> tileset_refs;     // (路径, firstgid)
+            for (const auto& tileset_json : json_data["tilesets"]) {
+                if (!tileset_json.contains("source") || !tileset_json["source"].is_string() ||
+                    !tileset_json.contains("firstgid") || !tileset_json["firstgid"].is_number_integer()) {
+                    spdlog::error("tilesets 对象中缺少有效 'source' 或 'firstgid' 字段。");
+                    continue;
+                }
+                tileset_refs.emplace_back(resolvePath(tileset_json["source"], map_path_), tileset_json["firstgid"].get<int>());
+            }
+            std::vector<std::shared_ptr<const engine::resource::Tileset>> tilesets(tileset_refs.size());
+            runJobs(tileset_refs.size(), [&](std::size_t i) {
+                // 图块集的解析结果与 firstgid 无关，由资源管理器跨关卡共享（缓存是线程安全的）
+                tilesets[i] = resource_manager_ ? resource_manager_->getTileset(tileset_refs[i].first) :
+                    engine::resource::Tileset::load(tileset_refs[i].first);
+            });
+            for (std::size_t i = 0; i < tileset_refs.size(); ++i) {
+                loadTileset(tileset_refs[i].first, tileset_refs[i].second, std::move(tilesets[i]));
+            }
+            spdlog::info("{} 个图块集加载完成（任务池 {} 个工作线程），耗时 {:.3f} ms", tilesets_.size(),
+                job_pool_ ? job_pool_->getWorkerCount() : 0,
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tileset_start).count());
+        }
+
+        if (!json_data.contains("layers") || !json_data["layers"].is_array()) {       // 地图文件中必须有 layers 数组
+            spdlog::error("地图文件 '{}' 中缺少或无效的 'layers' 数组。", level_path);
+            return false;
+        }
+        return true;
+    }
+
+    bool LevelLoader::prepareChunkedLayers()
+    {
+        auto start_time = std::chrono::steady_clock::now();
+        const auto& layers = map_json_["layers"];
+        const auto isChunkedLayer = [](const nlohmann::json& layer_json) {
+            return layer_json.value("type", "none") == "tilelayer" && layer_json.value("visible", true);
+        };
+
+        // 1. 分块尺寸与范围（Tiled 中同一地图的分块尺寸相同，位置按分块尺寸对齐，可以为负）
+        glm::ivec2 chunk_size(0);
+        glm::ivec2 min_tile(INT_MAX);
+        glm::ivec2 max_tile(INT_MIN);
+        for (const auto& layer_json : layers) {
+            if (!isChunkedLayer(layer_json) || !layer_json.contains("chunks") || !layer_json["chunks"].is_array()) {
+                continue;
+            }
+            for (const auto& chunk_json : layer_json["chunks"]) {
+                const glm::ivec2 position(chunk_json.value("x", 0), chunk_json.value("y", 0));
+                const glm::ivec2 size(chunk_json.value("width", 0), chunk_json.value("height", 0));
+                if (chunk_size == glm::ivec2(0)) {
+                    chunk_size = size;
+                }
+                if (size != chunk_size || size.x <= 0 || size.y <= 0 || position.x % size.x != 0 || position.y % size.y != 0) {
+                    spdlog::error("无限地图 '{}' 的图层 '{}' 中分块 ({}, {}) 的尺寸或位置无效。", map_path_,
+                        layer_json.value("name", "Unnamed"), position.x, position.y);
+                    return false;
+                }
+                min_tile = glm::min(min_tile, position);
+                max_tile = glm::max(max_tile, position + size);
+            }
+        }
+        if (chunk_size == glm::ivec2(0)) {      // 没有任何分块：空地图
+            map_size_ = { 0, 0 };
+            return true;
+        }
+        const glm::ivec2 grid_size = (max_tile - min_tile) / chunk_size;
+        map_size_ = max_tile - min_tile;
+        map_origin_ = glm::vec2(min_tile * tile_size_);
+
+        // 2. 分块在运行时才解码，事先不知道用到哪些瓦片：把所有图块集中有图片的瓦片加入调色板
+        auto gid_palette = std::make_shared<std::vector<std::uint16_t>>(gid_table_.size(), static_cast<std::uint16_t>(0));
+        for (std::size_t gid = 1; gid < gid_table_.size(); ++gid) {
+            if (const auto* entry = gid_table_[gid]; entry && !entry->texture_id.empty()) {
+                (*gid_palette)[gid] = getPaletteIndex(static_cast<int>(gid));
+            }
+        }
+
+        // 3. 每个瓦片层的分块：base64 数据保持原编码（压缩数据不解压），csv 数据转换为调色板下标
+        const auto cell_count = static_cast<std::size_t>(chunk_size.x) * static_cast<std::size_t>(chunk_size.y);
+        std::size_t encoded_bytes = 0;
+        int layer_count = 0;
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& layer_json = layers[i];
+            if (!isChunkedLayer(layer_json)) {
+                continue;
+            }
+            const std::string layer_name = layer_json.value("name", "Unnamed");
+            if (!layer_json.contains("chunks") || !layer_json["chunks"].is_array()) {
+                spdlog::error("无限地图中的图层 '{}' 缺少 'chunks' 属性。", layer_name);
+                continue;
+            }
+            const std::string compression = layer_json.value("compression", "");
+            auto gid_encoding = TileChunkSource::Encoding::GIDS;
+            if (compression == "zlib") {
+                gid_encoding = TileChunkSource::Encoding::ZLIB;
+            }
+            else if (compression == "gzip") {
+                gid_encoding = TileChunkSource::Encoding::GZIP;
+            }
+            else if (!compression.empty()) {
+                spdlog::error("图层 '{}' 的压缩方式 '{}' 不受支持（只支持 zlib 与 gzip）。", layer_name, compression);
+                continue;
+            }
+            const bool is_base64 = layer_json.value("encoding", "") == "base64";
+
+            std::vector<TileChunkSource::Chunk> chunks(static_cast<std::size_t>(grid_size.x) * static_cast<std::size_t>(grid_size.y));
+            bool is_valid = true;
+            for (const auto& chunk_json : layer_json["chunks"]) {
+                const glm::ivec2 chunk_pos = (glm::ivec2(chunk_json.value("x", 0), chunk_json.value("y", 0)) - min_tile) / chunk_size;
+                auto& chunk = chunks[static_cast<std::size_t>(chunk_pos.y) * grid_size.x + chunk_pos.x];
+                const auto data_it = chunk_json.find("data");
+                if (data_it != chunk_json.end() && data_it->is_binary() && data_it->get_binary().size() == cell_count * 4) {
+                    // csv 数据（流式解析时已转换为小端 uint32）：转换为调色板下标
+                    const auto& gids = data_it->get_binary();
+                    chunk.encoding = TileChunkSource::Encoding::PALETTE_INDICES;
+                    chunk.bytes.reserve(cell_count * 2);
+                    for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                        const auto gid = readGid(gids.data() + cell * 4);
+                        const auto index = gid < gid_palette->size() ? (*gid_palette)[gid] : std::uint16_t{ 0 };
+                        chunk.bytes.push_back(static_cast<std::uint8_t>(index & 0xFF));
+                        chunk.bytes.push_back(static_cast<std::uint8_t>(index >> 8));
+                    }
+                }
+                else if (data_it != chunk_json.end() && data_it->is_string() && is_base64) {
+                    chunk.encoding = gid_encoding;
+                    is_valid = engine::utils::decodeBase64(data_it->get_ref<const std::string&>(), chunk.bytes);
+                }
+                else {
+                    is_valid = false;
+                }
+                if (!is_valid) {
+                    spdlog::error("图层 '{}' 中分块 ({}, {}) 的数据无效。", layer_name, chunk_json.value("x", 0), chunk_json.value("y", 0));
+                    break;
+                }
+            }
+            if (!is_valid) {
+                continue;
+            }
+            auto chunk_source = std::make_shared<const TileChunkSource>(chunk_size, grid_size, std::move(chunks), gid_palette);
+            encoded_bytes += chunk_source->getEncodedBytes();
+            prepared_chunks_[i] = std::move(chunk_source);
+            ++layer_count;
+        }
+        spdlog::info("无限地图: {} 个分块瓦片层，{}x{} 个分块（每块 {}x{}），原点 ({}, {})，分块数据 {:.1f} KB，调色板 {} 项，耗时 {:.3f} ms",
+            layer_count, grid_size.x, grid_size.y, chunk_size.x, chunk_size.y, min_tile.x, min_tile.y, encoded_bytes / 1024.0,
+            tile_palette_->size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count());
         return true;
     }
 
@@ -104,7 +621,7 @@ namespace engine::scene {
         auto texture_id = resolvePath(image_path, map_path_);
 
         // 获取图层偏移量（json中没有则代表未设置，给默认值即可）
-        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f)) - map_origin_;
 
         // 获取视差因子及重复标志
         const glm::vec2 scroll_factor = glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f));
@@ -115,43 +632,114 @@ namespace engine::scene {
 
         /*  可用类似方法获取其它各种属性，这里我们暂时用不上 */
 
-        // 创建游戏对象
-        auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
-        // 依次添加Transform，Parallax组件
-        game_object->addComponent<engine::component::TransformComponent>(offset);
-        game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
-        // 添加到场景中
-        scene.addGameObject(std::move(game_object));
-        spdlog::info("加载图层: '{}' 完成", layer_name);
+        addImageLayer(scene, layer_name, texture_id, offset, scroll_factor, repeat);
     }
 
-    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, Scene& scene)
+    void LevelLoader::buildTileLayerCells()
     {
-        if (!layer_json.contains("data") || !layer_json["data"].is_array()) {
-            spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_json.value("name", "Unnamed"));
+        auto start_time = std::chrono::steady_clock::now();
+        const auto& layers = map_json_["layers"];
+        std::vector<std::size_t> layer_indices;
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            if (layers[i].value("visible", true) && layers[i].value("type", "none") == "tilelayer") {
+                layer_indices.push_back(i);
+            }
+        }
+        if (layer_indices.empty()) {
             return;
         }
-        // TileInfo Vector (瓦片数量 = 地图宽度 * 地图高度)
-        std::vector<engine::component::TileInfo> tiles;
-        tiles.reserve(map_size_.x * map_size_.y);
 
-        // 获取图层数据
-        const auto& data = layer_json["data"];
+        // 1. 并行：读取各层的 gid（base64 解码、解压），并按出现顺序记录本层第一次出现的 gid
+        struct DecodedLayer {
+            std::vector<std::uint32_t> gids;
+            std::vector<std::uint32_t> first_seen;
+            bool is_valid = false;
+        };
+        std::vector<DecodedLayer> decoded(layer_indices.size());
+        const std::size_t gid_table_size = gid_table_.size();
+        runJobs(layer_indices.size(), [&](std::size_t job) {
+            auto& layer = decoded[job];
+            std::vector<bool> is_seen(gid_table_size, false);
+            std::unordered_set<std::uint32_t> seen_outside;     // 查找表以外的 gid（按空瓦片处理，但与串行转换一样进入调色板）
+            layer.gids.reserve(static_cast<std::size_t>(map_size_.x) * static_cast<std::size_t>(map_size_.y));
+            layer.is_valid = forEachTileGid(layers[layer_indices[job]], [&](int gid) {
+                const auto value = static_cast<std::uint32_t>(gid);
+                layer.gids.push_back(value);
+                if (value < gid_table_size) {
+                    if (is_seen[value]) {
+                        return;
+                    }
+                    is_seen[value] = true;
+                }
+                else if (!seen_outside.insert(value).second) {
+                    return;
+                }
+                layer.first_seen.push_back(value);
+            });
+        });
+
+        // 2. 串行：按图层顺序把新出现的 gid 加入调色板（调色板顺序与逐格串行转换时相同）
+        std::vector<std::uint16_t> gid_palette(gid_table_size, 0);
+        for (const auto& layer : decoded) {
+            if (!layer.is_valid) {
+                continue;
+            }
+            for (const auto gid : layer.first_seen) {
+                const auto index = getPaletteIndex(static_cast<int>(gid));
+                if (gid < gid_table_size) {
+                    gid_palette[gid] = index;
+                }
+            }
+        }
 
-        // 根据gid获取必要信息，并依次填充 TileInfo Vector
-        for (const auto& gid : data) {
-            tiles.push_back(getTileInfoByGid(gid));
+        // 3. 并行：把 gid 转换为调色板下标（此时调色板与 gid -> 下标表只读）
+        std::vector<std::size_t> tile_bytes(layer_indices.size(), 0);
+        runJobs(layer_indices.size(), [&](std::size_t job) {
+            auto& layer = decoded[job];
+            if (!layer.is_valid) {
+                return;
+            }
+            auto& cells = prepared_cells_[layer_indices[job]];
+            cells.resize(layer.gids.size());
+            for (std::size_t i = 0; i < layer.gids.size(); ++i) {
+                const auto gid = layer.gids[i];
+                std::uint16_t index = 0;
+                if (gid < gid_table_size) {
+                    index = gid_palette[gid];
+                }
+                else if (auto it = palette_index_.find(static_cast<int>(gid)); it != palette_index_.end()) {
+                    index = it->second;
+                }
+                cells[i] = index;
+                tile_bytes[job] += sizeof(engine::component::TileInfo) + (*tile_palette_)[index].sprite.getTextureId().capacity();
+            }
+            std::vector<std::uint32_t>().swap(layer.gids);
+        });
+
+        for (std::size_t job = 0; job < layer_indices.size(); ++job) {
+            tile_cell_count_ += prepared_cells_[layer_indices[job]].size();
+            per_cell_tile_bytes_ += tile_bytes[job];
         }
+        tile_layer_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    }
 
-        // 获取图层名称
-        const std::string& layer_name = layer_json.value("name", "Unnamed");
-        // 创建游戏对象
-        auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
-        // 添加Tilelayer组件
-        game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, map_size_, std::move(tiles));
-        // 添加到场景中
-        scene.addGameObject(std::move(game_object));
-        spdlog::info("加载瓦片图层:'{}'完成", layer_name);
+    void LevelLoader::runJobs(std::size_t count, const std::function<void(std::size_t)>& job)
+    {
+        if (job_pool_) {
+            job_pool_->parallelFor(count, job);
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+    }
+
+    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, std::vector<std::uint16_t>&& cells, Scene& scene)
+    {
+        if (cells.empty()) {    // 准备阶段已经报告过错误
+            return;
+        }
+        addTileLayer(scene, layer_json.value("name", "Unnamed"), std::move(cells));
     }
 
     void LevelLoader::loadObjectLayer(const nlohmann::json& layer_json, Scene& scene)
@@ -162,11 +750,12 @@ namespace engine::scene {
             return;
         }
 
-
-       
         const auto& objects = layer_json["objects"];
+        // 层内深度按对象在图层中的顺序分配，同层精灵的覆盖关系与 Tiled 中一致，不受纹理句柄分配顺序影响
+        std::uint32_t object_depth = 0;
         //遍历对象数据
         for (const auto& object : objects) {
+            const auto render_depth = std::min(object_depth++, engine::render::MAX_RENDER_DEPTH - 1);
             auto gid = object.value("gid", 0);
             if (gid == 0) {
                 // 非矩形对象会有额外标识
@@ -180,205 +769,827 @@ namespace engine::scene {
                     continue;
                 } // 没有这些标识则默认是矩形对象
                 else {
-                    // --- 创建游戏对象并添加
-                    const std::string& object_name = object.value("name", "Unnamed");
-                    auto game_object = std::make_unique<engine::object::GameObject>(object_name);
-
-                    //获取Transform相关信息
-                    auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
-                    auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
-                    auto rotation = object.value("rotation", 0.0f);
-                    // 添加TransformComponent，缩放为设定为1.0f
-
-                    game_object->addComponent<engine::component::TransformComponent>(position, glm::vec2(1.0f), rotation);
-
-                    //  添加碰撞组件和物理组件 
-                       // 碰撞盒大小与dst_size相同 
-
-                    auto collider = std::make_unique<engine::physics::AABBCollider>(dst_size);
-                    auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-
                     // 自定义形状通常是trigger类型，除非显示指定 （因此默认为真）
-                    cc->setTrigger(object.value("trigger", true));
-
-                    // 添加物理组件，不受重力影响
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-
-                    // 获取标签信息并设置
-                    if (auto tag = getTileProperty<std::string>(object, "tag"); tag) {  // 如果有标签
-                        game_object->setTag(tag.value());
-                    }
-                    // 添加到场景
-                    scene.addGameObject(std::move(game_object));
-                    spdlog::info("加载对象: '{}' 完成 (类型: 自定义形状)", object_name);
-                
+                    addShapeObject(scene, object.value("name", "Unnamed"),
+                        glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f)) - map_origin_,
+                        glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f)),
+                        object.value("rotation", 0.0f), object.value("trigger", true), getTileProperty<std::string>(object, "tag"));
                 }
-                
             }
             else {
+                // 同一 gid 的对象共享预制体：瓦片属性、动画与音效表只在第一次遇到时解析
+                const glm::vec2 size(object.value("width", 0.0f), object.value("height", 0.0f));
+                addTileObject(scene, getObjectPrefab(gid, scene), object.value("name", "Unnamed"),
+                    glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f) - size.y) - map_origin_,  // 实际position需要进行调整(左下角到左上角)
+                    size, object.value("rotation", 0.0f), render_depth);
+            }
+        }
+    }
 
+    void LevelLoader::addImageLayer(Scene& scene, const std::string& name, const std::string& texture_id,
+        const glm::vec2& offset, const glm::vec2& scroll_factor, const glm::bvec2& repeat)
+    {
+        // 创建游戏对象
+        auto game_object = std::make_unique<engine::object::GameObject>(name);
+        // 依次添加Transform，Parallax组件
+        game_object->addComponent<engine::component::TransformComponent>(offset);
+        auto* parallax = game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scene.getContext().getResourceManager(), scroll_factor, repeat);
+        parallax->setRenderLayer(current_render_layer_);
+        // 添加到场景中
+        scene.addGameObject(std::move(game_object));
+        spdlog::info("加载图层: '{}' 完成", name);
+    }
 
-                auto tile_info = getTileInfoByGid(gid);
-                if (tile_info.sprite.getTextureId().empty()) {
-                    spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
-                    continue;
-                }
-
+    void LevelLoader::addTileLayer(Scene& scene, const std::string& name, std::vector<std::uint16_t>&& cells)
+    {
+        // 创建游戏对象
+        auto game_object = std::make_unique<engine::object::GameObject>(name);
+        // 添加Tilelayer组件
+        auto* tile_layer = game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, map_size_, std::move(cells), tile_palette_);
+        tile_layer->setRenderLayer(current_render_layer_);
+        // 添加到场景中
+        scene.addGameObject(std::move(game_object));
+        spdlog::info("加载瓦片图层:'{}'完成", name);
+    }
 
-                // 获取Transform相关信息
-                auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
-                auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
-                position = glm::vec2(position.x, position.y - dst_size.y);  // 实际position需要进行调整(左下角到左上角)
+    void LevelLoader::addChunkedTileLayer(Scene& scene, const std::string& name, std::shared_ptr<const TileChunkSource> chunk_source)
+    {
+        auto game_object = std::make_unique<engine::object::GameObject>(name);
+        auto* tile_layer = game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, map_size_, std::move(chunk_source), tile_palette_);
+        tile_layer->setRenderLayer(current_render_layer_);
+        scene.addGameObject(std::move(game_object));
+        spdlog::info("加载分块瓦片图层:'{}'完成", name);
+    }
 
+    void LevelLoader::addShapeObject(Scene& scene, const std::string& name, const glm::vec2& position, const glm::vec2& size,
+        float rotation, bool is_trigger, const std::optional<std::string>& tag)
+    {
+        auto instance_scope = load_profile_.measure(tag ? "build.object:" + tag.value() : std::string("build.object:shape"));
 
+        // --- 创建游戏对象并添加
+        auto game_object = std::make_unique<engine::object::GameObject>(name);
 
-                auto rotation = object.value("rotation", 0.0f);
-                auto src_size_opt = tile_info.sprite.getSourceRect();
-                if (!src_size_opt) {        // 正常情况下，所有瓦片的Sprite都设置了源矩形，没有代表某处出错
-                    spdlog::error("gid为 {} 的瓦片没有源矩形。", gid);
-                    continue;
-                }
+        // 添加TransformComponent，缩放为设定为1.0f
+        game_object->addComponent<engine::component::TransformComponent>(position, glm::vec2(1.0f), rotation);
 
-                auto src_size = glm::vec2(src_size_opt->w, src_size_opt->h);    // 成员变量除了 value().w 外，也可以这样获取
-                auto scale = dst_size / src_size;
+        //  添加碰撞组件和物理组件，碰撞盒大小与对象尺寸相同
+        auto collider = std::make_unique<engine::physics::AABBCollider>(size);
+        auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+        cc->setTrigger(is_trigger);
 
-                // 获取对象名称
-                const std::string& object_name = object.value("name", "Unnamed");
-            
+        // 添加物理组件，不受重力影响
+        game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
 
-                auto game_object = std::make_unique<engine::object::GameObject>(object_name);
-                game_object->addComponent<engine::component::TransformComponent>(position, scale, rotation);
-                game_object->addComponent<engine::component::SpriteComponent>(std::move(tile_info.sprite), scene.getContext().getResourceManager());
+        // 获取标签信息并设置
+        if (tag) {
+            game_object->setTag(tag.value());
+        }
+        // 添加到场景
+        scene.addGameObject(std::move(game_object));
+        spdlog::info("加载对象: '{}' 完成 (类型: 自定义形状)", name);
+    }
 
+    const LevelLoader::ObjectPrefab& LevelLoader::getObjectPrefab(int gid, Scene& scene)
+    {
+        if (auto it = object_prefabs_.find(gid); it != object_prefabs_.end()) {
+            return it->second;
+        }
+        auto compile_start = std::chrono::steady_clock::now();
+        auto compile_scope = load_profile_.measure("build.prefab_compile");
+        auto& prefab = object_prefabs_[gid];
+        compileObjectPrefab(gid, scene, prefab);
+        prefab_compile_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compile_start).count();
+        return prefab;
+    }
 
+    void LevelLoader::compileObjectPrefab(int gid, Scene& scene, ObjectPrefab& prefab)
+    {
+        auto tile_info = getTileInfoByGid(gid);
+        if (tile_info.sprite.getTextureId().empty()) {
+            spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
+            return;
+        }
+        if (!tile_info.sprite.getSourceRect()) {        // 正常情况下，所有瓦片的Sprite都设置了源矩形，没有代表某处出错
+            spdlog::error("gid为 {} 的瓦片没有源矩形。", gid);
+            return;
+        }
+        prefab.src_size = glm::vec2(tile_info.sprite.getSourceRect()->w, tile_info.sprite.getSourceRect()->h);
+        prefab.type = tile_info.type;
+        prefab.sprite = std::move(tile_info.sprite);
+
+        // 获取瓦片json信息（查找表中保存的是指向图块集json的指针，不复制；没有条目时使用空对象）
+        static const nlohmann::json EMPTY_TILE_JSON = nlohmann::json::object();
+        const auto* tile_json_ptr = getTileJsonByGid(gid);
+        const auto& tile_json = tile_json_ptr ? *tile_json_ptr : EMPTY_TILE_JSON;
+
+        prefab.collider = getColliderRect(tile_json);
+        prefab.tag = getTileProperty<std::string>(tile_json, "tag");
+        prefab.gravity = getTileProperty<bool>(tile_json, "gravity");
+        prefab.health = getTileProperty<int>(tile_json, "health");
+
+        // 获取动画信息
+        if (auto anim_string = getTileProperty<std::string>(tile_json, "animation"); anim_string) {
+            auto anim_start = std::chrono::steady_clock::now();
+            auto tile_key = getTileKeyByGid(gid);
+            if (!tile_key) {
+                return;
+            }
+            // 同一瓦片的剪辑只构建一次（跨关卡共享），之后的预制体直接引用
+            prefab.animation_set = scene.getContext().getResourceManager().findAnimationSet(tile_key->first, tile_key->second);
+            if (!prefab.animation_set) {
+                nlohmann::json anim_json;
+                try {
+                    anim_json = nlohmann::json::parse(anim_string.value());
+                }
+                catch (const nlohmann::json::parse_error& e) {
+                    spdlog::error("解析动画 JSON 字符串失败: {}", e.what());
+                    return;
+                }
+                prefab.animation_set = addAnimationSet(scene, tile_key->first, tile_key->second, buildAnimationClips(anim_json, prefab.src_size));
+            }
+            animation_build_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - anim_start).count();
+        }
+        //获取音效信息
+        if (auto sound_string = getTileProperty<std::string>(tile_json, "sound"); sound_string) {
+            nlohmann::json sound_json;
+            try {
+                sound_json = nlohmann::json::parse(sound_string.value());
+            }
+            catch (const nlohmann::json::parse_error& e) {
+                spdlog::error("解析音效 JSON 字符串失败: {}", e.what());
+                return;     // 该瓦片的所有对象都跳过
+            }
+            prefab.sounds = parseSoundTable(sound_json);
+        }
+        finalizePrefab(prefab);
+        prefab.is_valid = true;
+    }
 
-                // 获取瓦片json信息    
-                //  1. 必然存在，因为getTileInfoByGid(gid)函数已经顺利执行
-                // 2. 这里再获取json，实际上检索了两次，未来可以优化
-                auto tile_json = getTileJsonByGid(gid);
-                //获取碰信息：如果是SOLID类型，则添加物理组件，且图片源矩形区域就是碰撞盒大小
+    const LevelLoader::ObjectPrefab& LevelLoader::getCookedObjectPrefab(std::uint32_t tile_index, Scene& scene)
+    {
+        if (auto it = object_prefabs_.find(static_cast<int>(tile_index)); it != object_prefabs_.end()) {
+            return it->second;
+        }
+        auto compile_start = std::chrono::steady_clock::now();
+        auto compile_scope = load_profile_.measure("build.prefab_compile");
+        auto& prefab = object_prefabs_[static_cast<int>(tile_index)];
+        const auto& view = *cooked_view_;
+        const auto& tile = view.get<cooked::SectionId::TILES>()[tile_index];
+        if (tile.flags & cooked::tile_flag::INVALID_OBJECT) {    // 与 .tmj 加载相同：属性无效的瓦片不创建对象
+            return prefab;
+        }
 
+        prefab.sprite = (*tile_palette_)[tile_index].sprite;
+        prefab.src_size = glm::vec2(prefab.sprite.getSourceRect()->w, prefab.sprite.getSourceRect()->h);
+        prefab.type = static_cast<engine::component::TileType>(tile.type);
+        if (tile.flags & cooked::tile_flag::HAS_COLLIDER) {
+            prefab.collider = engine::utils::Rect(glm::vec2(tile.collider[0], tile.collider[1]), glm::vec2(tile.collider[2], tile.collider[3]));
+        }
+        if (tile.flags & cooked::tile_flag::HAS_TAG) {
+            prefab.tag = std::string(view.getString(tile.tag));
+        }
+        if (tile.flags & cooked::tile_flag::HAS_GRAVITY) {
+            prefab.gravity = (tile.flags & cooked::tile_flag::GRAVITY) != 0;
+        }
+        if (tile.flags & cooked::tile_flag::HAS_HEALTH) {
+            prefab.health = tile.health;
+        }
+        if (tile.flags & cooked::tile_flag::HAS_ANIMATION_SET) {
+            auto anim_start = std::chrono::steady_clock::now();
+            const auto& tileset_path = getCookedRuntimePath(tile.tileset);
+            prefab.animation_set = scene.getContext().getResourceManager().findAnimationSet(tileset_path, tile.local_id);
+            if (!prefab.animation_set) {
+                const auto clips = view.get<cooked::SectionId::CLIPS>();
+                const auto clip_frames = view.get<cooked::SectionId::CLIP_FRAMES>();
+                std::vector<std::unique_ptr<engine::render::Animation>> animation_clips;
+                animation_clips.reserve(tile.clip_count);
+                for (const auto& clip : clips.subspan(tile.first_clip, tile.clip_count)) {
+                    auto animation = std::make_unique<engine::render::Animation>(std::string(view.getString(clip.name)), clip.is_looping != 0);
+                    for (const auto& frame : clip_frames.subspan(clip.first_frame, clip.frame_count)) {
+                        animation->addFrame(SDL_FRect{ frame.src_rect[0], frame.src_rect[1], frame.src_rect[2], frame.src_rect[3] }, frame.duration);
+                    }
+                    animation_clips.push_back(std::move(animation));
+                }
+                prefab.animation_set = addAnimationSet(scene, tileset_path, tile.local_id, std::move(animation_clips));
+            }
+            animation_build_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - anim_start).count();
+        }
+        if (tile.flags & cooked::tile_flag::HAS_SOUNDS) {
+            auto& prefab_sounds = prefab.sounds.emplace();
+            prefab_sounds.reserve(tile.sound_count);
+            for (const auto& sound : view.get<cooked::SectionId::SOUNDS>().subspan(tile.first_sound, tile.sound_count)) {
+                prefab_sounds.emplace_back(view.getString(sound.id), view.getString(sound.path));
+            }
+        }
+        finalizePrefab(prefab);
+        prefab.is_valid = true;
+        prefab_compile_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compile_start).count();
+        return prefab;
+    }
 
-                if (tile_info.type == engine::component::TileType::SOLID)
-                {
-                    auto collider = std::make_unique<engine::physics::AABBCollider>(src_size);
-                    game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+    void LevelLoader::finalizePrefab(ObjectPrefab& prefab)
+    {
+        // 与 addTileObject 添加组件的规则一致：Transform + Sprite，碰撞体 + 物理（或只因 gravity 添加物理），动画、音效、生命值
+        const bool has_collider = prefab.type == engine::component::TileType::SOLID || prefab.collider.has_value();
+        prefab.component_count = 2 + (has_collider ? 2 : (prefab.gravity ? 1 : 0)) +
+            (prefab.animation_set ? 1 : 0) + (prefab.sounds ? 1 : 0) + (prefab.health ? 1 : 0);
+
+        // 加载报告按对象类型（与 addTileObject 设置标签的规则一致）汇总实例化耗时
+        std::string object_type = "tile";
+        if (prefab.tag) {
+            object_type = prefab.tag.value();
+        }
+        else if (prefab.type == engine::component::TileType::SOLID) {
+            object_type = "solid";
+        }
+        else if (prefab.type == engine::component::TileType::HAZARD) {
+            object_type = "hazard";
+        }
+        prefab.profile_phase = "build.object:" + object_type;
+    }
 
-                    //物理组件不受重力影响
+    void LevelLoader::addTileObject(Scene& scene, const ObjectPrefab& prefab, const std::string& name,
+        const glm::vec2& position, const glm::vec2& size, float rotation, std::uint32_t render_depth)
+    {
+        if (!prefab.is_valid) {     // 编译预制体时已经报告过原因
+            spdlog::error("对象 '{}' 的瓦片属性无效，跳过。", name);
+            return;
+        }
+        auto instance_start = std::chrono::steady_clock::now();
+        auto instance_scope = load_profile_.measure(prefab.profile_phase);
+        auto game_object = std::make_unique<engine::object::GameObject>(name);
+        game_object->reserveComponents(prefab.component_count);
+        game_object->addComponent<engine::component::TransformComponent>(position, size / prefab.src_size, rotation);
+        auto* sprite_component = game_object->addComponent<engine::component::SpriteComponent>(engine::render::Sprite(prefab.sprite), scene.getContext().getResourceManager());
+        sprite_component->setRenderLayer(current_render_layer_);
+        sprite_component->setRenderDepth(render_depth);
+
+        //获取碰信息：如果是SOLID类型，则添加物理组件，且图片源矩形区域就是碰撞盒大小
+        engine::component::PhysicsComponent* pc = nullptr;
+        if (prefab.type == engine::component::TileType::SOLID)
+        {
+            auto collider = std::make_unique<engine::physics::AABBCollider>(prefab.src_size);
+            game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
 
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
+            //物理组件不受重力影响
+            pc = game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
+        }
+        else if (prefab.collider)
+        {
+            auto collider = std::make_unique<engine::physics::AABBCollider>(prefab.collider->size);
+            auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+            cc->setOffset(prefab.collider->position);
+            // 自定义碰撞盒的坐标是相对于图片坐标，也就是针对Transform的偏移量
 
+            //物理组件
+            pc = game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
+        }
 
-                    //设置标签方便物理引擎检索
+        // 标签：自定义标签优先，其次是 SOLID 的 "solid"、危险瓦片的 "hazard"
+        if (prefab.tag) {
+            game_object->setTag(prefab.tag.value());
+        }
+        else if (prefab.type == engine::component::TileType::SOLID) {
+            game_object->setTag("solid");   // 方便物理引擎检索
+        }
+        else if (prefab.type == engine::component::TileType::HAZARD) {
+            game_object->setTag("hazard");
+        }
 
-                    game_object->setTag("solid");
+        // 获取重力信息并设置
+        if (prefab.gravity) {
+            if (pc) {
+                pc->setUseGravity(prefab.gravity.value());
+            }
+            else
+            {
+                spdlog::warn("对象 '{}' 在设置重力信息时没有物理组件，请检查地图设置。", name);
+                game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), prefab.gravity.value());
+            }
+        }
+        // 设置共享的动画剪辑集
+        if (prefab.animation_set) {
+            auto* ac = game_object->addComponent<engine::component::AnimationComponent>(&scene.getContext().getAnimationSystem());
+            ac->setAnimationSet(prefab.animation_set);
+            ++animated_object_count_;
+        }
+        // 添加AudioComponent及音效
+        if (prefab.sounds) {
+            auto* audio_component = game_object->addComponent<engine::component::AudioComponent>(&scene.getContext().getAudioPlayer(),
+                &scene.getContext().getCamera());
+            for (const auto& [sound_id, sound_path] : prefab.sounds.value()) {
+                audio_component->addSound(sound_id, sound_path);
+            }
+        }
 
+        // 获取生命值信息并设置
+        if (prefab.health) {
+            game_object->addComponent<engine::component::HealthComponent>(prefab.health.value());
+        }
 
-                }
-                else
-                    if (auto rect = getColliderRect(tile_json);rect)
-                    {
-                        auto collider = std::make_unique<engine::physics::AABBCollider>(rect->size);
-                      
-                        auto *cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-                        cc->setOffset(rect->position);
-                        // 自定义碰撞盒的坐标是相对于图片坐标，也就是针对Transform的偏移量
+        // 添加到场景中
+        scene.addGameObject(std::move(game_object));
+        ++object_instance_count_;
+        object_instance_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - instance_start).count();
+        spdlog::info("加载对象: '{}' 完成", name);
+    }
 
-                        //物理组件
+    const engine::resource::AnimationSet* LevelLoader::addAnimationSet(Scene& scene, const std::string& tileset_path, int local_id,
+        std::vector<std::unique_ptr<engine::render::Animation>>&& clips)
+    {
+        for (const auto& clip : clips) {
+            animation_frames_built_ += clip->getFrameCount();
+        }
+        ++animation_sets_built_;
+        return scene.getContext().getResourceManager().addAnimationSet(tileset_path, local_id, std::move(clips));
+    }
 
-                        game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
+    std::string LevelLoader::getCookedPath(const std::string& map_path)
+    {
+        return std::filesystem::path(map_path).replace_extension(cooked::FILE_EXTENSION).string();
+    }
 
+    bool LevelLoader::cookLevel(const std::string& map_path, const std::string& output_path)
+    {
+        auto start_time = std::chrono::steady_clock::now();
+        releasePreparedLevel();
+        animation_system_ = nullptr;    // 烘焙时只读取瓦片动画，不登记到 AnimationSystem
+        texture_source_ = nullptr;
+        nlohmann::json json_data;
+        if (!loadMapJson(map_path, json_data)) {
+            return false;
+        }
+        if (json_data.value("infinite", false)) {
+            spdlog::error("无限地图 '{}' 不支持烘焙。", map_path);
+            return false;
+        }
 
-                    }
+        cooked::LevelWriter writer;
+        writer.setMapInfo(map_size_.x, map_size_.y, tile_size_.x, tile_size_.y);
+        writer.addSource(toPortablePath(map_path));
+        for (const auto& tileset : tilesets_) {
+            writer.addSource(toPortablePath(tileset.file_path));
+        }
+        writer.tiles.emplace_back();    // 下标 0：空瓦片
+        std::unordered_map<int, std::uint32_t> tile_indices;
 
-                auto tag = getTileProperty<std::string>(tile_json, "tag");
-                if (tag) {
+        int layer_index = 0;
+        for (const auto& layer_json : json_data["layers"]) {
+            const auto render_layer = static_cast<std::uint8_t>(std::min<int>(
+                engine::render::render_layer::MAP_BASE + layer_index++, engine::render::render_layer::MAP_MAX));
+            if (!layer_json.value("visible", true)) {
+                continue;
+            }
+            const std::string layer_type = layer_json.value("type", "none");
+            const std::string layer_name = layer_json.value("name", "Unnamed");
+            cooked::Layer layer;
+            layer.name = writer.addString(layer_name);
+            layer.render_layer = render_layer;
 
-                    game_object->setTag(tag.value());
-                }// 如果是危险瓦片，且没有手动设置标签，则自动设置标签为 "hazard"
-                else 
-                    if(tile_info.type==engine::component::TileType::HAZARD)
-                    {
-                        game_object->setTag("hazard");
+            if (layer_type == "imagelayer") {
+                const std::string image_path = layer_json.value("image", "");
+                if (image_path.empty()) {
+                    spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_name);
+                    continue;
                 }
-
-                // 获取重力信息并设置
-                auto gravity= getTileProperty<bool>(tile_json, "gravity");
-                if (gravity) {
-                    auto pc = game_object->getComponent<engine::component::PhysicsComponent>();
-                    if (pc) {
-                        pc->setUseGravity(gravity.value());
+                layer.kind = cooked::LayerKind::IMAGE;
+                layer.texture_id = writer.addString(toPortablePath(resolvePath(image_path, map_path_)));
+                layer.offset[0] = layer_json.value("offsetx", 0.0f);
+                layer.offset[1] = layer_json.value("offsety", 0.0f);
+                layer.scroll_factor[0] = layer_json.value("parallaxx", 1.0f);
+                layer.scroll_factor[1] = layer_json.value("parallaxy", 1.0f);
+                layer.repeat_x = layer_json.value("repeatx", false) ? 1 : 0;
+                layer.repeat_y = layer_json.value("repeaty", false) ? 1 : 0;
+            }
+            else if (layer_type == "tilelayer") {
+                layer.kind = cooked::LayerKind::TILE;
+                layer.first = static_cast<std::uint32_t>(writer.cells.size());
+                const bool is_valid = forEachTileGid(layer_json, [&](int gid) {
+                    writer.cells.push_back(static_cast<std::uint16_t>(cookTile(gid, writer, tile_indices)));
+                });
+                if (!is_valid) {
+                    writer.cells.resize(layer.first);
+                    continue;
+                }
+                layer.count = static_cast<std::uint32_t>(writer.cells.size() - layer.first);
+            }
+            else if (layer_type == "objectgroup") {
+                if (!layer_json.contains("objects") || !layer_json["objects"].is_array()) {
+                    spdlog::error("对象图层'{}'缺少'objects''属性'", layer_name);
+                    continue;
+                }
+                layer.kind = cooked::LayerKind::OBJECT;
+                layer.first = static_cast<std::uint32_t>(writer.objects.size());
+                for (const auto& object : layer_json["objects"]) {
+                    cooked::Object record;
+                    record.name = writer.addString(object.value("name", "Unnamed"));
+                    record.position[0] = object.value("x", 0.0f);
+                    record.position[1] = object.value("y", 0.0f);
+                    record.size[0] = object.value("width", 0.0f);
+                    record.size[1] = object.value("height", 0.0f);
+                    record.rotation = object.value("rotation", 0.0f);
+                    if (const int gid = object.value("gid", 0); gid == 0) {
+                        // 只支持矩形对象
+                        if (object.value("point", false) || object.value("ellipse", false) || object.value("polygon", false)) {
+                            continue;
+                        }
+                        record.is_trigger = object.value("trigger", true) ? 1 : 0;
+                        if (auto tag = getTileProperty<std::string>(object, "tag"); tag) {
+                            record.has_tag = 1;
+                            record.tag = writer.addString(tag.value());
+                        }
                     }
-                    else
-                    {
-                        spdlog::warn("对象 '{}' 在设置重力信息时没有物理组件，请检查地图设置。", object_name);
-                        game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), gravity.value());
+                    else {
+                        record.tile = cookTile(gid, writer, tile_indices);
+                        if (record.tile == 0) {
+                            spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
+                            continue;
+                        }
                     }
+                    writer.objects.push_back(record);
+                }
+                layer.count = static_cast<std::uint32_t>(writer.objects.size() - layer.first);
+            }
+            else {
+                spdlog::warn("不支持的图层类型: {}", layer_type);
+                continue;
+            }
+            writer.layers.push_back(layer);
+        }
 
+        const auto cooked_path = output_path.empty() ? getCookedPath(map_path) : output_path;
+        if (!writer.write(cooked_path)) {
+            return false;
+        }
+        spdlog::info("关卡烘焙完成: '{}' -> '{}'，耗时 {:.3f} ms", map_path, cooked_path,
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count());
+        return true;
+    }
+
+    std::uint32_t LevelLoader::cookTile(int gid, cooked::LevelWriter& writer, std::unordered_map<int, std::uint32_t>& tile_indices)
+    {
+        if (gid == 0) {
+            return 0;
+        }
+        if (auto it = tile_indices.find(gid); it != tile_indices.end()) {
+            return it->second;
+        }
+        const auto* entry = findTile(gid);
+        if (!entry || entry->texture_id.empty()) {      // 与 getTileInfoByGid 相同：按空瓦片处理
+            if (!entry) {
+                spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
+            }
+            tile_indices.emplace(gid, 0u);
+            return 0;
+        }
+        if (writer.tiles.size() > UINT16_MAX) {     // 瓦片表同时也是调色板，下标必须能放进 uint16
+            spdlog::error("烘焙瓦片表已满（{} 项），gid为 {} 的瓦片按空瓦片处理。", writer.tiles.size(), gid);
+            tile_indices.emplace(gid, 0u);
+            return 0;
+        }
+        // 先占位再处理动画帧：帧引用的瓦片可能反过来引用当前瓦片
+        const auto index = static_cast<std::uint32_t>(writer.tiles.size());
+        tile_indices.emplace(gid, index);
+        writer.tiles.emplace_back();
+
+        const auto& tileset = findTileset(gid);
+        cooked::Tile tile;
+        tile.texture_id = writer.addString(toPortablePath(entry->texture_id));
+        tile.tileset = writer.addString(toPortablePath(tileset.file_path));
+        tile.src_rect[0] = entry->src_rect.x;
+        tile.src_rect[1] = entry->src_rect.y;
+        tile.src_rect[2] = entry->src_rect.w;
+        tile.src_rect[3] = entry->src_rect.h;
+        tile.local_id = entry->local_id;
+        tile.type = static_cast<std::uint8_t>(entry->type);
+
+        if (entry->json) {
+            const auto& tile_json = *entry->json;
+            if (auto rect = getColliderRect(tile_json); rect) {
+                tile.flags |= cooked::tile_flag::HAS_COLLIDER;
+                tile.collider[0] = rect->position.x;
+                tile.collider[1] = rect->position.y;
+                tile.collider[2] = rect->size.x;
+                tile.collider[3] = rect->size.y;
+            }
+            if (auto tag = getTileProperty<std::string>(tile_json, "tag"); tag) {
+                tile.flags |= cooked::tile_flag::HAS_TAG;
+                tile.tag = writer.addString(tag.value());
+            }
+            if (auto gravity = getTileProperty<bool>(tile_json, "gravity"); gravity) {
+                tile.flags |= cooked::tile_flag::HAS_GRAVITY;
+                if (gravity.value()) {
+                    tile.flags |= cooked::tile_flag::GRAVITY;
                 }
-                // 获取动画信息并设置
-                auto anim_string = getTileProperty<std::string>(tile_json, "animation");
-                if (anim_string)
-                {
-                    nlohmann::json anim_json;
+            }
+            if (auto health = getTileProperty<int>(tile_json, "health"); health) {
+                tile.flags |= cooked::tile_flag::HAS_HEALTH;
+                tile.health = health.value();
+            }
 
-                    try {
-                        anim_json = nlohmann::json::parse(anim_string.value());
+            // 对象动画剪辑：预先解析为帧表
+            if (auto anim_string = getTileProperty<std::string>(tile_json, "animation"); anim_string) {
+                try {
+                    const auto anim_json = nlohmann::json::parse(anim_string.value());
+                    const auto clips = buildAnimationClips(anim_json, glm::vec2(entry->src_rect.w, entry->src_rect.h));
+                    tile.flags |= cooked::tile_flag::HAS_ANIMATION_SET;
+                    tile.first_clip = static_cast<std::uint32_t>(writer.clips.size());
+                    tile.clip_count = static_cast<std::uint32_t>(clips.size());
+                    for (const auto& clip : clips) {
+                        cooked::Clip record;
+                        record.name = writer.addString(clip->getName());
+                        record.first_frame = static_cast<std::uint32_t>(writer.clip_frames.size());
+                        record.frame_count = static_cast<std::uint32_t>(clip->getFrameCount());
+                        record.is_looping = clip->isLooping() ? 1 : 0;
+                        for (const auto& frame : clip->getFrames()) {
+                            writer.clip_frames.push_back({ { frame.source_rect.x, frame.source_rect.y, frame.source_rect.w, frame.source_rect.h }, frame.duration });
+                        }
+                        writer.clips.push_back(record);
                     }
-                    catch (const nlohmann::json::parse_error& e)
-                    {
-                        spdlog::error("解析动画 JSON 字符串失败: {}", e.what());
-                        continue;
+                }
+                catch (const nlohmann::json::parse_error& e) {
+                    spdlog::error("解析动画 JSON 字符串失败: {}", e.what());
+                    tile.flags |= cooked::tile_flag::INVALID_OBJECT;
+                }
+            }
+
+            // 音效表
+            if (auto sound_string = getTileProperty<std::string>(tile_json, "sound"); sound_string) {
+                try {
+                    const auto sounds = parseSoundTable(nlohmann::json::parse(sound_string.value()));
+                    tile.flags |= cooked::tile_flag::HAS_SOUNDS;
+                    tile.first_sound = static_cast<std::uint32_t>(writer.sounds.size());
+                    tile.sound_count = static_cast<std::uint32_t>(sounds.size());
+                    for (const auto& [sound_id, sound_path] : sounds) {
+                        writer.sounds.push_back({ writer.addString(sound_id), writer.addString(sound_path) });
                     }
+                }
+                catch (const nlohmann::json::parse_error& e) {
+                    spdlog::error("解析音效 JSON 字符串失败: {}", e.what());
+                    tile.flags |= cooked::tile_flag::INVALID_OBJECT;
+                }
+            }
 
-                    auto* ac = game_object->addComponent<engine::component::AnimationComponent>();
+            // Tiled 瓦片动画：帧引用瓦片表中的瓦片（递归烘焙），先收集再整体写入，保证帧连续
+            if (tile_json.contains("animation") && tile_json["animation"].is_array()) {
+                std::vector<cooked::TileFrame> frames;
+                frames.reserve(tile_json["animation"].size());
+                for (const auto& frame_json : tile_json["animation"]) {
+                    const int frame_id = frame_json.value("tileid", -1);
+                    const auto frame_tile = frame_id >= 0 && frame_id < tileset.tile_count ? cookTile(tileset.first_gid + frame_id, writer, tile_indices) : 0;
+                    if (frame_tile == 0) {
+                        spdlog::warn("图块集 '{}' 中瓦片 {} 的动画帧 {} 无效，按静态瓦片处理。", tileset.file_path, entry->local_id, frame_id);
+                        frames.clear();
+                        break;
+                    }
+                    frames.push_back({ frame_tile, static_cast<float>(frame_json.value("duration", 100)) / 1000.0f });     // Tiled 中单位为毫秒
+                }
+                tile.first_tile_frame = static_cast<std::uint32_t>(writer.tile_frames.size());
+                tile.tile_frame_count = static_cast<std::uint32_t>(frames.size());
+                writer.tile_frames.insert(writer.tile_frames.end(), frames.begin(), frames.end());
+            }
+        }
+        writer.tiles[index] = tile;
+        return index;
+    }
 
-                    addAnimation(anim_json, ac, src_size);
+    bool LevelLoader::prepareCookedLevel(const std::string& cooked_path)
+    {
+        auto view_ptr = std::make_unique<cooked::LevelView>();
+        auto& view = *view_ptr;
+        {
+            auto read_scope = load_profile_.measure("prepare.file_read");
+            if (!view.open(cooked_path)) {
+                return false;
+            }
+        }
+        const auto& header = view.getHeader();
+        const auto sources = view.get<cooked::SectionId::SOURCES>();
+        const auto tiles = view.get<cooked::SectionId::TILES>();
+        const auto tile_frames = view.get<cooked::SectionId::TILE_FRAMES>();
+        const auto clips = view.get<cooked::SectionId::CLIPS>();
+        const auto clip_frames = view.get<cooked::SectionId::CLIP_FRAMES>();
+        const auto sounds = view.get<cooked::SectionId::SOUNDS>();
+        const auto layers = view.get<cooked::SectionId::LAYERS>();
+        const auto cells = view.get<cooked::SectionId::CELLS>();
+        const auto objects = view.get<cooked::SectionId::OBJECTS>();
 
+        {
+            auto validate_scope = load_profile_.measure("prepare.validate");
+            // 1. 任一源文件比烘焙文件新时视为过期
+            std::error_code ec;
+            const auto cooked_time = std::filesystem::last_write_time(cooked_path, ec);
+            if (ec) {
+                return false;
+            }
+            for (const auto& source : sources) {
+                const auto source_path = std::filesystem::path(view.getString(source));
+                const auto source_time = std::filesystem::last_write_time(source_path, ec);
+                if (!ec && source_time > cooked_time) {
+                    spdlog::info("'{}' 比烘焙关卡 '{}' 新，需要重新烘焙。", source_path.string(), cooked_path);
+                    return false;
                 }
-                //获取音效信息并设置
-                auto sound_string = getTileProperty<std::string>(tile_json, "sound");
-                if (sound_string)
-                {
-                    nlohmann::json sound_json;
-                    try {
-                        sound_json = nlohmann::json::parse(sound_string.value());
-                    }
-                    catch (const nlohmann::json::parse_error& e)
-                    {
-                        spdlog::error("解析音效 JSON 字符串失败: {}", e.what());
-                        continue;// 跳过此对象
-                    }
+            }
 
-                    // 添加AudioComponent
-                    auto* audio_component = game_object->addComponent<engine::component::AudioComponent>(&scene.getContext().getAudioPlayer(),
-                        &scene.getContext().getCamera());
-                    // 添加音效到 AudioComponent
-                    addSound(sound_json, audio_component);
+            // 2. 先校验所有引用的范围，构建场景的过程中不再失败，避免留下半个场景
+            const auto in_range = [](std::uint32_t first, std::uint32_t count, std::size_t size) {
+                return first <= size && count <= size - first;
+            };
+            bool is_valid = !tiles.empty() && tiles.size() <= static_cast<std::size_t>(UINT16_MAX) + 1;
+            for (std::size_t i = 1; is_valid && i < tiles.size(); ++i) {
+                const auto& tile = tiles[i];
+                is_valid = in_range(tile.first_tile_frame, tile.tile_frame_count, tile_frames.size())
+                    && in_range(tile.first_clip, tile.clip_count, clips.size())
+                    && in_range(tile.first_sound, tile.sound_count, sounds.size());
+            }
+            for (const auto& frame : tile_frames) {
+                is_valid = is_valid && frame.tile > 0 && frame.tile < tiles.size();
+            }
+            for (const auto& clip : clips) {
+                is_valid = is_valid && in_range(clip.first_frame, clip.frame_count, clip_frames.size());
+            }
+            const auto layer_cell_count = static_cast<std::size_t>(header.map_width) * static_cast<std::size_t>(header.map_height);
+            for (const auto& layer : layers) {
+                if (layer.kind == cooked::LayerKind::TILE) {
+                    is_valid = is_valid && in_range(layer.first, layer.count, cells.size()) && layer.count == layer_cell_count;
                 }
+                else if (layer.kind == cooked::LayerKind::OBJECT) {
+                    is_valid = is_valid && in_range(layer.first, layer.count, objects.size());
+                }
+            }
+            for (const auto& object : objects) {
+                is_valid = is_valid && object.tile < tiles.size();
+            }
+            is_valid = is_valid && std::all_of(cells.begin(), cells.end(), [&](std::uint16_t cell) { return cell < tiles.size(); });
+            if (!is_valid) {
+                spdlog::warn("烘焙关卡 '{}' 的内容无效，可能已损坏。", cooked_path);
+                return false;
+            }
+        }
 
+        // 3. 重置加载状态
+        animated_object_count_ = 0;
+        animation_sets_built_ = 0;
+        animation_frames_built_ = 0;
+        animation_build_ms_ = 0.0;
+        object_prefabs_.clear();
+        object_instance_count_ = 0;
+        prefab_compile_ms_ = 0.0;
+        object_instance_ms_ = 0.0;
+        map_path_.clear();
+        tilesets_.clear();
+        gid_table_.clear();
+        palette_index_.clear();
+        tile_cell_count_ = 0;
+        per_cell_tile_bytes_ = 0;
+        tile_layer_ms_ = 0.0;
+        map_size_ = glm::ivec2(header.map_width, header.map_height);
+        tile_size_ = glm::ivec2(header.tile_width, header.tile_height);
+
+        cooked_view_ = std::move(view_ptr);
+        cooked_paths_.clear();
+
+        // 4. 瓦片表直接作为调色板（瓦片动画在构建阶段登记）
+        auto palette_scope = load_profile_.measure("prepare.tile_palette");
+        auto palette = std::make_shared<std::vector<engine::component::TileInfo>>();
+        palette->reserve(tiles.size());
+        palette->emplace_back();    // 下标 0：空瓦片
+        for (std::size_t i = 1; i < tiles.size(); ++i) {
+            const auto& tile = tiles[i];
+            palette->emplace_back(engine::render::Sprite(getCookedRuntimePath(tile.texture_id),
+                SDL_FRect{ tile.src_rect[0], tile.src_rect[1], tile.src_rect[2], tile.src_rect[3] }),
+                static_cast<engine::component::TileType>(tile.type));
+        }
+        tile_palette_ = std::move(palette);
 
-                // 获取生命值信息并设置
-                auto health = getTileProperty<int>(tile_json, "health");
-                if (health) {
-                    game_object->addComponent<engine::component::HealthComponent>(health.value());
+        // 5. 记录需要预先解码的纹理与音效
+        std::set<std::string> texture_paths;
+        for (std::size_t i = 1; i < tile_palette_->size(); ++i) {
+            texture_paths.insert((*tile_palette_)[i].sprite.getTextureId());
+        }
+        for (const auto& layer : layers) {
+            if (layer.kind == cooked::LayerKind::IMAGE) {
+                texture_paths.insert(getCookedRuntimePath(layer.texture_id));
+            }
+        }
+        std::set<std::string> sound_paths;
+        for (const auto& sound : sounds) {
+            sound_paths.emplace(view.getString(sound.path));
+        }
+        texture_paths_.assign(texture_paths.begin(), texture_paths.end());
+        sound_paths_.assign(sound_paths.begin(), sound_paths.end());
+        cooked_path_ = cooked_path;
+        return true;
+    }
+
+    bool LevelLoader::buildCookedLevel(Scene& scene)
+    {
+        auto start_time = std::chrono::steady_clock::now();
+        const auto& view = *cooked_view_;
+        const auto tiles = view.get<cooked::SectionId::TILES>();
+        const auto tile_frames = view.get<cooked::SectionId::TILE_FRAMES>();
+        const auto layers = view.get<cooked::SectionId::LAYERS>();
+        const auto cells = view.get<cooked::SectionId::CELLS>();
+        const auto objects = view.get<cooked::SectionId::OBJECTS>();
+        animation_system_ = &scene.getContext().getAnimationSystem();
+        auto& palette = *tile_palette_;
+        resolveTileTextures(scene);     // 动画帧复制调色板中的精灵，句柄随之带上
+
+        // 1. 登记瓦片动画（AnimationSystem 只在游戏线程上使用）
+        {
+            auto animation_scope = load_profile_.measure("build.tile_animations");
+            for (std::size_t i = 1; i < tiles.size(); ++i) {
+                const auto& tile = tiles[i];
+                if (tile.tile_frame_count == 0) {
+                    continue;
                 }
+                const auto& tileset_path = getCookedRuntimePath(tile.tileset);
+                int animation_index = animation_system_->findTileAnimation(tileset_path, tile.local_id);
+                if (animation_index < 0) {
+                    std::vector<engine::render::Sprite> frames;
+                    std::vector<float> durations;
+                    frames.reserve(tile.tile_frame_count);
+                    durations.reserve(tile.tile_frame_count);
+                    for (const auto& frame : tile_frames.subspan(tile.first_tile_frame, tile.tile_frame_count)) {
+                        frames.push_back(palette[frame.tile].sprite);
+                        durations.push_back(frame.duration);
+                    }
+                    animation_index = animation_system_->registerTileAnimation(tileset_path, tile.local_id, std::move(frames), durations);
+                }
+                palette[i].animation_index = animation_index;
+            }
+        }
 
-                // 添加到场景中
-                scene.addGameObject(std::move(game_object));
-                spdlog::info("加载对象: '{}' 完成", object_name);
-            
+        // 2. 按顺序创建图层
+        for (const auto& layer : layers) {
+            current_render_layer_ = layer.render_layer;
+            const std::string layer_name(view.getString(layer.name));
+            auto layer_scope = load_profile_.measure("build.layer:" + layer_name);
+            switch (layer.kind) {
+            case cooked::LayerKind::IMAGE:
+                addImageLayer(scene, layer_name, getCookedRuntimePath(layer.texture_id),
+                    glm::vec2(layer.offset[0], layer.offset[1]), glm::vec2(layer.scroll_factor[0], layer.scroll_factor[1]),
+                    glm::bvec2(layer.repeat_x != 0, layer.repeat_y != 0));
+                break;
+            case cooked::LayerKind::TILE: {
+                const auto layer_cells = cells.subspan(layer.first, layer.count);
+                tile_cell_count_ += layer_cells.size();
+                addTileLayer(scene, layer_name, std::vector<std::uint16_t>(layer_cells.begin(), layer_cells.end()));
+                break;
+            }
+            case cooked::LayerKind::OBJECT: {
+                std::uint32_t object_depth = 0;     // 与 .tmj 加载相同，按对象在图层中的顺序分配层内深度
+                for (const auto& object : objects.subspan(layer.first, layer.count)) {
+                    const auto render_depth = std::min(object_depth++, engine::render::MAX_RENDER_DEPTH - 1);
+                    const glm::vec2 position(object.position[0], object.position[1]);
+                    const glm::vec2 size(object.size[0], object.size[1]);
+                    std::string object_name(view.getString(object.name));
+                    if (object.tile == 0) {
+                        addShapeObject(scene, object_name, position, size, object.rotation, object.is_trigger != 0,
+                            object.has_tag ? std::optional<std::string>(view.getString(object.tag)) : std::nullopt);
+                        continue;
+                    }
+                    addTileObject(scene, getCookedObjectPrefab(object.tile, scene), object_name,
+                        glm::vec2(position.x, position.y - size.y), size, object.rotation, render_depth);    // 左下角到左上角
+                }
+                break;
             }
+            }
+        }
 
+        if (animated_object_count_ > 0) {
+            spdlog::info("动画剪辑: {} 个对象共享剪辑集，本次新建 {} 个剪辑集（{} 帧），剪辑库共 {} 个剪辑集，耗时 {:.3f} ms",
+                animated_object_count_, animation_sets_built_, animation_frames_built_,
+                scene.getContext().getResourceManager().getAnimationSetCount(), animation_build_ms_);
+        }
+        if (object_instance_count_ > 0) {
+            spdlog::info("瓦片对象: {} 个对象来自 {} 个预制体，编译 {:.3f} ms，实例化 {:.3f} ms（平均每个对象 {:.2f} us）",
+                object_instance_count_, object_prefabs_.size(), prefab_compile_ms_, object_instance_ms_,
+                object_instance_ms_ * 1000.0 / object_instance_count_);
+        }
+        spdlog::info("烘焙关卡加载完成: '{}'（{} 个瓦片，{} 个格子，{} 个对象），耗时 {:.3f} ms", cooked_path_,
+            tiles.size() - 1, tile_cell_count_, objects.size(),
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count());
+        return true;
+    }
 
+    const std::string& LevelLoader::getCookedRuntimePath(const cooked::StringRef& ref)
+    {
+        // 烘焙文件中的路径相对于工作目录，转换为与 .tmj 加载相同的规范路径，保证纹理、动画等共享资源的键一致
+        auto [it, is_new] = cooked_paths_.try_emplace(ref.offset);
+        if (is_new) {
+            it->second = toRuntimePath(cooked_view_->getString(ref));
         }
+        return it->second;
     }
-    void LevelLoader::addAnimation(const nlohmann::json& anim_json, engine::component::AnimationComponent* ac, const glm::vec2& sprite_size)
+
+    std::vector<std::unique_ptr<engine::render::Animation>> LevelLoader::buildAnimationClips(const nlohmann::json& anim_json, const glm::vec2& sprite_size)
     {
-        if (!anim_json.is_object() || !ac)
+        std::vector<std::unique_ptr<engine::render::Animation>> clips;
+        if (!anim_json.is_object())
         {
-            spdlog::error("无效的动画 JSON 或 AnimationComponent 指针。");
-            return;
+            spdlog::error("无效的动画 JSON。");
+            return clips;
         }
         // 遍历动画 JSON 对象中的每个键值对
         for (const auto& anim : anim_json.items())
@@ -418,31 +1629,32 @@ namespace engine::scene {
                 // 添加动画帧到 Animation
                 animation->addFrame(src_rect, duration);
             }
-            // 将 Animation 对象添加到 AnimationComponent 中
-            ac->addAnimation(std::move(animation));
+            // 将 Animation 对象添加到剪辑列表中
+            clips.push_back(std::move(animation));
 
         }
-
+        return clips;
     }
-    void LevelLoader::addSound(const nlohmann::json& sound_json, engine::component::AudioComponent* audio_component)
+    std::vector<std::pair<std::string, std::string>> LevelLoader::parseSoundTable(const nlohmann::json& sound_json)
     {
-        if (!sound_json.is_object() || !audio_component)
+        std::vector<std::pair<std::string, std::string>> sounds;
+        if (!sound_json.is_object())
         {
-            spdlog::error("无效的音效 JSON 或 AudioComponent 指针。");
-            return;
+            spdlog::error("无效的音效 JSON。");
+            return sounds;
         }
 
         for (const auto& sound : sound_json.items()) {
 
             const std::string& sound_id = sound.key();
-            const std::string& sound_path = sound.value();
+            const std::string sound_path = sound.value().is_string() ? sound.value().get<std::string>() : std::string();
             if (sound_id.empty() || sound_path.empty()) {
                 spdlog::warn("音效 '{}' 缺少必要信息。", sound_id);
                 continue;
             }
-            // 添加音效到 AudioComponent
-            audio_component->addSound(sound_id, sound_path);
+            sounds.emplace_back(sound_id, sound_path);
         }
+        return sounds;
     }
     std::optional<engine::utils::Rect> LevelLoader::getColliderRect(const nlohmann::json& tile_json)
     {
@@ -470,202 +1682,131 @@ namespace engine::scene {
         if (gid == 0) {
             return engine::component::TileInfo();
         }
-
-        // upper_bound：查找tileset_data_中键大于 gid 的第一个元素，返回迭代器
-        auto tileset_it = tileset_data_.upper_bound(gid);
-        if (tileset_it == tileset_data_.begin()) {
+        const auto* entry = findTile(gid);
+        if (!entry) {
             spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
             return engine::component::TileInfo();
         }
-        --tileset_it;  // 前移一个位置，这样就得到不大于gid的最近一个元素（我们需要的）
-
-        const auto& tileset = tileset_it->second;
-        auto local_id = gid - tileset_it->first;        // 计算瓦片在图块集中的局部ID
-        const std::string file_path = tileset.value("file_path", "");       // 获取图块集文件路径
-        if (file_path.empty()) {
-            spdlog::error("Tileset 文件 '{}' 缺少 'file_path' 属性。", tileset_it->first);
+        if (entry->texture_id.empty()) {    // 多图片图块集中没有图片的瓦片（构建查找表时已经报告过）
             return engine::component::TileInfo();
         }
-        // 图块集分为两种情况，需要分别考虑
-        if (tileset.contains("image")) {    // 这是单一图片的情况
-            // 获取图片路径
-            auto texture_id = resolvePath(tileset["image"].get<std::string>(), file_path);
-            // 计算瓦片在图片网格中的坐标
-            auto coordinate_x = local_id % tileset["columns"].get<int>();
-            auto coordinate_y = local_id / tileset["columns"].get<int>();
-            // 根据坐标确定源矩形
-            SDL_FRect texture_rect = {
-                static_cast<float>(coordinate_x * tile_size_.x),
-                static_cast<float>(coordinate_y * tile_size_.y),
-                static_cast<float>(tile_size_.x),
-                static_cast<float>(tile_size_.y)
-            };
-            engine::render::Sprite sprite{ texture_id, texture_rect };
-            auto tile_type = getTileTypeById(tileset, local_id);   // 获取瓦片类型（只有瓦片id，还没找具体瓦片json）
-            return engine::component::TileInfo(sprite, tile_type);
-        }
-        else {   // 这是多图片的情况
-            if (!tileset.contains("tiles")) {   // 没有tiles字段的话不符合数据格式要求，直接返回空的瓦片信息
-                spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", tileset_it->first);
-                return engine::component::TileInfo();
-            }
-            // 遍历tiles数组，根据id查找对应的瓦片
-            const auto& tiles_json = tileset["tiles"];
-            for (const auto& tile_json : tiles_json) {
-                auto tile_id = tile_json.value("id", 0);
-                if (tile_id == local_id) {   // 找到对应的瓦片，进行后续操作
-                    if (!tile_json.contains("image")) {   // 没有image字段的话不符合数据格式要求，直接返回空的瓦片信息
-                        spdlog::error("Tileset 文件 '{}' 中瓦片 {} 缺少 'image' 属性。", tileset_it->first, tile_id);
-                        return engine::component::TileInfo();
-                    }
-                 
+        const int animation_index = entry->json ? getTileAnimationIndex(findTileset(gid), *entry->json, entry->local_id) : -1;
+        return engine::component::TileInfo(engine::render::Sprite{ entry->texture_id, entry->src_rect }, entry->type, animation_index);
+    }
 
-                    // 获取图片路径
-                    auto texture_id = resolvePath(tile_json["image"].get<std::string>(), file_path);
-                    // 先确认图片尺寸
-                    auto image_width = tile_json.value("imagewidth", 0);
-                    auto image_height = tile_json.value("imageheight", 0);
-                    // 从json中获取源矩形信息
-                    SDL_FRect texture_rect = {      // tiled中源矩形信息只有设置了才会有值，没有就是默认值
-                        static_cast<float>(tile_json.value("x", 0)),
-                        static_cast<float>(tile_json.value("y", 0)),
-                        static_cast<float>(tile_json.value("width", image_width)),    // 如果未设置，则使用图片尺寸
-                        static_cast<float>(tile_json.value("height", image_height))
-                    };
-                    engine::render::Sprite sprite{ texture_id, texture_rect };
-                    auto tile_type = getTileType(tile_json);    // 获取瓦片类型（已经有具体瓦片json了）
-                    return engine::component::TileInfo(sprite, tile_type);
-                }
-            }
+    std::uint16_t LevelLoader::getPaletteIndex(int gid)
+    {
+        if (gid == 0) {
+            return 0;
         }
-
-        // 如果能走到这里，说明查找失败，返回空的瓦片信息
-        spdlog::error("图块集 '{}' 中未找到gid为 {} 的瓦片。", tileset_it->first, gid);
-        return engine::component::TileInfo();
+        if (auto it = palette_index_.find(gid); it != palette_index_.end()) {
+            return it->second;
+        }
+        if (tile_palette_->size() > UINT16_MAX) {
+            spdlog::error("瓦片调色板已满（{} 项），gid为 {} 的瓦片按空瓦片处理。", tile_palette_->size(), gid);
+            palette_index_.emplace(gid, static_cast<std::uint16_t>(0));
+            return 0;
+        }
+        const auto index = static_cast<std::uint16_t>(tile_palette_->size());
+        tile_palette_->push_back(getTileInfoByGid(gid));
+        palette_gids_.push_back(gid);
+        palette_index_.emplace(gid, index);
+        return index;
     }
 
-    std::optional<nlohmann::json> LevelLoader::getTileJsonByGid(int gid) const
-    {  // 1. 查找tileset_data_中键小于等于gid的最近元素
-        auto tileset_it = tileset_data_.upper_bound(gid);
-        if (tileset_it == tileset_data_.begin()) {
-            spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
-            return std::nullopt;
+    int LevelLoader::getTileAnimationIndex(const TilesetEntry& tileset, const nlohmann::json& tile_json, int local_id)
+    {
+        if (!animation_system_ || !tile_json.contains("animation") || !tile_json["animation"].is_array()) {
+            return -1;
         }
-        --tileset_it;
-        // 2. 获取图块集json对象
-        const auto& tileset = tileset_it->second;
-        auto local_id = gid - tileset_it->first;        // 计算瓦片在图块集中的局部ID
-        if (!tileset.contains("tiles")) {   // 没有tiles字段的话不符合数据格式要求，直接返回空
-            spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", tileset_it->first);
-            return std::nullopt;
+        // 动画表按（图块集, 局部 ID）共享：其它关卡或图层已经登记过时直接复用
+        if (int existing = animation_system_->findTileAnimation(tileset.file_path, local_id); existing >= 0) {
+            return existing;
         }
-        // 3. 遍历tiles数组，根据id查找对应的瓦片并返回瓦片json
-        const auto& tiles_json = tileset["tiles"];
-        for (const auto& tile_json : tiles_json) {
-            auto tile_id = tile_json.value("id", 0);
-            if (tile_id == local_id) {   // 找到对应的瓦片，返回瓦片json
-                return std::make_optional<nlohmann::json>(tile_json);
+
+        std::vector<engine::render::Sprite> frames;
+        std::vector<float> durations;
+        frames.reserve(tile_json["animation"].size());
+        durations.reserve(tile_json["animation"].size());
+        for (const auto& frame_json : tile_json["animation"]) {
+            const int frame_id = frame_json.value("tileid", -1);
+            const auto* frame = frame_id >= 0 && frame_id < tileset.tile_count ? findTile(tileset.first_gid + frame_id) : nullptr;
+            if (!frame || frame->texture_id.empty()) {
+                spdlog::warn("图块集 '{}' 中瓦片 {} 的动画帧 {} 无效，按静态瓦片处理。", tileset.file_path, local_id, frame_id);
+                return -1;
+            }
+            frames.emplace_back(frame->texture_id, frame->src_rect);
+            if (texture_source_) {
+                frames.back().setTextureHandle(texture_source_->getTextureHandle(frame->texture_id));
             }
+            durations.push_back(static_cast<float>(frame_json.value("duration", 100)) / 1000.0f);     // Tiled 中单位为毫秒
         }
-        return std::nullopt;
+        return animation_system_->registerTileAnimation(tileset.file_path, local_id, std::move(frames), durations);
     }
 
-    void LevelLoader::loadTileset(const std::string& tileset_path, int first_gid)
+    void LevelLoader::resolveTileTextures(Scene& scene)
     {
-        std::ifstream tileset_file(tileset_path);
-        if (!tileset_file.is_open()) {
-            spdlog::error("无法打开 Tileset 文件: {}", tileset_path);
-            return;
+        auto texture_scope = load_profile_.measure("build.tile_textures");
+        texture_source_ = &scene.getContext().getResourceManager();
+        for (std::size_t i = 1; i < tile_palette_->size(); ++i) {
+            auto& sprite = (*tile_palette_)[i].sprite;
+            if (sprite.getTextureId().empty()) {
+                continue;
+            }
+            sprite.setTextureHandle(texture_source_->getTextureHandle(sprite.getTextureId()));
+            if (sprite.getTextureHandle() == 0) {
+                spdlog::error("无法为瓦片获取纹理: {}", sprite.getTextureId());
+            }
         }
+    }
 
-        nlohmann::json ts_json;
-        try {
-            tileset_file >> ts_json;
-        }
-        catch (const nlohmann::json::parse_error& e) {
-            spdlog::error("解析 Tileset JSON 文件 '{}' 失败: {} (at byte {})", tileset_path, e.what(), e.byte);
-            return;
+    const nlohmann::json* LevelLoader::getTileJsonByGid(int gid) const
+    {
+        const auto* entry = findTile(gid);
+        if (!entry) {
+            spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
+            return nullptr;
         }
-        ts_json["file_path"] = tileset_path;    // 将文件路径存储到json中，后续解析图片路径时需要
-        tileset_data_[first_gid] = std::move(ts_json);
-        spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
+        return entry->json;     // 图块集中没有该瓦片的条目时为 nullptr
     }
 
-    engine::component::TileType LevelLoader::getTileType(const nlohmann::json& tile_json)
+    std::optional<std::pair<std::string, int>> LevelLoader::getTileKeyByGid(int gid) const
     {
-
-        if (tile_json.contains("properties")) {
-
-            auto& properties = tile_json["properties"];
-
-            for (auto& property : properties) {
-
-                if (property.contains("name") && property["name"] == "solid") {
-                    auto is_solid = property.value("value", false);
-                    return is_solid ? engine::component::TileType::SOLID : engine::component::TileType::NORMAL;
-                }
-                else
-                    if(property.contains("name") && property["name"] == "slope")
-                    {
-                        auto slope_type = property.value("value", "");
-                        if (slope_type == "0_1") {
-                            return engine::component::TileType::SLOPE_0_1;
-                        }
-                        else if (slope_type == "1_0") {
-                            return engine::component::TileType::SLOPE_1_0;
-                        }
-                        else if (slope_type == "0_2") {
-                            return engine::component::TileType::SLOPE_0_2;
-                        }
-                        else if (slope_type == "2_0") {
-                            return engine::component::TileType::SLOPE_2_0;
-                        }
-                        else if (slope_type == "2_1") {
-                            return engine::component::TileType::SLOPE_2_1;
-                        }
-                        else if (slope_type == "1_2") {
-                            return engine::component::TileType::SLOPE_1_2;
-                        }
-                        else {
-                            spdlog::error("未知的斜坡类型: {}", slope_type);
-                            return engine::component::TileType::NORMAL;
-                        }
-                    }
-                    else if (property.contains("name") && property["name"] == "unisolid") {
-                        auto is_unisolid = property.value("value", false);
-                        return is_unisolid ? engine::component::TileType::UNISOLID : engine::component::TileType::NORMAL;
-                    }
-                
-                    else if (property.contains("name") && property["name"] == "hazard")
-                    {
-                        auto is_hazard = property.value("value", false);
-                        return is_hazard ? engine::component::TileType::HAZARD :
-                            engine::component::TileType::NORMAL;
-
-                    }
-                    else if (property.contains("name") && property["name"] == "ladder")
-                    {
-                        auto is_ladder = property.value("value", false);
-                        return is_ladder ? engine::component::TileType::LADDER :
-                            engine::component::TileType::NORMAL;
-                    }
- 
-            }
+        const auto* entry = findTile(gid);
+        if (!entry) {
+            spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
+            return std::nullopt;
         }
-        return engine::component::TileType::NORMAL;
+        return std::make_pair(findTileset(gid).file_path, entry->local_id);
     }
 
-    engine::component::TileType LevelLoader::getTileTypeById(const nlohmann::json& tileset_json, int local_id)
+    const LevelLoader::TilesetEntry& LevelLoader::findTileset(int gid) const
     {
-        if (tileset_json.contains("tiles")) {
-            auto& tiles = tileset_json["tiles"];
-            for (auto& tile : tiles) {
-                if (tile.contains("id") && tile["id"] == local_id) {
-                    return getTileType(tile);
-                }
-            }
+        // tilesets_ 按 firstgid 升序，取 firstgid 不大于 gid 的最后一个
+        auto it = std::upper_bound(tilesets_.begin(), tilesets_.end(), gid,
+            [](int value, const TilesetEntry& tileset) { return value < tileset.first_gid; });
+        return *std::prev(it);
+    }
+
+    void LevelLoader::loadTileset(const std::string& tileset_path, int first_gid, std::shared_ptr<const engine::resource::Tileset> tileset)
+    {
+        if (first_gid <= 0 || (!tilesets_.empty() && first_gid <= tilesets_.back().first_gid)) {
+            spdlog::error("Tileset 文件 '{}' 的 firstgid 无效: {}", tileset_path, first_gid);
+            return;
+        }
+        if (!tileset) {     // 读取或解析失败（已记录错误日志）
+            return;
         }
-        return engine::component::TileType::NORMAL;
+        const int tile_count = tileset->getTileCount();
+        if (gid_table_.size() < static_cast<std::size_t>(first_gid + tile_count)) {
+            gid_table_.resize(static_cast<std::size_t>(first_gid + tile_count), nullptr);
+        }
+        const auto* tiles = tileset->getTiles();
+        for (int local_id = 0; local_id < tile_count; ++local_id) {
+            gid_table_[first_gid + local_id] = tiles[local_id].is_present ? &tiles[local_id] : nullptr;
+        }
+        tilesets_.push_back({ first_gid, tile_count, tileset_path, std::move(tileset) });
+        spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
     }
 
     std::string LevelLoader::resolvePath(const std::string& relative_path, const std::string& file_path)
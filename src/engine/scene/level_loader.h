@@ -3,8 +3,32 @@
 #include <glm/vec2.hpp>
 #include <nlohmann/json.hpp>
 #include <map>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include<optional>
 #include"../utils/math.h"
+#include "../render/sprite.h"
+#include "../core/load_profiler.h"
+
+namespace engine::render {
+    class Animation;
+    class AnimationSystem;
+}
+
+namespace engine::resource {
+    class AnimationSet;
+    class ResourceManager;
+    class Tileset;
+    struct TilesetTile;
+}
+
+namespace engine::core {
+    class JobPool;
+}
 
 namespace engine::component {
     class AnimationComponent;
@@ -13,20 +37,115 @@ namespace engine::component {
     enum class TileType;
 }
 
+namespace engine::scene::cooked {
+    class LevelWriter;
+    class LevelView;
+    struct StringRef;
+}
+
 namespace engine::scene {
     class Scene;
+    class TileChunkSource;
 
     /**
      * @brief 负责从 Tiled JSON 文件 (.tmj) 加载关卡数据到 Scene 中。
+     *
+     * 同目录下存在同名的烘焙文件（.lvl，见 cooked_level.h）且不比源文件旧时，直接内存映射烘焙文件构建场景，不解析 JSON；
+     * 否则回退到 .tmj。烘焙文件由 cookLevel() 生成（命令行 --cook）。
+     *
+     * 加载分为两个阶段：prepareLevel() 只读取文件、解析数据并转换瓦片层，不访问场景与上下文，可以在后台线程上运行
+     * （见 LevelPreloader）；loadLevel() 在游戏线程上登记瓦片动画并创建游戏对象，已准备好同一地图时跳过准备阶段。
+     *
+     * 无限地图（Tiled 的 chunks 格式）的瓦片层不在加载时展开，而是保存为 TileChunkSource，运行时由瓦片层按相机位置流式解码；
+     * 关卡内容整体平移，使分块范围的左上角位于世界原点。无限地图不支持烘焙。
      */
     class LevelLoader final {
+        /**
+         * @brief 对象预制体：同一瓦片的所有对象共享的组件参数（.tmj 与烘焙文件两条加载路径共用）。
+         * 第一次遇到某个瓦片时编译（解析属性、动画与音效表），之后的对象只提供名称与变换。
+         */
+        struct ObjectPrefab {
+            bool is_valid = false;                          ///< @brief 瓦片属性是否有效（无效时跳过所有实例）
+            engine::render::Sprite sprite;                  ///< @brief 瓦片精灵
+            glm::vec2 src_size{};                           ///< @brief 源矩形尺寸（计算缩放，也是 SOLID 瓦片的碰撞盒）
+            engine::component::TileType type{};             ///< @brief 瓦片类型
+            std::optional<engine::utils::Rect> collider;    ///< @brief 自定义碰撞盒
+            std::optional<std::string> tag;                 ///< @brief tag 属性
+            std::optional<bool> gravity;                    ///< @brief gravity 属性
+            std::optional<int> health;                      ///< @brief health 属性
+            const engine::resource::AnimationSet* animation_set = nullptr;     ///< @brief 共享动画剪辑集
+            std::optional<std::vector<std::pair<std::string, std::string>>> sounds;    ///< @brief 音效表（名称, 路径）
+            std::size_t component_count = 0;                ///< @brief 实例的组件数量（预留组件表）
+            std::string profile_phase;                      ///< @brief 加载报告中实例化的阶段名（按对象类型）
+        };
+
+        /// @brief 本地图引用的图块集
+        struct TilesetEntry {
+            int first_gid = 0;                              ///< @brief 第一个全局 ID
+            int tile_count = 0;                             ///< @brief 查找表中占用的 gid 数量
+            std::string file_path;                          ///< @brief 图块集文件路径（也是共享资源的键）
+            std::shared_ptr<const engine::resource::Tileset> tileset;  ///< @brief 共享的图块集数据（gid 查找表指向其中的瓦片）
+        };
+
         std::string map_path_;      ///< @brief 地图路径（拼接路径时需要）
         glm::ivec2 map_size_;       ///< @brief 地图尺寸(瓦片数量)
         glm::ivec2 tile_size_;      ///< @brief 瓦片尺寸(像素)
-        std::map<int, nlohmann::json> tileset_data_;    ///< @brief firstgid -> 瓦片集数据
+        glm::vec2 map_origin_{ 0.0f };  ///< @brief 无限地图中分块范围左上角在 Tiled 中的坐标（像素），加载时从所有图层的位置中减去
+        engine::resource::ResourceManager* resource_manager_ = nullptr;    ///< @brief 提供跨关卡共享的图块集缓存（为空时每次从磁盘读取）
+        engine::core::JobPool* job_pool_ = nullptr;     ///< @brief 并行解析图块集与瓦片层的任务池（为空时串行）
+        std::vector<TilesetEntry> tilesets_;            ///< @brief 本地图引用的图块集（按 firstgid 升序）
+        std::vector<const engine::resource::TilesetTile*> gid_table_;      ///< @brief gid -> 图块集中的瓦片（稠密，每个图块集加载后立即填充）
+        std::uint8_t current_render_layer_ = 0;         ///< @brief 当前加载图层的渲染层级（按 Tiled 中的图层顺序分配）
+        engine::render::AnimationSystem* animation_system_ = nullptr;  ///< @brief 登记瓦片动画的目标（来自场景的上下文，准备阶段为空）
+        engine::resource::ResourceManager* texture_source_ = nullptr;  ///< @brief 解析瓦片纹理句柄的来源（来自场景的上下文，准备阶段为空）
+
+        // --- 准备阶段的结果（prepareLevel 填充，loadLevel 构建场景后释放） ---
+        std::string prepared_path_;                     ///< @brief 已准备好的地图路径（空表示没有）
+        nlohmann::json map_json_;                       ///< @brief 地图json（.tmj 路径）
+        std::unique_ptr<engine::scene::cooked::LevelView> cooked_view_;    ///< @brief 映射的烘焙文件（烘焙路径）
+        std::string cooked_path_;                       ///< @brief 烘焙文件路径
+        std::unordered_map<std::uint32_t, std::string> cooked_paths_;      ///< @brief 烘焙文件中的字符串偏移 -> 规范路径
+        std::vector<std::vector<std::uint16_t>> prepared_cells_;   ///< @brief 按图层下标保存的瓦片格子（.tmj 路径，非瓦片层为空）
+        std::vector<std::shared_ptr<const TileChunkSource>> prepared_chunks_;  ///< @brief 按图层下标保存的分块数据（无限地图，非瓦片层为空）
+        std::vector<int> palette_gids_;                 ///< @brief 调色板下标 -> gid（构建阶段据此登记瓦片动画）
+        std::vector<std::string> texture_paths_;        ///< @brief 关卡用到的纹理
+        std::vector<std::string> sound_paths_;          ///< @brief 关卡用到的音效
+
+        // --- 瓦片调色板（每次 loadLevel 重建，本地图的所有瓦片层共享） ---
+        std::shared_ptr<std::vector<engine::component::TileInfo>> tile_palette_;   ///< @brief 不重复的瓦片信息，下标 0 为空瓦片
+        std::unordered_map<int, std::uint16_t> palette_index_;                      ///< @brief gid -> 调色板下标
+        std::size_t tile_cell_count_ = 0;               ///< @brief 已加载的瓦片格子数量
+        std::size_t per_cell_tile_bytes_ = 0;           ///< @brief 如果每个格子保存一份 TileInfo 所需的字节数（用于对比）
+        double tile_layer_ms_ = 0.0;                    ///< @brief 加载瓦片层的总耗时
+
+        // --- 动画剪辑统计（每次 loadLevel 重置） ---
+        int animated_object_count_ = 0;                 ///< @brief 带动画的对象数量
+        int animation_sets_built_ = 0;                  ///< @brief 本次新建的剪辑集数量
+        std::size_t animation_frames_built_ = 0;        ///< @brief 本次新建的动画帧数量
+        double animation_build_ms_ = 0.0;               ///< @brief 查找/构建动画剪辑的总耗时
+
+        // --- 对象预制体（每次 loadLevel 重建） ---
+        std::unordered_map<int, ObjectPrefab> object_prefabs_;  ///< @brief gid（.tmj）或瓦片表下标（烘焙文件） -> 预制体
+        int object_instance_count_ = 0;                 ///< @brief 由预制体创建的对象数量
+        double prefab_compile_ms_ = 0.0;                ///< @brief 编译预制体的总耗时
+        double object_instance_ms_ = 0.0;               ///< @brief 由预制体创建对象的总耗时
+
+        engine::core::LoadProfiler load_profile_;       ///< @brief 本次加载的分阶段计时（prepareLevel 重置，准备与构建阶段共同记录）
 
     public:
-        LevelLoader() = default;
+        /**
+         * @brief 构造函数。
+         * @param resource_manager 资源管理器，用于跨关卡复用已解析的图块集；为空时（例如烘焙工具）每次从磁盘读取
+         * @param job_pool 任务池，用于并行解析图块集与转换瓦片层；为空时串行。场景对象始终在调用 loadLevel 的线程上按图层顺序创建
+         */
+        explicit LevelLoader(engine::resource::ResourceManager* resource_manager = nullptr, engine::core::JobPool* job_pool = nullptr);
+        ~LevelLoader();
+
+        // 禁止拷贝和移动
+        LevelLoader(const LevelLoader&) = delete;
+        LevelLoader& operator=(const LevelLoader&) = delete;
+        LevelLoader(LevelLoader&&) = delete;
+        LevelLoader& operator=(LevelLoader&&) = delete;
 
         /**
          * @brief 加载关卡数据到指定的 Scene 对象中。
@@ -36,33 +155,120 @@ namespace engine::scene {
          */
         [[nodiscard]]bool loadLevel(const std::string& map_path, Scene& scene);
 
+        /**
+         * @brief 准备关卡：读取并解析地图（或映射烘焙文件），转换瓦片层，列出用到的纹理与音效。
+         * 不访问场景与上下文，可以在任意线程上调用；随后在游戏线程上用同一路径调用 loadLevel() 完成加载。
+         * @param map_path Tiled JSON 地图文件的路径
+         * @return bool 是否成功
+         */
+        [[nodiscard]] bool prepareLevel(const std::string& map_path);
+
+        const std::string& getPreparedPath() const { return prepared_path_; }                ///< @brief 已准备好的地图路径（空表示没有）
+        const std::vector<std::string>& getTexturePaths() const { return texture_paths_; }   ///< @brief 已准备的关卡用到的纹理
+        const std::vector<std::string>& getSoundPaths() const { return sound_paths_; }       ///< @brief 已准备的关卡用到的音效
+        const engine::core::LoadProfiler& getLoadProfile() const { return load_profile_; }   ///< @brief 最近一次准备与加载的分阶段计时（由调用者汇总到加载报告）
+
+        /**
+         * @brief 把 Tiled 地图及其图块集烘焙为二进制关卡文件。
+         * @param map_path Tiled JSON 地图文件的路径
+         * @param output_path 输出路径，为空时使用 getCookedPath(map_path)
+         * @return bool 是否成功
+         */
+        [[nodiscard]] bool cookLevel(const std::string& map_path, const std::string& output_path = "");
+
+        /// @brief 地图对应的烘焙文件路径（同目录同名，扩展名 .lvl）
+        static std::string getCookedPath(const std::string& map_path);
 
 
     private:
+        /**
+         * @brief 读取并解析地图 JSON，重置加载状态并加载其引用的图块集（loadLevel 与 cookLevel 共用）。
+         * @param map_path 地图文件路径
+         * @param json_data 输出：地图json数据
+         * @return bool 是否成功（地图中必须有 layers 数组）
+         */
+        bool loadMapJson(const std::string& map_path, nlohmann::json& json_data);
+
+        bool prepareJsonLevel(const std::string& map_path);    ///< @brief 准备阶段（.tmj）：解析地图与图块集，转换瓦片层
+        bool buildJsonLevel(Scene& scene);                      ///< @brief 构建阶段（.tmj）：登记瓦片动画，按图层创建对象
+
+        /**
+         * @brief 准备阶段（无限地图）：计算分块范围与地图原点，把所有图块集的瓦片加入调色板，
+         * 并把每个瓦片层的分块保存为 TileChunkSource（base64 数据保持原编码，csv 数据转换为调色板下标）。
+         * @return bool 是否成功（分块尺寸不一致或数据无效时失败）
+         */
+        bool prepareChunkedLayers();
+
+        /**
+         * @brief 准备阶段（烘焙文件）：映射并校验文件，构建调色板。文件无效、版本不符或比源文件旧时返回 false。
+         * @param cooked_path 烘焙文件路径
+         */
+        bool prepareCookedLevel(const std::string& cooked_path);
+        bool buildCookedLevel(Scene& scene);                    ///< @brief 构建阶段（烘焙文件）：登记瓦片动画，按图层创建对象
+        const std::string& getCookedRuntimePath(const engine::scene::cooked::StringRef& ref);  ///< @brief 烘焙文件中的路径 -> 规范路径（缓存）
+        void releasePreparedLevel();                            ///< @brief 释放准备阶段的数据
+
+        /**
+         * @brief 把 gid 对应的瓦片写入烘焙文件的瓦片表（每个 gid 只写一次），同时烘焙其属性、动画与音效表。
+         * @param gid 全局 ID
+         * @param writer 烘焙文件写入器
+         * @param tile_indices gid -> 瓦片表下标
+         * @return 瓦片表下标，空瓦片或无效瓦片返回 0
+         */
+        std::uint32_t cookTile(int gid, engine::scene::cooked::LevelWriter& writer, std::unordered_map<int, std::uint32_t>& tile_indices);
+
         void loadImageLayer(const nlohmann::json& layer_json, Scene& scene);    ///< @brief 加载图片图层
-        void loadTileLayer(const nlohmann::json& layer_json, Scene& scene);     ///< @brief 加载瓦片图层
+        void loadTileLayer(const nlohmann::json& layer_json, std::vector<std::uint16_t>&& cells, Scene& scene);  ///< @brief 加载瓦片图层（格子已在准备阶段转换）
+        void buildTileLayerCells();     ///< @brief 把所有瓦片层的 gid（csv 或 base64 编码）转换为调色板下标，各层在任务池上并行（失败的图层为空）
+        void runJobs(std::size_t count, const std::function<void(std::size_t)>& job);  ///< @brief 在任务池上执行 [0, count) 的任务，没有任务池时串行
         void loadObjectLayer(const nlohmann::json& layer_json, Scene& scene);   ///< @brief 加载对象图层
 
+        // --- 创建场景对象（两条加载路径共用） ---
+        void addImageLayer(Scene& scene, const std::string& name, const std::string& texture_id,
+            const glm::vec2& offset, const glm::vec2& scroll_factor, const glm::bvec2& repeat);     ///< @brief 创建视差图层对象
+        void addTileLayer(Scene& scene, const std::string& name, std::vector<std::uint16_t>&& cells);  ///< @brief 创建瓦片图层对象（使用当前调色板）
+        void addChunkedTileLayer(Scene& scene, const std::string& name, std::shared_ptr<const TileChunkSource> chunk_source);  ///< @brief 创建分块瓦片图层对象（使用当前调色板）
+        void addShapeObject(Scene& scene, const std::string& name, const glm::vec2& position, const glm::vec2& size,
+            float rotation, bool is_trigger, const std::optional<std::string>& tag);                 ///< @brief 创建自定义形状（矩形）对象
+        void addTileObject(Scene& scene, const ObjectPrefab& prefab, const std::string& name,
+            const glm::vec2& position, const glm::vec2& size, float rotation, std::uint32_t render_depth);  ///< @brief 由预制体创建瓦片对象（左上角位置，目标尺寸，层内深度）
+
+        const ObjectPrefab& getObjectPrefab(int gid, Scene& scene);                                  ///< @brief 获取 gid 的预制体（.tmj），第一次遇到时编译
+        void compileObjectPrefab(int gid, Scene& scene, ObjectPrefab& prefab);                      ///< @brief 从瓦片json编译预制体，失败时 is_valid 为 false
+        const ObjectPrefab& getCookedObjectPrefab(std::uint32_t tile_index, Scene& scene);           ///< @brief 获取烘焙文件中瓦片的预制体，第一次遇到时编译
+        static void finalizePrefab(ObjectPrefab& prefab);                                            ///< @brief 计算预制体实例的组件数量与加载报告中的阶段名
+
+        /**
+         * @brief 登记新建的剪辑集并更新统计（同一瓦片的剪辑只构建一次）。
+         */
+        const engine::resource::AnimationSet* addAnimationSet(Scene& scene, const std::string& tileset_path, int local_id,
+            std::vector<std::unique_ptr<engine::render::Animation>>&& clips);
+
 
 
 
         /**
-        * @brief 添加动画到指定的 AnimationComponent。
+        * @brief 根据动画json构建一组动画剪辑（只在剪辑集第一次被引用时调用）。
         * @param anim_json 动画json数据（自定义）
-        * @param ac AnimationComponent 指针（动画添加到此组件）
         * @param sprite_size 每一帧动画的尺寸
+        * @return 构建出的动画剪辑
         */
-
-        void addAnimation(const nlohmann::json& anim_json, 
-            engine::component::AnimationComponent* ac,
+        std::vector<std::unique_ptr<engine::render::Animation>> buildAnimationClips(const nlohmann::json& anim_json,
             const glm::vec2& sprite_size);
 
         /**
-       * @brief 添加音效到指定的 AudioComponent。
-       * @param sound_json 音效json数据（自定义）
-       * @param audio_component AudioComponent 指针（音效添加到此组件）
+         * @brief 根据全局 ID 获取瓦片在共享资源中的键（瓦片集路径, 局部 ID）。
+         * @param gid 全局 ID
+         * @return 键，找不到瓦片集时返回 std::nullopt
+         */
+        std::optional<std::pair<std::string, int>> getTileKeyByGid(int gid) const;
+
+        /**
+       * @brief 解析音效表。
+       * @param sound_json 音效json数据（自定义，名称 -> 路径）
+       * @return 音效列表（名称, 路径），json 无效时为空
        */
-        void addSound(const nlohmann::json& sound_json, engine::component::AudioComponent* audio_component);
+        std::vector<std::pair<std::string, std::string>> parseSoundTable(const nlohmann::json& sound_json);
 
 
         /**
@@ -103,39 +309,55 @@ namespace engine::scene {
          */
         engine::component::TileInfo getTileInfoByGid(int gid);
 
+        /**
+         * @brief 获取 gid 在瓦片调色板中的下标，第一次遇到的 gid 追加到调色板。
+         * @param gid 全局 ID（0 为空瓦片）
+         * @return 调色板下标，调色板已满时返回 0（空瓦片）
+         */
+        std::uint16_t getPaletteIndex(int gid);
 
         /**
-         * @brief 根据全局 ID 获取瓦片json对象 (用于对象层获取瓦片信息)
-         * @param gid 全局 ID
-         * @return 瓦片json对象
+         * @brief 如果瓦片带有 Tiled 动画，则登记到 AnimationSystem（同一图块集的同一瓦片只构建一次）。
+         * @param tileset 瓦片所属的图块集
+         * @param tile_json 瓦片json数据
+         * @param local_id 图块集中的id
+         * @return 动画下标，静态瓦片返回 -1
          */
-        std::optional<nlohmann::json> getTileJsonByGid(int gid) const;
+        int getTileAnimationIndex(const TilesetEntry& tileset, const nlohmann::json& tile_json, int local_id);
 
+        /**
+         * @brief 为调色板中的所有瓦片解析并缓存纹理句柄（构建阶段，在登记瓦片动画之前调用）。
+         * 瓦片层每帧绘制时直接使用缓存的句柄，不再按纹理路径查找。
+         * @param scene 提供资源管理器的场景
+         */
+        void resolveTileTextures(Scene& scene);
 
+        /// @brief 在 gid 查找表中查找瓦片，O(1)，不属于任何图块集时返回 nullptr
+        const engine::resource::TilesetTile* findTile(int gid) const {
+            return gid > 0 && static_cast<std::size_t>(gid) < gid_table_.size() ? gid_table_[gid] : nullptr;
+        }
+
+        const TilesetEntry& findTileset(int gid) const;     ///< @brief 获取 gid 所属的图块集（gid 必须能用 findTile 找到）
 
 
         /**
-         * @brief 加载 Tiled tileset 文件 (.tsj)。
-         * @param tileset_path Tileset 文件路径。
-         * @param first_gid 此 tileset 的第一个全局 ID。
+         * @brief 根据全局 ID 获取瓦片json对象 (用于对象层获取瓦片信息)
+         * @param gid 全局 ID
+         * @return 指向图块集中瓦片json的指针（不复制），没有该瓦片的条目时返回 nullptr
          */
-        void loadTileset(const std::string& tileset_path, int first_gid);
+        const nlohmann::json* getTileJsonByGid(int gid) const;
+
 
 
-        /**
-        * @brief 根据瓦片json对象获取瓦片类型
-        * @param tile_json 瓦片json数据
-        * @return 瓦片类型
-        */
-        engine::component::TileType getTileType(const nlohmann::json& tile_json);
 
         /**
-         * @brief 根据（单一图片）图块集中的id获取瓦片类型
-         * @param tileset_json 图块集json数据
-         * @param local_id 图块集中的id
-         * @return 瓦片类型
+         * @brief 把已解析的 Tiled tileset (.tsj) 记录到本地图，并把其瓦片表映射到 gid 查找表（必须按 firstgid 升序调用）。
+         * @param tileset_path Tileset 文件路径。
+         * @param first_gid 此 tileset 的第一个全局 ID。
+         * @param tileset 解析结果（共享缓存或直接读取），为空表示读取失败
          */
-        engine::component::TileType getTileTypeById(const nlohmann::json& tileset_json, int local_id);
+        void loadTileset(const std::string& tileset_path, int first_gid, std::shared_ptr<const engine::resource::Tileset> tileset);
+
 
 
 
@@ -0,0 +1,103 @@
+#include "level_preloader.h"
+#include "level_loader.h"
+#include "../resource/resource_manager.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    LevelPreloader::LevelPreloader(engine::resource::ResourceManager& resource_manager, engine::core::JobPool* job_pool)
+        : resource_manager_(resource_manager), job_pool_(job_pool)
+    {
+        worker_ = std::thread(&LevelPreloader::workerLoop, this);
+        spdlog::trace("LevelPreloader 构造成功。");
+    }
+
+    LevelPreloader::~LevelPreloader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+            requested_path_.clear();
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void LevelPreloader::request(const std::string& map_path) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (map_path == requested_path_ || map_path == loading_path_ || map_path == ready_path_) {
+                return;
+            }
+            if (!requested_path_.empty()) {
+                spdlog::debug("预加载请求 '{}' 被 '{}' 替换。", requested_path_, map_path);
+            }
+            requested_path_ = map_path;
+        }
+        cv_.notify_all();
+        spdlog::info("开始后台预加载关卡: {}", map_path);
+    }
+
+    std::unique_ptr<LevelLoader> LevelPreloader::take(const std::string& map_path) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (map_path == loading_path_ || map_path == requested_path_) {
+            auto wait_start = std::chrono::steady_clock::now();
+            cv_.wait(lock, [&] { return map_path != loading_path_ && map_path != requested_path_; });
+            spdlog::info("等待关卡 '{}' 预加载完成 {:.3f} ms。", map_path,
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wait_start).count());
+        }
+        if (map_path != ready_path_) {
+            return nullptr;
+        }
+        ready_path_.clear();
+        return std::move(ready_loader_);
+    }
+
+    void LevelPreloader::workerLoop() {
+        while (true) {
+            std::string map_path;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !requested_path_.empty() || is_stopping_; });
+                if (is_stopping_) {
+                    return;
+                }
+                map_path = std::move(requested_path_);
+                requested_path_.clear();
+                loading_path_ = map_path;
+            }
+
+            auto start_time = std::chrono::steady_clock::now();
+            auto loader = std::make_unique<LevelLoader>(&resource_manager_, job_pool_);
+            bool is_prepared = loader->prepareLevel(map_path);
+            if (is_prepared) {
+                int texture_count = 0;
+                int sound_count = 0;
+                for (const auto& texture_path : loader->getTexturePaths()) {
+                    texture_count += resource_manager_.preloadTexture(texture_path) ? 1 : 0;
+                }
+                for (const auto& sound_path : loader->getSoundPaths()) {
+                    sound_count += resource_manager_.preloadSound(sound_path) ? 1 : 0;
+                }
+                spdlog::info("关卡 '{}' 预加载完成：{} 个纹理，{} 个音效，耗时 {:.3f} ms", map_path, texture_count, sound_count,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count());
+            }
+            else {
+                spdlog::warn("关卡 '{}' 预加载失败，切换时将同步加载。", map_path);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                loading_path_.clear();
+                if (is_prepared) {
+                    ready_path_ = map_path;
+                    ready_loader_ = std::move(loader);      // 只保留最近一次准备的关卡
+                }
+            }
+            cv_.notify_all();
+        }
+    }
+
+} // namespace engine::scene
@@ -0,0 +1,72 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace engine::resource {
+    class ResourceManager;
+}
+
+namespace engine::core {
+    class JobPool;
+}
+
+namespace engine::scene {
+    class LevelLoader;
+
+    /**
+     * @brief 在后台线程上预先准备下一个关卡，消除切换关卡时的卡顿。
+     *
+     * 后台线程依次完成：解析地图与图块集（或映射烘焙文件）、转换瓦片层、把关卡用到的纹理解码为 Surface、解码音效。
+     * 切换关卡时场景通过 take() 取得已准备好的 LevelLoader，只需创建游戏对象；纹理在渲染线程第一次使用时上传。
+     * 同一时间只保留一个请求，新请求会替换尚未开始的旧请求。request() 与 take() 只在游戏线程上调用。
+     */
+    class LevelPreloader final {
+    private:
+        engine::resource::ResourceManager& resource_manager_;
+        engine::core::JobPool* job_pool_ = nullptr;     ///< @brief 传给 LevelLoader 的并行任务池（可以为空）
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::string requested_path_;                ///< @brief 等待处理的请求（受 mutex_ 保护）
+        std::string loading_path_;                  ///< @brief 正在处理的地图（受 mutex_ 保护）
+        std::string ready_path_;                    ///< @brief 已准备好的地图（受 mutex_ 保护）
+        std::unique_ptr<LevelLoader> ready_loader_; ///< @brief 已准备好的加载器（受 mutex_ 保护）
+        bool is_stopping_ = false;                  ///< @brief 通知后台线程退出（受 mutex_ 保护）
+        std::thread worker_;
+
+    public:
+        /**
+         * @brief 构造函数，启动后台线程。
+         * @param resource_manager 用于预先解码纹理与音效，并共享图块集缓存（这些接口都是线程安全的）
+         * @param job_pool 准备关卡时并行解析图块集与瓦片层的任务池，为空时串行
+         */
+        explicit LevelPreloader(engine::resource::ResourceManager& resource_manager, engine::core::JobPool* job_pool = nullptr);
+        ~LevelPreloader();      ///< @brief 等待正在进行的准备结束后退出后台线程
+
+        // 禁止拷贝和移动
+        LevelPreloader(const LevelPreloader&) = delete;
+        LevelPreloader& operator=(const LevelPreloader&) = delete;
+        LevelPreloader(LevelPreloader&&) = delete;
+        LevelPreloader& operator=(LevelPreloader&&) = delete;
+
+        /**
+         * @brief 请求在后台准备关卡。已请求、正在准备或已准备好的同一地图会被忽略。
+         * @param map_path 地图文件路径
+         */
+        void request(const std::string& map_path);
+
+        /**
+         * @brief 取得已准备好的关卡。地图仍在准备中时等待其完成（已完成的部分不会重复）。
+         * @param map_path 地图文件路径
+         * @return 准备好的加载器；没有请求过该地图或准备失败时返回 nullptr（调用者应同步加载）
+         */
+        std::unique_ptr<LevelLoader> take(const std::string& map_path);
+
+    private:
+        void workerLoop();      ///< @brief 后台线程
+    };
+
+} // namespace engine::scene
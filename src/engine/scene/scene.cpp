@@ -4,6 +4,11 @@
 #include "../core/context.h"
 #include "../physics/physics_engine.h"
 #include"../render/camera.h"
+#include "../render/particle_system.h"
+#include "../render/animation_system.h"
+#include "../render/renderer.h"
+#include "../component/transform_component.h"
+#include "../component/sprite_component.h"
 #include <algorithm> // for std::remove_if
 #include <spdlog/spdlog.h>
 
@@ -34,21 +39,69 @@ namespace engine::scene {
             }
             else {
                 if (*it) {      // 安全删除需要移除的对象
+                    unregisterRenderable(it->get());
                     (*it)->clean();
                 }
                 it = game_objects_.erase(it);   // 删除需要移除的对象，智能指针自动管理内存
             }
         }
 
+        context_.getAnimationSystem().update(delta_time);  // 统一推进所有动画组件
+        context_.getParticleSystem().update(delta_time);   // 更新特效粒子
+
         processPendingAdditions();      // 处理待添加（延时添加）的游戏对象
     }
 
     void Scene::render() {
         if (!is_initialized_) return;
-        // 渲染所有游戏对象
-        for (const auto& obj : game_objects_) {
-            if (obj) obj->render(context_);
+        // 用相机矩形裁剪渲染列表，只对可见对象调用 render，在准备任何绘制命令之前剔除屏幕外的对象
+        const auto& camera = context_.getCamera();
+        const engine::utils::Rect view = { camera.getPosition(), camera.getViewportSize() };
+        // 只刷新上次渲染以来登记过变化的对象，不再每帧遍历整个渲染列表。
+        // 变化的对象需要在查询之前刷新，否则刚移入视口的对象在网格中仍登记在旧的格子里，会被漏掉
+        for (auto* object : render_dirty_) {
+            object->clearRenderDirty();
+            if (auto it = renderable_index_.find(object); it != renderable_index_.end()) {
+                refreshRenderEntry(it->second);
+            }
         }
+        render_dirty_.clear();
+        // 没有包围盒的对象（瓦片层、视差背景）总是渲染，其余对象只取网格给出的候选
+        visible_.assign(unbounded_.begin(), unbounded_.end());
+        render_grid_.query(view, visible_);
+        const auto bounded_count = static_cast<std::uint32_t>(renderables_.size() - unbounded_.size());
+        // 按加入序号排序（下标在删除后会被打乱），保持加入场景的顺序，同层同深度的绘制顺序稳定
+        std::sort(visible_.begin(), visible_.end(), [this](std::uint32_t a, std::uint32_t b) {
+            return renderables_[a].sequence < renderables_[b].sequence;
+        });
+
+        visible_count_ = 0;
+        std::uint32_t bounded_visible = 0;
+        for (auto index : visible_) {
+            const auto& entry = renderables_[index];
+            if (entry.sprite) {     // 网格只给出同格子的候选，再做一次精确的矩形相交测试
+                const auto& b = entry.bounds;
+                if (b.position.x > view.position.x + view.size.x || b.position.x + b.size.x < view.position.x ||
+                    b.position.y > view.position.y + view.size.y || b.position.y + b.size.y < view.position.y) {
+                    continue;
+                }
+            }
+            entry.object->render(context_);
+            ++visible_count_;
+            if (entry.sprite) {
+                ++bounded_visible;
+            }
+        }
+        context_.getRenderer().addCulledSprites(bounded_count - bounded_visible);
+        // 渲染特效粒子
+        context_.getParticleSystem().render(context_.getRenderer(), context_.getCamera());
+
+#if ENGINE_DEBUG_DRAW
+        if (context_.getRenderer().isDebugDrawEnabled()) {
+            context_.getPhysicsEngine().debugDraw(context_.getRenderer(), camera);
+            render_grid_.debugDraw(context_.getRenderer(), camera);
+        }
+#endif
     }
 
     void Scene::handleInput() {
@@ -62,7 +115,10 @@ namespace engine::scene {
             }
             else {
                 // 安全删除需要移除的对象
-                if (*it) (*it)->clean();
+                if (*it) {
+                    unregisterRenderable(it->get());
+                    (*it)->clean();
+                }
                 it = game_objects_.erase(it);
             }
         }
@@ -75,13 +131,24 @@ namespace engine::scene {
             if (obj) obj->clean();
         }
         game_objects_.clear();
+        renderables_.clear();
+        renderable_index_.clear();
+        render_grid_.clear();
+        unbounded_.clear();
+        render_dirty_.clear();
+        visible_.clear();
+        next_render_sequence_ = 0;
+        context_.getParticleSystem().clear();   // 场景结束时丢弃尚未播放完的特效
 
         is_initialized_ = false;        // 清理完成后，设置场景为未初始化
         spdlog::trace("场景 '{}' 清理完成。", scene_name_);
     }
 
     void Scene::addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object) {
-        if (game_object) game_objects_.push_back(std::move(game_object));
+        if (game_object) {
+            registerRenderable(game_object.get());
+            game_objects_.push_back(std::move(game_object));
+        }
         else spdlog::warn("尝试向场景 '{}' 添加空游戏对象。", scene_name_);
     }
 
@@ -105,6 +172,7 @@ namespace engine::scene {
             });
 
         if (it != game_objects_.end()) {
+            unregisterRenderable(it->get());
             (*it)->clean();             // 因为传入的是指针，因此只可能有一个元素被移除，不需要遍历it到末尾
             game_objects_.erase(it, game_objects_.end());   // 删除从it到末尾的元素（最后一个元素）
             spdlog::trace("从场景 '{}' 中移除游戏对象。", scene_name_);
@@ -139,4 +207,80 @@ namespace engine::scene {
         pending_additions_.clear();
     }
 
+    void Scene::registerRenderable(engine::object::GameObject* game_object) {
+        if (!game_object->isRenderable() || renderable_index_.contains(game_object)) {
+            return;
+        }
+        renderable_index_[game_object] = static_cast<std::uint32_t>(renderables_.size());
+        renderables_.push_back({ game_object, next_render_sequence_++ });
+        // 之后的变换、精灵几何与组件变化都会登记到 render_dirty_，首次渲染前先登记一次以解析组件与包围盒
+        game_object->setRenderDirtyList(&render_dirty_);
+        game_object->markRenderDirty();
+    }
+
+    void Scene::unregisterRenderable(engine::object::GameObject* game_object) {
+        auto it = renderable_index_.find(game_object);
+        if (it == renderable_index_.end()) {
+            return;
+        }
+        const std::uint32_t index = it->second;
+        const std::uint32_t last = static_cast<std::uint32_t>(renderables_.size() - 1);
+        renderable_index_.erase(it);
+        if (game_object->isRenderDirty()) {
+            std::erase(render_dirty_, game_object);
+        }
+        game_object->setRenderDirtyList(nullptr);
+        render_grid_.remove(index);
+        std::erase(unbounded_, index);
+        if (index != last) {
+            // 末尾的项搬到空位，空间索引与无包围盒列表中的下标随之更换
+            render_grid_.remove(last);
+            renderables_[index] = renderables_[last];
+            renderable_index_[renderables_[index].object] = index;
+            if (renderables_[index].sprite) {
+                render_grid_.insert(index, renderables_[index].bounds);
+            }
+            else if (auto moved = std::find(unbounded_.begin(), unbounded_.end(), last); moved != unbounded_.end()) {
+                *moved = index;
+            }
+        }
+        renderables_.pop_back();
+    }
+
+    void Scene::refreshRenderEntry(std::uint32_t index) {
+        auto& entry = renderables_[index];
+        auto* object = entry.object;
+        if (!entry.is_resolved || entry.component_version != object->getComponentVersion()) {
+            // 组件变化后重新解析：只有单个精灵组件（加变换）的对象才有包围盒
+            auto* sprite = object->getRenderComponentCount() == 1 ? object->getComponent<engine::component::SpriteComponent>() : nullptr;
+            auto* transform = object->getComponent<engine::component::TransformComponent>();
+            const bool was_unbounded = entry.is_resolved && !entry.sprite;
+            entry.sprite = (sprite && transform) ? sprite : nullptr;
+            entry.transform = entry.sprite ? transform : nullptr;
+            entry.component_version = object->getComponentVersion();
+            entry.is_resolved = true;
+            if (!entry.sprite) {
+                render_grid_.remove(index);
+                if (!was_unbounded) {
+                    unbounded_.push_back(index);
+                }
+                return;
+            }
+            if (was_unbounded) {
+                std::erase(unbounded_, index);
+            }
+            entry.transform_version = entry.transform->getVersion() - 1;   // 强制重新计算包围盒
+        }
+        if (!entry.sprite) {
+            return;
+        }
+        if (entry.transform_version == entry.transform->getVersion() && entry.geometry_version == entry.sprite->getGeometryVersion()) {
+            return;     // 没有移动或变形，缓存的包围盒仍然有效
+        }
+        entry.transform_version = entry.transform->getVersion();
+        entry.geometry_version = entry.sprite->getGeometryVersion();
+        entry.bounds = entry.sprite->getWorldBounds();
+        render_grid_.update(index, entry.bounds);
+    }
+
 } // namespace engine::scene 
\ No newline at end of file
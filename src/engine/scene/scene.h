@@ -1,7 +1,11 @@
 #pragma once
+#include "spatial_grid.h"
+#include "../utils/math.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace engine::core {
     class Context;
@@ -20,6 +24,11 @@ namespace engine::object {
     class GameObject;
 }
 
+namespace engine::component {
+    class TransformComponent;
+    class SpriteComponent;
+}
+
 namespace engine::scene {
     class SceneManager;
 
@@ -30,6 +39,35 @@ namespace engine::scene {
      * 派生类应实现具体的场景逻辑。
      */
     class Scene {
+    private:
+        /**
+         * @brief 可渲染对象的缓存项。
+         *
+         * 只有精灵组件（加变换组件）的对象有包围盒，按包围盒登记到空间索引中参与裁剪；
+         * 瓦片层、视差背景等没有有限包围盒的对象每帧都渲染（它们在组件内部自行裁剪）。
+         * 缓存只在对象登记变化（见 GameObject::markRenderDirty）后刷新，静止的对象每帧没有开销。
+         */
+        struct RenderEntry {
+            engine::object::GameObject* object = nullptr;
+            std::uint64_t sequence = 0;             ///< @brief 加入渲染列表的序号（删除时与末尾交换，下标不保序，按序号恢复加入顺序）
+            engine::component::TransformComponent* transform = nullptr;     ///< @brief 有包围盒时非空
+            engine::component::SpriteComponent* sprite = nullptr;           ///< @brief 有包围盒时非空
+            engine::utils::Rect bounds = { { 0.0f, 0.0f }, { 0.0f, 0.0f } }; ///< @brief 缓存的世界包围盒
+            std::uint32_t component_version = 0;    ///< @brief 解析组件指针时对象的组件版本号
+            std::uint32_t transform_version = 0;    ///< @brief 计算包围盒时的变换版本号
+            std::uint32_t geometry_version = 0;     ///< @brief 计算包围盒时的精灵几何版本号
+            bool is_resolved = false;               ///< @brief 组件指针与包围盒是否已计算
+        };
+
+        std::vector<RenderEntry> renderables_;                                          ///< @brief 可渲染对象（稠密数组，下标即空间索引中的 id）
+        std::unordered_map<engine::object::GameObject*, std::uint32_t> renderable_index_; ///< @brief 对象 -> renderables_ 中的下标
+        SpatialGrid render_grid_;                                                       ///< @brief 有包围盒的可渲染对象的空间索引
+        std::vector<std::uint32_t> unbounded_;                                          ///< @brief 没有包围盒、每帧都渲染的对象下标（瓦片层、视差背景，数量很少）
+        std::vector<engine::object::GameObject*> render_dirty_;                         ///< @brief 上次渲染以来变换、精灵几何或组件发生变化的对象
+        std::vector<std::uint32_t> visible_;                                            ///< @brief 本帧的候选下标（复用缓冲）
+        std::size_t visible_count_ = 0;                                                 ///< @brief 上一帧通过裁剪的对象数量
+        std::uint64_t next_render_sequence_ = 0;                                        ///< @brief 下一个加入渲染列表的对象的序号
+
     protected:
         std::string scene_name_;                            ///< @brief 场景名称
         engine::core::Context& context_;                    ///< @brief 上下文引用（隐式，构造时传入）
@@ -65,6 +103,7 @@ namespace engine::scene {
         virtual void clean();                       ///< @brief 清理场景。
 
         /// @brief 直接向场景中添加一个游戏对象。（初始化时可用，游戏进行中不安全） （&&表示右值引用，与std::move搭配使用，避免拷贝）
+        /// @note 可渲染组件（精灵、瓦片层、视差）需要在加入场景之前添加，加入时才会登记到渲染列表中。
         virtual void addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
 
         /// @brief 安全地添加游戏对象。（添加到pending_additions_中）
@@ -94,6 +133,13 @@ namespace engine::scene {
 
     protected:
         void processPendingAdditions();     ///< @brief 处理待添加的游戏对象。（每轮更新的最后调用）
+        std::size_t getRenderableCount() const { return renderables_.size(); }   ///< @brief 渲染列表中的对象数量
+        std::size_t getVisibleCount() const { return visible_count_; }            ///< @brief 上一帧通过裁剪的对象数量
+
+    private:
+        void registerRenderable(engine::object::GameObject* game_object);      ///< @brief 可渲染对象加入渲染列表
+        void unregisterRenderable(engine::object::GameObject* game_object);    ///< @brief 从渲染列表中移除（交换删除）
+        void refreshRenderEntry(std::uint32_t index);                           ///< @brief 对象登记变化后更新缓存的组件指针、包围盒与空间索引
     };
 
 } // namespace engine::scene
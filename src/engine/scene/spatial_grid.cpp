@@ -0,0 +1,138 @@
+#include "spatial_grid.h"
+#if ENGINE_DEBUG_DRAW
+#include "../render/renderer.h"
+#include "../render/camera.h"
+#endif
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    SpatialGrid::SpatialGrid(float cell_size)
+        : cell_size_(cell_size > 0.0f ? cell_size : 256.0f)
+    {
+        spdlog::trace("SpatialGrid 构造完成，格子边长 {}。", cell_size_);
+    }
+
+    void SpatialGrid::insert(std::uint32_t id, const engine::utils::Rect& bounds) {
+        if (id >= items_.size()) {
+            items_.resize(static_cast<std::size_t>(id) + 1);
+        }
+        auto& item = items_[id];
+        if (item.is_present) {
+            update(id, bounds);
+            return;
+        }
+        item.range = computeRange(bounds);
+        item.is_present = true;
+        addToCells(id, item.range);
+    }
+
+    void SpatialGrid::update(std::uint32_t id, const engine::utils::Rect& bounds) {
+        if (!contains(id)) {
+            insert(id, bounds);
+            return;
+        }
+        auto& item = items_[id];
+        const CellRange range = computeRange(bounds);
+        if (range.min == item.range.min && range.max == item.range.max) {
+            return;     // 仍在相同的格子中
+        }
+        removeFromCells(id, item.range);
+        item.range = range;
+        addToCells(id, item.range);
+    }
+
+    void SpatialGrid::remove(std::uint32_t id) {
+        if (!contains(id)) {
+            return;
+        }
+        auto& item = items_[id];
+        removeFromCells(id, item.range);
+        item.is_present = false;
+    }
+
+    void SpatialGrid::clear() {
+        cells_.clear();
+        items_.clear();
+        query_stamp_ = 0;
+    }
+
+    void SpatialGrid::query(const engine::utils::Rect& area, std::vector<std::uint32_t>& out) {
+        if (++query_stamp_ == 0) {      // 编号回绕时重置所有标记，避免误判为已命中
+            for (auto& item : items_) {
+                item.query_stamp = 0;
+            }
+            query_stamp_ = 1;
+        }
+        const CellRange range = computeRange(area);
+        for (int y = range.min.y; y <= range.max.y; ++y) {
+            for (int x = range.min.x; x <= range.max.x; ++x) {
+                auto it = cells_.find(cellKey(x, y));
+                if (it == cells_.end()) {
+                    continue;
+                }
+                for (auto id : it->second) {
+                    auto& item = items_[id];
+                    if (item.query_stamp != query_stamp_) {     // 跨多个格子的对象只输出一次
+                        item.query_stamp = query_stamp_;
+                        out.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+#if ENGINE_DEBUG_DRAW
+    void SpatialGrid::debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const {
+        const CellRange range = computeRange({ camera.getPosition(), camera.getViewportSize() });
+        for (int y = range.min.y; y <= range.max.y; ++y) {
+            for (int x = range.min.x; x <= range.max.x; ++x) {
+                auto it = cells_.find(cellKey(x, y));
+                if (it != cells_.end() && !it->second.empty()) {
+                    renderer.debugRect(camera, { glm::vec2(x, y) * cell_size_, glm::vec2(cell_size_) }, engine::render::debug_color::GRID_CELL);
+                }
+            }
+        }
+    }
+#endif
+
+    SpatialGrid::CellRange SpatialGrid::computeRange(const engine::utils::Rect& bounds) const {
+        CellRange range;
+        range.min = { static_cast<int>(std::floor(bounds.position.x / cell_size_)),
+                      static_cast<int>(std::floor(bounds.position.y / cell_size_)) };
+        range.max = { static_cast<int>(std::floor((bounds.position.x + bounds.size.x) / cell_size_)),
+                      static_cast<int>(std::floor((bounds.position.y + bounds.size.y) / cell_size_)) };
+        return range;
+    }
+
+    void SpatialGrid::addToCells(std::uint32_t id, const CellRange& range) {
+        for (int y = range.min.y; y <= range.max.y; ++y) {
+            for (int x = range.min.x; x <= range.max.x; ++x) {
+                cells_[cellKey(x, y)].push_back(id);
+            }
+        }
+    }
+
+    void SpatialGrid::removeFromCells(std::uint32_t id, const CellRange& range) {
+        for (int y = range.min.y; y <= range.max.y; ++y) {
+            for (int x = range.min.x; x <= range.max.x; ++x) {
+                auto it = cells_.find(cellKey(x, y));
+                if (it == cells_.end()) {
+                    continue;
+                }
+                auto& ids = it->second;
+                if (auto pos = std::find(ids.begin(), ids.end(), id); pos != ids.end()) {
+                    *pos = ids.back();      // 格子内顺序无关，交换删除
+                    ids.pop_back();     // 空格子保留，对象来回移动时不必反复分配
+                }
+            }
+        }
+    }
+
+    std::uint64_t SpatialGrid::cellKey(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+} // namespace engine::scene
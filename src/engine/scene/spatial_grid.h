@@ -0,0 +1,76 @@
+#pragma once
+#include "../utils/math.h"
+#include "../render/debug_draw.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::render {
+    class Renderer;
+    class Camera;
+}
+
+namespace engine::scene {
+
+    /**
+     * @brief 均匀网格空间索引，用于按矩形快速查询可能相交的对象。
+     *
+     * 对象以调用者分配的连续整数 id 标识（通常就是对象在某个稠密数组中的下标），
+     * 按包围盒覆盖的格子登记。更新时只有覆盖的格子范围变化才重新登记，小幅移动几乎没有开销。
+     * 查询结果可能包含实际不相交的对象（同一格子中的邻居），调用者需要自行做精确测试。
+     */
+    class SpatialGrid final {
+    private:
+        /// @brief 对象覆盖的格子范围（闭区间）
+        struct CellRange {
+            glm::ivec2 min = { 0, 0 };
+            glm::ivec2 max = { -1, -1 };
+        };
+
+        /// @brief 单个对象的登记信息
+        struct Item {
+            CellRange range;                    ///< @brief 当前登记的格子范围
+            std::uint32_t query_stamp = 0;      ///< @brief 最近一次被查询命中的编号，用于去重
+            bool is_present = false;            ///< @brief 是否已登记
+        };
+
+        float cell_size_;                                                       ///< @brief 格子边长（像素）
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_;   ///< @brief 格子坐标 -> 对象 id
+        std::vector<Item> items_;                                               ///< @brief 以 id 为下标的登记信息
+        std::uint32_t query_stamp_ = 0;                                         ///< @brief 查询编号
+
+    public:
+        explicit SpatialGrid(float cell_size = 256.0f);
+
+        // 禁止拷贝和移动
+        SpatialGrid(const SpatialGrid&) = delete;
+        SpatialGrid& operator=(const SpatialGrid&) = delete;
+        SpatialGrid(SpatialGrid&&) = delete;
+        SpatialGrid& operator=(SpatialGrid&&) = delete;
+
+        void insert(std::uint32_t id, const engine::utils::Rect& bounds);      ///< @brief 登记对象（已登记时等同于 update）
+        void update(std::uint32_t id, const engine::utils::Rect& bounds);      ///< @brief 更新对象的包围盒，格子范围不变时直接返回
+        void remove(std::uint32_t id);                                          ///< @brief 移除对象
+        void clear();                                                           ///< @brief 移除所有对象
+
+        /**
+         * @brief 把与矩形所在格子重叠的对象 id 追加到 out 中（每个 id 只出现一次，顺序不定）。
+         */
+        void query(const engine::utils::Rect& area, std::vector<std::uint32_t>& out);
+
+        bool contains(std::uint32_t id) const { return id < items_.size() && items_[id].is_present; }  ///< @brief 对象是否已登记
+        float getCellSize() const { return cell_size_; }                       ///< @brief 获取格子边长
+
+#if ENGINE_DEBUG_DRAW
+        void debugDraw(engine::render::Renderer& renderer, const engine::render::Camera& camera) const;  ///< @brief 录制视口内有对象的格子边框
+#endif
+
+    private:
+        CellRange computeRange(const engine::utils::Rect& bounds) const;       ///< @brief 计算包围盒覆盖的格子范围
+        void addToCells(std::uint32_t id, const CellRange& range);
+        void removeFromCells(std::uint32_t id, const CellRange& range);
+        static std::uint64_t cellKey(int x, int y);                             ///< @brief 把格子坐标打包为哈希键
+    };
+
+} // namespace engine::scene
@@ -0,0 +1,156 @@
+#include "tile_chunk_streamer.h"
+#include "../utils/compression.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    // --- TileChunkSource ---
+
+    TileChunkSource::TileChunkSource(glm::ivec2 chunk_size, glm::ivec2 grid_size, std::vector<Chunk>&& chunks,
+        std::shared_ptr<const std::vector<std::uint16_t>> gid_palette)
+        : chunk_size_(chunk_size),
+        grid_size_(grid_size),
+        chunks_(std::move(chunks)),
+        gid_palette_(std::move(gid_palette))
+    {
+        if (chunks_.size() != static_cast<std::size_t>(grid_size_.x) * static_cast<std::size_t>(grid_size_.y)) {
+            spdlog::error("TileChunkSource: 分块数量 {} 与网格尺寸 {}x{} 不匹配，分块数据将被清除。", chunks_.size(), grid_size_.x, grid_size_.y);
+            chunks_.assign(static_cast<std::size_t>(grid_size_.x) * static_cast<std::size_t>(grid_size_.y), {});
+        }
+        if (!gid_palette_) {
+            gid_palette_ = std::make_shared<const std::vector<std::uint16_t>>();
+        }
+    }
+
+    std::size_t TileChunkSource::getEncodedBytes() const {
+        std::size_t bytes = 0;
+        for (const auto& chunk : chunks_) {
+            bytes += chunk.bytes.size();
+        }
+        return bytes;
+    }
+
+    bool TileChunkSource::decode(glm::ivec2 chunk_pos, std::vector<std::uint16_t>& cells) const {
+        const auto cell_count = static_cast<std::size_t>(chunk_size_.x) * static_cast<std::size_t>(chunk_size_.y);
+        cells.assign(cell_count, 0);
+        if (chunk_pos.x < 0 || chunk_pos.x >= grid_size_.x || chunk_pos.y < 0 || chunk_pos.y >= grid_size_.y) {
+            return false;
+        }
+        const auto& chunk = chunks_[static_cast<std::size_t>(chunk_pos.y) * grid_size_.x + chunk_pos.x];
+        if (chunk.bytes.empty()) {      // 地图中没有这个分块：全部为空瓦片
+            return true;
+        }
+
+        if (chunk.encoding == Encoding::PALETTE_INDICES) {
+            if (chunk.bytes.size() != cell_count * 2) {
+                spdlog::error("分块 ({}, {}) 的数据长度无效。", chunk_pos.x, chunk_pos.y);
+                return false;
+            }
+            for (std::size_t i = 0; i < cell_count; ++i) {
+                cells[i] = static_cast<std::uint16_t>(chunk.bytes[i * 2] | (chunk.bytes[i * 2 + 1] << 8));
+            }
+            return true;
+        }
+
+        // gid：先解压，再通过 gid -> 调色板下标表转换
+        std::vector<std::uint8_t> inflated;
+        const std::vector<std::uint8_t>* gid_bytes = &chunk.bytes;
+        if (chunk.encoding == Encoding::ZLIB || chunk.encoding == Encoding::GZIP) {
+            const bool is_inflated = chunk.encoding == Encoding::ZLIB ?
+                engine::utils::inflateZlib(chunk.bytes, inflated, cell_count * 4) :
+                engine::utils::inflateGzip(chunk.bytes, inflated, cell_count * 4);
+            if (!is_inflated) {
+                spdlog::error("分块 ({}, {}) 解压失败。", chunk_pos.x, chunk_pos.y);
+                return false;
+            }
+            gid_bytes = &inflated;
+        }
+        if (gid_bytes->size() != cell_count * 4) {
+            spdlog::error("分块 ({}, {}) 的数据长度无效：{} 字节，应为 {} 字节。", chunk_pos.x, chunk_pos.y, gid_bytes->size(), cell_count * 4);
+            return false;
+        }
+        const auto& gid_palette = *gid_palette_;
+        const auto* bytes = gid_bytes->data();
+        for (std::size_t i = 0; i < cell_count; ++i, bytes += 4) {
+            const auto gid = std::uint32_t{ bytes[0] } | (std::uint32_t{ bytes[1] } << 8) |
+                (std::uint32_t{ bytes[2] } << 16) | (std::uint32_t{ bytes[3] } << 24);
+            cells[i] = gid < gid_palette.size() ? gid_palette[gid] : 0;
+        }
+        return true;
+    }
+
+    // --- TileChunkStreamer ---
+
+    TileChunkStreamer::TileChunkStreamer(int radius)
+        : radius_(std::max(radius, 0))
+    {
+        worker_ = std::thread(&TileChunkStreamer::workerLoop, this);
+        spdlog::trace("TileChunkStreamer 构造成功，流式半径 {} 个分块。", radius_);
+    }
+
+    TileChunkStreamer::~TileChunkStreamer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+            requests_.clear();
+            results_.clear();
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void TileChunkStreamer::request(std::shared_ptr<const TileChunkSource> source, glm::ivec2 chunk) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            requests_.push_back({ std::move(source), chunk });
+        }
+        cv_.notify_one();
+    }
+
+    void TileChunkStreamer::collect(const TileChunkSource* source, std::vector<Result>& results) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::remove_if(results_.begin(), results_.end(), [&](Result& result) {
+            if (result.source.get() == source) {
+                results.push_back(std::move(result));
+                return true;
+            }
+            return result.source.use_count() == 1;      // 只剩这里持有：瓦片层已经销毁
+        });
+        results_.erase(it, results_.end());
+    }
+
+    void TileChunkStreamer::cancel(const TileChunkSource* source) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.erase(std::remove_if(requests_.begin(), requests_.end(),
+            [&](const Request& request) { return request.source.get() == source; }), requests_.end());
+        results_.erase(std::remove_if(results_.begin(), results_.end(),
+            [&](const Result& result) { return result.source.get() == source; }), results_.end());
+    }
+
+    void TileChunkStreamer::workerLoop() {
+        while (true) {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !requests_.empty() || is_stopping_; });
+                if (is_stopping_) {
+                    return;
+                }
+                request = std::move(requests_.front());
+                requests_.pop_front();
+            }
+
+            Result result{ std::move(request.source), request.chunk, {} };
+            result.source->decode(result.chunk, result.cells);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!is_stopping_) {
+                results_.push_back(std::move(result));
+            }
+        }
+    }
+
+} // namespace engine::scene
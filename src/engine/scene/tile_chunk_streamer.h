@@ -0,0 +1,137 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::scene {
+
+    /**
+     * @brief 分块瓦片层（Tiled 无限地图）的数据来源，构造完成后不可变，可以在多个线程间共享。
+     *
+     * 每个分块保存文件中的原始编码（base64 解码后的字节，zlib / gzip 数据保持压缩），
+     * 需要时才解码为调色板下标，因此常驻内存的只有压缩数据与当前在相机附近的分块。
+     * csv 编码的分块在加载时直接转换为调色板下标（每格 2 字节）。
+     */
+    class TileChunkSource final {
+    public:
+        /// @brief 分块数据的编码
+        enum class Encoding : std::uint8_t {
+            PALETTE_INDICES,    ///< @brief 已转换的调色板下标（小端 uint16，来自 csv）
+            GIDS,               ///< @brief 未压缩的 gid（小端 uint32）
+            ZLIB,               ///< @brief zlib 压缩的 gid
+            GZIP,               ///< @brief gzip 压缩的 gid
+        };
+
+        /// @brief 单个分块的原始数据
+        struct Chunk {
+            Encoding encoding = Encoding::PALETTE_INDICES;
+            std::vector<std::uint8_t> bytes;
+        };
+
+    private:
+        glm::ivec2 chunk_size_;                             ///< @brief 分块尺寸（瓦片数）
+        glm::ivec2 grid_size_;                              ///< @brief 分块网格尺寸（分块数）
+        std::vector<Chunk> chunks_;                         ///< @brief 行主序的分块（没有数据的分块 bytes 为空）
+        std::shared_ptr<const std::vector<std::uint16_t>> gid_palette_;    ///< @brief gid -> 调色板下标（本地图所有瓦片层共享）
+
+    public:
+        /**
+         * @brief 构造函数。
+         * @param chunk_size 分块尺寸（瓦片数）
+         * @param grid_size 分块网格尺寸（分块数）
+         * @param chunks 行主序的分块，数量必须等于 grid_size.x * grid_size.y
+         * @param gid_palette gid -> 调色板下标，越界或未收录的 gid 按空瓦片处理
+         */
+        TileChunkSource(glm::ivec2 chunk_size, glm::ivec2 grid_size, std::vector<Chunk>&& chunks,
+            std::shared_ptr<const std::vector<std::uint16_t>> gid_palette);
+
+        glm::ivec2 getChunkSize() const { return chunk_size_; }     ///< @brief 分块尺寸（瓦片数）
+        glm::ivec2 getGridSize() const { return grid_size_; }       ///< @brief 分块网格尺寸（分块数）
+        std::size_t getEncodedBytes() const;                        ///< @brief 所有分块原始数据的字节数
+
+        /**
+         * @brief 把分块解码为调色板下标（任意线程可用）。
+         * @param chunk 分块坐标 (0 <= x < grid_size.x, 0 <= y < grid_size.y)
+         * @param cells 输出：行主序的调色板下标，长度为 chunk_size.x * chunk_size.y；没有数据的分块全部为 0
+         * @return 是否成功，数据损坏时 cells 全部为 0 并记录错误日志
+         */
+        bool decode(glm::ivec2 chunk, std::vector<std::uint16_t>& cells) const;
+    };
+
+    /**
+     * @brief 在后台线程上解码分块瓦片层的分块。
+     *
+     * 瓦片层在游戏线程上请求相机附近的分块，并在之后的帧里用 collect() 取回解码结果，
+     * 因此渲染与物理碰撞看到的瓦片只会在游戏线程上、两帧之间变化。流式半径由配置决定。
+     */
+    class TileChunkStreamer final {
+    public:
+        /// @brief 解码完成的分块
+        struct Result {
+            std::shared_ptr<const TileChunkSource> source;  ///< @brief 所属数据来源（持有到取回为止，地址不会被复用）
+            glm::ivec2 chunk{};                             ///< @brief 分块坐标
+            std::vector<std::uint16_t> cells;               ///< @brief 调色板下标
+        };
+
+    private:
+        /// @brief 等待解码的请求
+        struct Request {
+            std::shared_ptr<const TileChunkSource> source;
+            glm::ivec2 chunk{};
+        };
+
+        int radius_ = 1;                    ///< @brief 视口之外预先加载的分块圈数
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<Request> requests_;      ///< @brief 等待解码的请求（受 mutex_ 保护）
+        std::vector<Result> results_;       ///< @brief 解码完成、等待取回的分块（受 mutex_ 保护）
+        bool is_stopping_ = false;          ///< @brief 通知后台线程退出（受 mutex_ 保护）
+        std::thread worker_;
+
+    public:
+        /**
+         * @brief 构造函数，启动后台线程。
+         * @param radius 视口之外预先加载的分块圈数（小于 0 视为 0）
+         */
+        explicit TileChunkStreamer(int radius);
+        ~TileChunkStreamer();   ///< @brief 放弃未开始的请求，等待正在解码的分块完成后退出后台线程
+
+        // 禁止拷贝和移动
+        TileChunkStreamer(const TileChunkStreamer&) = delete;
+        TileChunkStreamer& operator=(const TileChunkStreamer&) = delete;
+        TileChunkStreamer(TileChunkStreamer&&) = delete;
+        TileChunkStreamer& operator=(TileChunkStreamer&&) = delete;
+
+        int getRadius() const { return radius_; }       ///< @brief 视口之外预先加载的分块圈数
+
+        /**
+         * @brief 请求在后台解码分块。调用者负责避免重复请求同一分块。
+         * @param source 数据来源（请求期间由后台线程共享持有）
+         * @param chunk 分块坐标
+         */
+        void request(std::shared_ptr<const TileChunkSource> source, glm::ivec2 chunk);
+
+        /**
+         * @brief 取回属于指定数据来源的解码结果（追加到 results），同时丢弃已经没有瓦片层使用的数据来源的结果。
+         * @param source 数据来源
+         * @param results 输出
+         */
+        void collect(const TileChunkSource* source, std::vector<Result>& results);
+
+        /**
+         * @brief 放弃属于指定数据来源的所有未开始请求与未取回结果（瓦片层销毁时调用）。
+         * @param source 数据来源
+         */
+        void cancel(const TileChunkSource* source);
+
+    private:
+        void workerLoop();      ///< @brief 后台线程
+    };
+
+} // namespace engine::scene
@@ -0,0 +1,450 @@
+#include "compression.h"
+#include <array>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+    namespace {
+        /// @brief 从低位开始按位读取 DEFLATE 数据流
+        class BitReader {
+            std::span<const std::uint8_t> input_;
+            std::size_t position_ = 0;      ///< @brief 下一个要读入的字节
+            std::uint32_t buffer_ = 0;      ///< @brief 已读入但未消耗的位
+            int bit_count_ = 0;             ///< @brief buffer_ 中的有效位数
+
+        public:
+            explicit BitReader(std::span<const std::uint8_t> input) : input_(input) {}
+
+            /// @brief 读取 count（<= 24）位，数据不足时返回 false
+            bool read(int count, std::uint32_t& value) {
+                while (bit_count_ < count) {
+                    if (position_ >= input_.size()) {
+                        return false;
+                    }
+                    buffer_ |= static_cast<std::uint32_t>(input_[position_++]) << bit_count_;
+                    bit_count_ += 8;
+                }
+                value = buffer_ & ((1u << count) - 1u);
+                buffer_ >>= count;
+                bit_count_ -= count;
+                return true;
+            }
+
+            /// @brief 丢弃当前字节中剩余的位（存储块从字节边界开始）
+            void alignToByte() {
+                buffer_ = 0;
+                bit_count_ = 0;
+            }
+
+            /// @brief 直接读取 count 个字节（必须已对齐到字节边界）
+            std::span<const std::uint8_t> readBytes(std::size_t count) {
+                if (input_.size() - position_ < count) {
+                    return {};
+                }
+                auto bytes = input_.subspan(position_, count);
+                position_ += count;
+                return bytes;
+            }
+
+            std::size_t getPosition() const { return position_; }   ///< @brief 已读入的字节数（对齐后即已消耗的字节数）
+        };
+
+        constexpr int MAX_CODE_BITS = 15;       ///< @brief DEFLATE 中 Huffman 码的最大长度
+        constexpr int MAX_LITERAL_CODES = 288;  ///< @brief 字面量/长度码表的大小
+        constexpr int MAX_DISTANCE_CODES = 30;  ///< @brief 距离码表的大小
+
+        /// @brief 规范 Huffman 码表：每种长度的码数与按码值排序的符号
+        struct Huffman {
+            std::array<std::uint16_t, MAX_CODE_BITS + 1> counts{};
+            std::array<std::uint16_t, MAX_LITERAL_CODES> symbols{};
+
+            /// @brief 由每个符号的码长构建码表，码长超额（不可能的编码）时返回 false
+            bool build(const std::uint8_t* lengths, int symbol_count) {
+                counts.fill(0);
+                for (int symbol = 0; symbol < symbol_count; ++symbol) {
+                    ++counts[lengths[symbol]];
+                }
+                int left = 1;
+                for (int length = 1; length <= MAX_CODE_BITS; ++length) {
+                    left = (left << 1) - counts[length];
+                    if (left < 0) {
+                        return false;
+                    }
+                }
+                std::array<std::uint16_t, MAX_CODE_BITS + 1> offsets{};
+                for (int length = 1; length < MAX_CODE_BITS; ++length) {
+                    offsets[length + 1] = offsets[length] + counts[length];
+                }
+                for (int symbol = 0; symbol < symbol_count; ++symbol) {
+                    if (lengths[symbol] != 0) {
+                        symbols[offsets[lengths[symbol]]++] = static_cast<std::uint16_t>(symbol);
+                    }
+                }
+                return true;
+            }
+
+            /// @brief 逐位解码一个符号，无效编码或数据不足时返回 -1
+            int decode(BitReader& reader) const {
+                int code = 0;       // 当前已读的码
+                int first = 0;      // 当前长度的第一个码
+                int index = 0;      // 当前长度的第一个符号在 symbols 中的下标
+                for (int length = 1; length <= MAX_CODE_BITS; ++length) {
+                    std::uint32_t bit = 0;
+                    if (!reader.read(1, bit)) {
+                        return -1;
+                    }
+                    code |= static_cast<int>(bit);
+                    const int count = counts[length];
+                    if (code - first < count) {
+                        return symbols[index + (code - first)];
+                    }
+                    index += count;
+                    first = (first + count) << 1;
+                    code <<= 1;
+                }
+                return -1;
+            }
+        };
+
+        constexpr std::array<std::uint16_t, 29> LENGTH_BASE = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        constexpr std::array<std::uint8_t, 29> LENGTH_EXTRA = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        constexpr std::array<std::uint16_t, 30> DISTANCE_BASE = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+            1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        constexpr std::array<std::uint8_t, 30> DISTANCE_EXTRA = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        /// @brief 用给定码表解码一个压缩块的内容，直到块结束符
+        bool inflateCodes(BitReader& reader, const Huffman& literal_codes, const Huffman& distance_codes,
+            std::vector<std::uint8_t>& output, std::size_t max_size) {
+            while (true) {
+                const int symbol = literal_codes.decode(reader);
+                if (symbol < 0) {
+                    return false;
+                }
+                if (symbol < 256) {         // 字面量
+                    if (output.size() >= max_size) {
+                        return false;
+                    }
+                    output.push_back(static_cast<std::uint8_t>(symbol));
+                    continue;
+                }
+                if (symbol == 256) {        // 块结束
+                    return true;
+                }
+                // 长度 + 距离：复制之前输出的数据（可能与自身重叠）
+                const int length_symbol = symbol - 257;
+                std::uint32_t extra = 0;
+                if (length_symbol >= static_cast<int>(LENGTH_BASE.size()) || !reader.read(LENGTH_EXTRA[length_symbol], extra)) {
+                    return false;
+                }
+                const std::size_t length = LENGTH_BASE[length_symbol] + extra;
+                const int distance_symbol = distance_codes.decode(reader);
+                if (distance_symbol < 0 || distance_symbol >= static_cast<int>(DISTANCE_BASE.size()) ||
+                    !reader.read(DISTANCE_EXTRA[distance_symbol], extra)) {
+                    return false;
+                }
+                const std::size_t distance = DISTANCE_BASE[distance_symbol] + extra;
+                if (distance > output.size() || output.size() + length > max_size) {
+                    return false;
+                }
+                std::size_t from = output.size() - distance;
+                for (std::size_t i = 0; i < length; ++i) {
+                    output.push_back(output[from++]);
+                }
+            }
+        }
+
+        /// @brief 固定 Huffman 码表（RFC 1951 3.2.6），只构建一次
+        const std::pair<Huffman, Huffman>& getFixedCodes() {
+            static const auto codes = [] {
+                std::pair<Huffman, Huffman> fixed;
+                std::array<std::uint8_t, MAX_LITERAL_CODES> lengths{};
+                for (int symbol = 0; symbol < MAX_LITERAL_CODES; ++symbol) {
+                    lengths[symbol] = symbol < 144 ? 8 : symbol < 256 ? 9 : symbol < 280 ? 7 : 8;
+                }
+                fixed.first.build(lengths.data(), MAX_LITERAL_CODES);
+                lengths.fill(5);
+                fixed.second.build(lengths.data(), MAX_DISTANCE_CODES);
+                return fixed;
+            }();
+            return codes;
+        }
+
+        /// @brief 读取动态 Huffman 块的码表（RFC 1951 3.2.7）
+        bool readDynamicCodes(BitReader& reader, Huffman& literal_codes, Huffman& distance_codes) {
+            static constexpr std::array<std::uint8_t, 19> CODE_LENGTH_ORDER = {
+                16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            std::uint32_t literal_count = 0, distance_count = 0, code_count = 0;
+            if (!reader.read(5, literal_count) || !reader.read(5, distance_count) || !reader.read(4, code_count)) {
+                return false;
+            }
+            literal_count += 257;
+            distance_count += 1;
+            code_count += 4;
+            if (literal_count > 286 || distance_count > MAX_DISTANCE_CODES) {
+                return false;
+            }
+
+            // 1. 码长的码表
+            std::array<std::uint8_t, MAX_LITERAL_CODES + MAX_DISTANCE_CODES> lengths{};
+            for (std::uint32_t i = 0; i < code_count; ++i) {
+                std::uint32_t length = 0;
+                if (!reader.read(3, length)) {
+                    return false;
+                }
+                lengths[CODE_LENGTH_ORDER[i]] = static_cast<std::uint8_t>(length);
+            }
+            Huffman length_codes;
+            if (!length_codes.build(lengths.data(), static_cast<int>(CODE_LENGTH_ORDER.size()))) {
+                return false;
+            }
+
+            // 2. 字面量/长度与距离码的码长（16 重复前一个，17/18 重复 0）
+            lengths.fill(0);
+            std::uint32_t index = 0;
+            while (index < literal_count + distance_count) {
+                const int symbol = length_codes.decode(reader);
+                if (symbol < 0) {
+                    return false;
+                }
+                if (symbol < 16) {
+                    lengths[index++] = static_cast<std::uint8_t>(symbol);
+                    continue;
+                }
+                std::uint8_t repeat_length = 0;
+                std::uint32_t repeat = 0;
+                if (symbol == 16) {
+                    if (index == 0 || !reader.read(2, repeat)) {
+                        return false;
+                    }
+                    repeat_length = lengths[index - 1];
+                    repeat += 3;
+                }
+                else if (symbol == 17) {
+                    if (!reader.read(3, repeat)) {
+                        return false;
+                    }
+                    repeat += 3;
+                }
+                else {
+                    if (!reader.read(7, repeat)) {
+                        return false;
+                    }
+                    repeat += 11;
+                }
+                if (index + repeat > literal_count + distance_count) {
+                    return false;
+                }
+                while (repeat-- > 0) {
+                    lengths[index++] = repeat_length;
+                }
+            }
+            if (lengths[256] == 0) {        // 必须能编码块结束符
+                return false;
+            }
+            return literal_codes.build(lengths.data(), static_cast<int>(literal_count)) &&
+                distance_codes.build(lengths.data() + literal_count, static_cast<int>(distance_count));
+        }
+
+        /**
+         * @brief 解压原始 DEFLATE 数据流（RFC 1951）。
+         * @param consumed 输出：压缩数据占用的字节数（之后是容器格式的校验信息）
+         */
+        bool inflateRaw(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& output, std::size_t max_size, std::size_t& consumed) {
+            BitReader reader(input);
+            std::uint32_t is_last = 0;
+            do {
+                std::uint32_t block_type = 0;
+                if (!reader.read(1, is_last) || !reader.read(2, block_type)) {
+                    return false;
+                }
+                if (block_type == 0) {          // 存储块
+                    reader.alignToByte();
+                    const auto header = reader.readBytes(4);
+                    if (header.empty()) {
+                        return false;
+                    }
+                    const std::size_t length = header[0] | (header[1] << 8);
+                    const std::size_t inverted = header[2] | (header[3] << 8);
+                    if (length != (~inverted & 0xFFFFu) || output.size() + length > max_size) {
+                        return false;
+                    }
+                    const auto bytes = reader.readBytes(length);
+                    if (bytes.size() != length) {
+                        return false;
+                    }
+                    output.insert(output.end(), bytes.begin(), bytes.end());
+                }
+                else if (block_type == 1) {     // 固定 Huffman 码表
+                    const auto& [literal_codes, distance_codes] = getFixedCodes();
+                    if (!inflateCodes(reader, literal_codes, distance_codes, output, max_size)) {
+                        return false;
+                    }
+                }
+                else if (block_type == 2) {     // 动态 Huffman 码表
+                    Huffman literal_codes;
+                    Huffman distance_codes;
+                    if (!readDynamicCodes(reader, literal_codes, distance_codes) ||
+                        !inflateCodes(reader, literal_codes, distance_codes, output, max_size)) {
+                        return false;
+                    }
+                }
+                else {
+                    return false;
+                }
+            } while (!is_last);
+            reader.alignToByte();
+            consumed = reader.getPosition();
+            return true;
+        }
+
+        std::uint32_t adler32(std::span<const std::uint8_t> data) {
+            constexpr std::uint32_t MOD_ADLER = 65521;
+            std::uint32_t a = 1, b = 0;
+            for (const auto byte : data) {
+                a = (a + byte) % MOD_ADLER;
+                b = (b + a) % MOD_ADLER;
+            }
+            return (b << 16) | a;
+        }
+
+        std::uint32_t crc32(std::span<const std::uint8_t> data) {
+            static const auto table = [] {
+                std::array<std::uint32_t, 256> crc_table{};
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    std::uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        crc = (crc & 1u) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                    }
+                    crc_table[i] = crc;
+                }
+                return crc_table;
+            }();
+            std::uint32_t crc = 0xFFFFFFFFu;
+            for (const auto byte : data) {
+                crc = table[(crc ^ byte) & 0xFFu] ^ (crc >> 8);
+            }
+            return crc ^ 0xFFFFFFFFu;
+        }
+
+        std::uint32_t readBigEndian32(const std::uint8_t* bytes) {
+            return (std::uint32_t{ bytes[0] } << 24) | (std::uint32_t{ bytes[1] } << 16) | (std::uint32_t{ bytes[2] } << 8) | bytes[3];
+        }
+
+        std::uint32_t readLittleEndian32(const std::uint8_t* bytes) {
+            return std::uint32_t{ bytes[0] } | (std::uint32_t{ bytes[1] } << 8) | (std::uint32_t{ bytes[2] } << 16) | (std::uint32_t{ bytes[3] } << 24);
+        }
+    }
+
+    bool decodeBase64(std::string_view text, std::vector<std::uint8_t>& output) {
+        static const auto table = [] {
+            std::array<std::int8_t, 256> decode_table{};
+            decode_table.fill(-1);
+            constexpr std::string_view ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (std::size_t i = 0; i < ALPHABET.size(); ++i) {
+                decode_table[static_cast<std::uint8_t>(ALPHABET[i])] = static_cast<std::int8_t>(i);
+            }
+            return decode_table;
+        }();
+
+        output.clear();
+        output.reserve(text.size() / 4 * 3);
+        std::uint32_t buffer = 0;
+        int bit_count = 0;
+        std::size_t padding = 0;
+        for (const char c : text) {
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                continue;
+            }
+            if (c == '=') {
+                ++padding;
+                continue;
+            }
+            const auto value = table[static_cast<std::uint8_t>(c)];
+            if (value < 0 || padding > 0) {     // 非法字符，或填充之后又出现数据
+                spdlog::error("base64 数据中有非法字符 '{}'。", c);
+                return false;
+            }
+            buffer = (buffer << 6) | static_cast<std::uint32_t>(value);
+            bit_count += 6;
+            if (bit_count >= 8) {
+                bit_count -= 8;
+                output.push_back(static_cast<std::uint8_t>(buffer >> bit_count));
+            }
+        }
+        if (padding > 2 || bit_count >= 6) {    // 剩余 6 位以上说明少了字符
+            spdlog::error("base64 数据长度无效。");
+            return false;
+        }
+        return true;
+    }
+
+    bool inflateZlib(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& output, std::size_t max_size) {
+        output.clear();
+        // 2 字节头：CM = 8（deflate），头校验，不支持预设字典；末尾 4 字节 Adler-32（大端）
+        if (input.size() < 6 || (input[0] & 0x0F) != 8 || ((input[0] << 8) | input[1]) % 31 != 0 || (input[1] & 0x20) != 0) {
+            spdlog::error("zlib 数据头无效。");
+            return false;
+        }
+        std::size_t consumed = 0;
+        if (!inflateRaw(input.subspan(2), output, max_size, consumed) || input.size() - 2 - consumed < 4) {
+            spdlog::error("zlib 数据已损坏或超过 {} 字节。", max_size);
+            return false;
+        }
+        if (adler32(output) != readBigEndian32(input.data() + 2 + consumed)) {
+            spdlog::error("zlib 数据校验失败（Adler-32 不匹配）。");
+            return false;
+        }
+        return true;
+    }
+
+    bool inflateGzip(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& output, std::size_t max_size) {
+        output.clear();
+        // 10 字节头：ID1 ID2 = 1f 8b，CM = 8，FLG，MTIME(4)，XFL，OS；末尾 CRC-32 与原始长度（小端）
+        enum : std::uint8_t { FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10 };
+        if (input.size() < 18 || input[0] != 0x1F || input[1] != 0x8B || input[2] != 8) {
+            spdlog::error("gzip 数据头无效。");
+            return false;
+        }
+        const std::uint8_t flags = input[3];
+        std::size_t position = 10;
+        if (flags & FEXTRA) {
+            if (input.size() < position + 2) {
+                spdlog::error("gzip 数据头无效。");
+                return false;
+            }
+            position += 2 + (input[position] | (input[position + 1] << 8));
+        }
+        for (const auto flag : { FNAME, FCOMMENT }) {   // 以 0 结尾的字符串
+            if (flags & flag) {
+                while (position < input.size() && input[position] != 0) {
+                    ++position;
+                }
+                ++position;
+            }
+        }
+        if (flags & FHCRC) {
+            position += 2;
+        }
+        if (position >= input.size()) {
+            spdlog::error("gzip 数据头无效。");
+            return false;
+        }
+
+        std::size_t consumed = 0;
+        if (!inflateRaw(input.subspan(position), output, max_size, consumed) || input.size() - position - consumed < 8) {
+            spdlog::error("gzip 数据已损坏或超过 {} 字节。", max_size);
+            return false;
+        }
+        const auto* trailer = input.data() + position + consumed;
+        if (crc32(output) != readLittleEndian32(trailer) || static_cast<std::uint32_t>(output.size()) != readLittleEndian32(trailer + 4)) {
+            spdlog::error("gzip 数据校验失败（CRC-32 或长度不匹配）。");
+            return false;
+        }
+        return true;
+    }
+
+} // namespace engine::utils
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace engine::utils {
+
+    /**
+     * @brief 解码 base64 文本（标准字母表，允许末尾的 '=' 填充，忽略空白字符）。
+     * @param text base64 文本
+     * @param output 输出：解码后的字节（先清空）
+     * @return 是否成功，失败时记录错误日志
+     */
+    bool decodeBase64(std::string_view text, std::vector<std::uint8_t>& output);
+
+    /**
+     * @brief 解压 zlib 格式（RFC 1950）的数据，并校验 Adler-32。
+     * @param input 压缩数据
+     * @param output 输出：解压后的字节（先清空）
+     * @param max_size 解压结果的最大长度，超过时视为数据无效
+     * @return 是否成功，失败时记录错误日志
+     */
+    bool inflateZlib(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& output, std::size_t max_size);
+
+    /**
+     * @brief 解压 gzip 格式（RFC 1952，单个成员）的数据，并校验 CRC-32 与长度。
+     * @param input 压缩数据
+     * @param output 输出：解压后的字节（先清空）
+     * @param max_size 解压结果的最大长度，超过时视为数据无效
+     * @return 是否成功，失败时记录错误日志
+     */
+    bool inflateGzip(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& output, std::size_t max_size);
+
+} // namespace engine::utils
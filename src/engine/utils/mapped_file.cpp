@@ -0,0 +1,110 @@
+#include "mapped_file.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::utils {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string& path) {
+        close();
+        const std::wstring wide_path = std::filesystem::path(path).wstring();
+        HANDLE file = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            spdlog::error("无法打开文件 '{}' 进行映射（错误码 {}）。", path, GetLastError());
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+            spdlog::error("文件 '{}' 为空或无法获取大小。", path);
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            spdlog::error("创建文件映射 '{}' 失败（错误码 {}）。", path, GetLastError());
+            CloseHandle(file);
+            return false;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            spdlog::error("映射文件 '{}' 失败（错误码 {}）。", path, GetLastError());
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        file_handle_ = file;
+        mapping_handle_ = mapping;
+        data_ = static_cast<const std::byte*>(view);
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_handle_) {
+            CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        }
+        if (file_handle_) {
+            CloseHandle(static_cast<HANDLE>(file_handle_));
+        }
+        data_ = nullptr;
+        size_ = 0;
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+    }
+#else
+    bool MappedFile::open(const std::string& path) {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            spdlog::error("无法打开文件 '{}' 进行映射。", path);
+            return false;
+        }
+        struct stat file_stat {};
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+            spdlog::error("文件 '{}' 为空或无法获取大小。", path);
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);    // 映射建立后即可关闭描述符
+        if (view == MAP_FAILED) {
+            spdlog::error("映射文件 '{}' 失败。", path);
+            return false;
+        }
+        data_ = static_cast<const std::byte*>(view);
+        size_ = static_cast<std::size_t>(file_stat.st_size);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) {
+            munmap(const_cast<std::byte*>(data_), size_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+
+} // namespace engine::utils
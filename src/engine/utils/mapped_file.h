@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace engine::utils {
+
+    /**
+     * @brief 只读内存映射文件。
+     *
+     * 打开后整个文件映射到进程地址空间，由操作系统按页读入，无需先拷贝到缓冲区。
+     * Windows 使用 CreateFileMapping / MapViewOfFile，其它平台使用 mmap。
+     */
+    class MappedFile final {
+    private:
+        const std::byte* data_ = nullptr;   ///< @brief 映射的起始地址
+        std::size_t size_ = 0;              ///< @brief 文件大小（字节）
+#ifdef _WIN32
+        void* file_handle_ = nullptr;       ///< @brief 文件句柄（HANDLE）
+        void* mapping_handle_ = nullptr;    ///< @brief 映射对象句柄（HANDLE）
+#endif
+
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        // 禁止拷贝和移动
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        /**
+         * @brief 映射文件（已打开时先关闭）。
+         * @param path 文件路径
+         * @return 是否成功，失败时记录错误日志
+         */
+        bool open(const std::string& path);
+        void close();                                           ///< @brief 解除映射并关闭文件
+
+        const std::byte* data() const { return data_; }         ///< @brief 获取映射的起始地址
+        std::size_t size() const { return size_; }              ///< @brief 获取文件大小
+        bool isOpen() const { return data_ != nullptr; }        ///< @brief 是否已映射
+    };
+
+} // namespace engine::utils
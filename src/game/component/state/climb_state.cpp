@@ -34,7 +34,7 @@ namespace game::component::state {
 	}
 	std::unique_ptr<PlayerState> ClimbState::handleInput(engine::core::Context&context)
 	{
-		auto input_manager = context.getInputManager();
+		auto& input_manager = context.getInputManager();
 
 		auto physics_component = player_component_->getPhysicsComponent();
 		auto animation_component = player_component_->getAnimationComponent();
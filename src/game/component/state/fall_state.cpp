@@ -21,7 +21,7 @@ namespace game::component::state {
 	std::unique_ptr<PlayerState>
 		FallState::handleInput(engine::core::Context& context)
 	{
-		auto input_manager = context.getInputManager();
+		auto& input_manager = context.getInputManager();
 		auto physics_component = player_component_->getPhysicsComponent();
 		auto sprite_component = player_component_->getSpriteComponent();
 
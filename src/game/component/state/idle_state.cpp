@@ -20,7 +20,7 @@ namespace game::component::state {
 
     std::unique_ptr<PlayerState> IdleState::handleInput(engine::core::Context& context)
     {
-        auto input_manager = context.getInputManager();
+        auto& input_manager = context.getInputManager();
         auto physics_component = player_component_->getPhysicsComponent();
         
         // 如果按"move_up"键，且与梯子重合，则切换到 ClimbState
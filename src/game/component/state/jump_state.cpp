@@ -31,7 +31,7 @@ namespace game::component::state {
 
     std::unique_ptr<PlayerState> JumpState::handleInput(engine::core::Context& context)
     {
-        auto input_manager = context.getInputManager();
+        auto& input_manager = context.getInputManager();
         auto physics_component = player_component_->getPhysicsComponent();
         auto sprite_component = player_component_->getSpriteComponent();
 
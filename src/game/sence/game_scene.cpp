@@ -1,6 +1,7 @@
 #include "game_scene.h"
 #include "../component/player_component.h"
 #include "../../engine/core/context.h"
+#include "../../engine/core/load_profiler.h"
 #include "../../engine/object/game_object.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/sprite_component.h"
@@ -12,10 +13,13 @@
 #include "../../engine/component/health_component.h"
 #include "../../engine/physics/physics_engine.h"
 #include "../../engine/scene/level_loader.h"
+#include "../../engine/scene/level_preloader.h"
 #include "../../engine/scene/scene_manager.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/render/camera.h"
-#include "../../engine/render/animation.h"
+#include "../../engine/render/particle_system.h"
+#include "../../engine/render/text_renderer.h"
+#include "../../engine/resource/resource_manager.h"
 #include "../component/ai_component.h"
 #include "../component/ai/patrol_behavior.h"
 #include "../component/ai/updown_behavior.h"
@@ -23,6 +27,9 @@
 #include "../data/session_data.h"
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL_rect.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <filesystem>
 
 namespace game::scene {
 
@@ -45,27 +52,63 @@ namespace game::scene {
         }
         spdlog::trace("GameScene 初始化开始...");
 
-        if (!initLevel()) {
-            spdlog::error("关卡初始化失败，无法继续。");
-            context_.getInputManager().setShouldQuit(true);
-            return;
+        // 分阶段记录耗时与分配，初始化完成后输出加载报告
+        engine::core::LoadProfiler load_profile(game_session_data_->getMapPath());
+        const auto texture_stats = context_.getResourceManager().getTextureLoadStats();
+        const auto audio_stats = context_.getResourceManager().getAudioLoadStats();
+        {
+            auto level_scope = load_profile.measure("scene.level");
+            if (!initLevel(load_profile)) {
+                spdlog::error("关卡初始化失败，无法继续。");
+                context_.getInputManager().setShouldQuit(true);
+                return;
+            }
         }
-        if (!initPlayer()) {
-            spdlog::error("玩家初始化失败，无法继续。");
-            context_.getInputManager().setShouldQuit(true);
-            return;
+        {
+            auto player_scope = load_profile.measure("scene.player");
+            if (!initPlayer()) {
+                spdlog::error("玩家初始化失败，无法继续。");
+                context_.getInputManager().setShouldQuit(true);
+                return;
+            }
         }
-        if (!initEnemyAndItem()) {
-            spdlog::error("敌人和道具初始化失败，无法继续。");
-            context_.getInputManager().setShouldQuit(true);
-            return;
+        {
+            auto enemy_scope = load_profile.measure("scene.enemies_and_items");
+            if (!initEnemyAndItem()) {
+                spdlog::error("敌人和道具初始化失败，无法继续。");
+                context_.getInputManager().setShouldQuit(true);
+                return;
+            }
+        }
+        {
+            auto effect_scope = load_profile.measure("scene.effects");
+            if (!initEffects()) {
+                spdlog::error("特效初始化失败，无法继续。");
+                context_.getInputManager().setShouldQuit(true);
+                return;
+            }
+        }
+        {
+            auto preload_scope = load_profile.measure("scene.level_preload");
+            initLevelPreload();
+        }
+        {
+            auto music_scope = load_profile.measure("scene.music");
+            context_.getAudioPlayer().setMusicVolume(0.2f);//背景音乐音量为20%
+            context_.getAudioPlayer().setSoundVolume(0.5f);//音效音量为50%
+            context_.getAudioPlayer().playMusic("assets/audio/hurry_up_and_run.ogg", true, 1000);
+        }
+        {
+            auto start_scope = load_profile.measure("scene.start");
+            Scene::init();
         }
 
-        context_.getAudioPlayer().setMusicVolume(0.2f);//背景音乐音量为20%
-        context_.getAudioPlayer().setSoundVolume(0.5f);//音效音量为50%
-        context_.getAudioPlayer().playMusic("assets/audio/hurry_up_and_run.ogg", true, 1000);
-
-        Scene::init();
+        // 资源管理器中的同步加载计数（纹理首次访问时解码、音效与音乐加载），分散在以上各阶段中
+        const auto texture_end = context_.getResourceManager().getTextureLoadStats();
+        const auto audio_end = context_.getResourceManager().getAudioLoadStats();
+        load_profile.addCounter("texture_first_touch", texture_end.count - texture_stats.count, texture_end.ms - texture_stats.ms);
+        load_profile.addCounter("audio_load", audio_end.count - audio_stats.count, audio_end.ms - audio_stats.ms);
+        reportLevelLoad(load_profile);
         spdlog::trace("GameScene 初始化完成。");
     }
 
@@ -73,10 +116,13 @@ namespace game::scene {
         Scene::update(delta_time);
         handleObjectCollisions();
         handleTileTriggers();
+        updateLevelPreload();
+        updateHUD();
     }
 
     void GameScene::render() {
         Scene::render();
+        renderHUD();
     }
 
     void GameScene::handleInput() {
@@ -84,15 +130,48 @@ namespace game::scene {
     }
 
     void GameScene::clean() {
+        auto& text_renderer = context_.getTextRenderer();
+        text_renderer.removeStaticText("hud_score");
+        text_renderer.removeStaticText("hud_health");
         Scene::clean();
     }
 
-    bool GameScene::initLevel()
+    void GameScene::updateHUD()
     {
-        // 加载关卡（
-        engine::scene::LevelLoader level_loader;
+        // 分数和生命值很少变化，只有变化时才重新排版
+        auto& text_renderer = context_.getTextRenderer();
+        if (int score = game_session_data_->getCurrentScore(); score != hud_score_) {
+            hud_score_ = score;
+            text_renderer.setStaticText("hud_score", "分数: " + std::to_string(score), HUD_FONT, HUD_FONT_SIZE);
+        }
+        if (int health = game_session_data_->getCurrentHealth(); health != hud_health_) {
+            hud_health_ = health;
+            text_renderer.setStaticText("hud_health", "生命: " + std::to_string(health), HUD_FONT, HUD_FONT_SIZE);
+        }
+    }
+
+    void GameScene::renderHUD()
+    {
+        if (hud_score_ < 0) {
+            return;     // 尚未更新过
+        }
+        auto& text_renderer = context_.getTextRenderer();
+        text_renderer.drawStaticText("hud_score", { 10.0f, 10.0f });
+        text_renderer.drawStaticText("hud_health", { 10.0f, 30.0f });
+    }
+
+    bool GameScene::initLevel(engine::core::LoadProfiler& load_profile)
+    {
+        // 加载关卡（优先使用后台预加载的结果，此时只需创建游戏对象）
         auto level_path = game_session_data_->getMapPath();
-        if (!level_loader.loadLevel(level_path, *this)) {
+        auto level_loader = context_.getLevelPreloader().take(level_path);
+        load_profile.setField("preloaded", level_loader != nullptr);   // 预加载时 prepare.* 阶段在后台线程上提前完成
+        if (!level_loader) {
+            level_loader = std::make_unique<engine::scene::LevelLoader>(&context_.getResourceManager(), &context_.getJobPool());
+        }
+        const bool is_loaded = level_loader->loadLevel(level_path, *this);
+        load_profile.append(level_loader->getLoadProfile());
+        if (!is_loaded) {
             spdlog::error("关卡加载失败");
             return false;
         }
@@ -122,6 +201,17 @@ namespace game::scene {
         return true;
     }
 
+    void GameScene::reportLevelLoad(const engine::core::LoadProfiler& load_profile) const
+    {
+        load_profile.logReport();
+#if ENGINE_WRITE_LOAD_REPORTS
+        // 只在 Debug（或显式开启的）构建中写文件，发布版本不在工作目录下生成 load_reports
+        const auto report_path = std::filesystem::path(LOAD_REPORT_DIR) /
+            (std::filesystem::path(game_session_data_->getMapPath()).stem().string() + ".json");
+        load_profile.writeReport(report_path.string());
+#endif
+    }
+
     bool GameScene::initPlayer()
     {
         // 获取玩家对象
@@ -138,6 +228,11 @@ namespace game::scene {
             return false;
         }
 
+        // 玩家固定绘制在所在图层的最上方（同层的敌人与道具按对象顺序排列在其下）
+        if (auto* player_sprite = player_->getComponent<engine::component::SpriteComponent>(); player_sprite) {
+            player_sprite->setRenderDepth(engine::render::MAX_RENDER_DEPTH);
+        }
+
         // 相机跟随玩家
         auto* player_transform = player_->getComponent<engine::component::TransformComponent>();
         if (!player_transform) {
@@ -316,42 +411,73 @@ namespace game::scene {
         scene_manager_.requestReplaceScene(std::move(next_scene));
     }
 
-    void GameScene::createEffect(const glm::vec2& center_pos, const std::string& tag)
+    void GameScene::initLevelPreload()
     {
-        //  创建游戏对象和变换组件 
-        auto effect_obj = std::make_unique<engine::object::GameObject>("effect_" + tag);
-        effect_obj->addComponent<engine::component::TransformComponent>(center_pos);
-
-        //  根据标签创建不同的精灵组件和动画 
-        auto animation = std::make_unique<engine::render::Animation>("effect", false);
-        if (tag == "enemy") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png",
-                context_.getResourceManager(),
-                engine::utils::Alignment::CENTER);
-            for (auto i = 0; i < 5; ++i) {
-                animation->addFrame({ static_cast<float>(i * 40), 0.0f, 40.0f, 41.0f }, 0.1f);
+        next_level_triggers_.clear();
+        for (const auto& game_object : game_objects_) {
+            if (game_object->getTag() != "next_level") {
+                continue;
             }
-        }
-        else if (tag == "item") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png",
-                context_.getResourceManager(),
-                engine::utils::Alignment::CENTER);
-            for (auto i = 0; i < 4; ++i) {
-                animation->addFrame({ static_cast<float>(i * 32), 0.0f, 32.0f, 32.0f }, 0.1f);
+            glm::vec2 center(0.0f);
+            if (auto* cc = game_object->getComponent<engine::component::ColliderComponent>(); cc) {
+                auto aabb = cc->getWorldAABB();
+                center = aabb.position + aabb.size / 2.0f;
+            }
+            else if (auto* transform = game_object->getComponent<engine::component::TransformComponent>(); transform) {
+                center = transform->getPosition();
             }
+            next_level_triggers_.push_back({ levelNameToPath(game_object->getName()), center });
         }
-        else {
-            spdlog::warn("未知特效类型: {}", tag);
+        if (next_level_triggers_.empty()) {
+            return;
+        }
+        // 所有出口通往同一关卡：关卡一开始就预加载
+        const auto& first_path = next_level_triggers_.front().map_path;
+        if (std::all_of(next_level_triggers_.begin(), next_level_triggers_.end(),
+            [&](const NextLevelTrigger& trigger) { return trigger.map_path == first_path; })) {
+            context_.getLevelPreloader().request(first_path);
+            next_level_triggers_.clear();
+        }
+    }
+
+    void GameScene::updateLevelPreload()
+    {
+        if (next_level_triggers_.empty() || !player_) {
+            return;
+        }
+        auto* transform = player_->getComponent<engine::component::TransformComponent>();
+        if (!transform) {
             return;
         }
+        // 预加载最近的、在范围内的出口（request 会忽略重复的请求）
+        const NextLevelTrigger* nearest = nullptr;
+        float nearest_distance = PRELOAD_DISTANCE;
+        for (const auto& trigger : next_level_triggers_) {
+            if (float distance = glm::distance(transform->getPosition(), trigger.center); distance < nearest_distance) {
+                nearest = &trigger;
+                nearest_distance = distance;
+            }
+        }
+        if (nearest) {
+            context_.getLevelPreloader().request(nearest->map_path);
+        }
+    }
 
-        // --- 根据创建的动画，添加动画组件，并设置为单次播放 ---
-        auto* animation_component = effect_obj->addComponent<engine::component::AnimationComponent>();
-        animation_component->addAnimation(std::move(animation));
-        animation_component->setOneShotRemoval(true);
-        animation_component->playAnimation("effect");
-        safeAddGameObject(std::move(effect_obj));  
-        spdlog::debug("创建特效: {}", tag);
+    bool GameScene::initEffects()
+    {
+        auto& particle_system = context_.getParticleSystem();
+        // 敌人死亡特效：5 帧，40x41；道具拾取特效：4 帧，32x32；每帧 0.1 秒
+        bool success = particle_system.registerEffect("enemy", "assets/textures/FX/enemy-deadth.png", { 40.0f, 41.0f }, 5, 0.1f).has_value();
+        success = particle_system.registerEffect("item", "assets/textures/FX/item-feedback.png", { 32.0f, 32.0f }, 4, 0.1f).has_value() && success;
+        return success;
+    }
+
+    void GameScene::createEffect(const glm::vec2& center_pos, const std::string& tag)
+    {
+        // 特效名称与标签一致，见 initEffects()
+        if (context_.getParticleSystem().emit(tag, center_pos)) {
+            spdlog::debug("创建特效: {}", tag);
+        }
     }
 
 } 
\ No newline at end of file
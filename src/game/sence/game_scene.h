@@ -1,12 +1,17 @@
 #pragma once
 #include "../../engine/scene/scene.h"
 #include <memory>
+#include <string>
+#include <vector>
 #include<glm/vec2.hpp>
 
 // 前置声明
 namespace engine::object {
     class GameObject;
 }
+namespace engine::core {
+    class LoadProfiler;
+}
 namespace game::data {
     class SessionData;
 }
@@ -18,6 +23,20 @@ namespace game::scene {
     class GameScene final : public engine::scene::Scene {
         std::shared_ptr<game::data::SessionData>game_session_data_; //场景间共享数据，因此用shared_ptr
         engine::object::GameObject* player_ = nullptr;
+        int hud_score_ = -1;        ///< @brief HUD 上显示的分数（变化时才更新静态文字）
+        int hud_health_ = -1;       ///< @brief HUD 上显示的生命值
+
+        /// @brief 通往下一关的触发器
+        struct NextLevelTrigger {
+            std::string map_path;   ///< @brief 目标地图
+            glm::vec2 center;       ///< @brief 触发器中心（世界坐标）
+        };
+        std::vector<NextLevelTrigger> next_level_triggers_;
+        static constexpr float PRELOAD_DISTANCE = 320.0f;   ///< @brief 玩家距离触发器多近时开始预加载（多个出口时）
+
+        static constexpr const char* HUD_FONT = "assets/fonts/VonwaonBitmap-16px.ttf";
+        static constexpr int HUD_FONT_SIZE = 16;
+        static constexpr const char* LOAD_REPORT_DIR = "load_reports";   ///< @brief 加载报告（<关卡名>.json）的输出目录
     public:
         GameScene(engine::core::Context& context,
             engine::scene::SceneManager& scene_manager,
@@ -30,10 +49,16 @@ namespace game::scene {
         void clean() override;
 
     private:
-        [[nodiscard]] bool initLevel();//关卡
+        [[nodiscard]] bool initLevel(engine::core::LoadProfiler& load_profile);//关卡（汇总 LevelLoader 的分阶段计时）
         [[nodiscard]] bool initPlayer();//玩家
         [[nodiscard]] bool  initEnemyAndItem();//敌人和道具
+        [[nodiscard]] bool initEffects();      ///< @brief 向粒子系统注册特效
+        void initLevelPreload();               ///< @brief 收集下一关触发器，只有一个目标时立即开始后台预加载
+        void updateLevelPreload();             ///< @brief 有多个目标时，预加载玩家接近的那一个
+        void reportLevelLoad(const engine::core::LoadProfiler& load_profile) const;  ///< @brief 把加载报告输出到日志，Debug 构建中另写 JSON 文件（load_reports/<关卡名>.json，见 ENGINE_WRITE_LOAD_REPORTS）
 
+        void updateHUD();           ///< @brief 分数/生命值变化时更新 HUD 静态文字
+        void renderHUD();           ///< @brief 绘制 HUD
         void handleObjectCollisions(); ///< @brief 处理游戏对象间的碰撞逻辑
         void handleTileTriggers();
         void handlePlayerDamage(int damage);
@@ -47,7 +72,7 @@ namespace game::scene {
         std::string levelNameToPath(const std::string& level_name) const { return "assets/maps/" + level_name + ".tmj"; }
         
      /**
-         * @brief 创建一个特效对象（一次性）。
+         * @brief 播放一个一次性特效（由粒子系统池化管理，不创建游戏对象）。
          * @param center_pos 特效中心位置
          * @param tag 特效标签（决定特效类型,例如"enemy","item"）
          */
@@ -1,9 +1,10 @@
 #include"engine/core/game_app.h"
 #include<spdlog/spdlog.h>
-int main(int, char[])
+int main(int argc, char* argv[])
 {
 	spdlog::set_level(spdlog::level::debug);
 	engine::core::GameApp app;
+	app.setCommandLine(argc, argv);
 	app.run();
 	return 0;
 }
\ No newline at end of file